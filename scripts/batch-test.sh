@@ -0,0 +1,102 @@
+#!/bin/bash
+
+# Tests verifying several inputs in one process (-batch), compiling them
+# both with clang and, if GenMC was built with the clang libraries,
+# in-process (-compile-in-process). Every input must give the results of
+# a separate run, and a failing input must not stop the ones after it.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+# Get binary's full path
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+GenMC="${GenMC:-${DIR}/../genmc}"
+GENMCFLAGS="${GENMCFLAGS:---disable-estimation --disable-mm-detector --rc11}"
+
+source "${DIR}/terminal.sh"
+
+TMPDIR=$(mktemp -d)
+trap 'rm -rf "${TMPDIR}"' EXIT
+
+# N threads incrementing a counter: N! executions (or an error, if N is not positive)
+write_test() {
+    cat > "${TMPDIR}/test$1.c" <<EOT
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define N $1
+
+atomic_int x;
+
+void *thread_n(void *unused)
+{
+	atomic_fetch_add_explicit(&x, 1, memory_order_relaxed);
+	return NULL;
+}
+
+int main()
+{
+	pthread_t t[N > 0 ? N : 1];
+
+	assert(N > 0);
+	for (int i = 0; i < N; i++)
+		pthread_create(&t[i], NULL, thread_n, NULL);
+	return 0;
+}
+EOT
+    echo "${TMPDIR}/test$1.c" >> "${TMPDIR}/batch"
+}
+write_test 2
+write_test 3
+write_test 0
+write_test 4
+
+# Runs the batch with FLAGS, and checks the executions explored for each input
+check() {
+    name="$1"; flags="$2"; expected="2 6 error 24"
+    printf "| %-30s | %-12s | " "${name}" "${expected}"
+
+    output=$("${GenMC}" ${GENMCFLAGS} ${flags} -batch -- "${TMPDIR}/batch" 2>&1)
+    ret_code="$?"
+    explored=$(echo "${output}" | awk '/Verification unsuccessful/ { err = 1 }
+    	     /Number of complete executions explored:/ { printf "%s%s", sep, (err ? "error" : $NF); sep = " "; err = 0 }')
+    if test "${ret_code}" -ne 42 -o "${explored}" != "${expected}"
+    then
+	printf "${RED}%-6s${NC} |\n" "ERROR"
+	echo "${output}"
+	failure=1
+	return
+    fi
+    printf "${GREEN}%-6s${NC} |\n" "OK"
+}
+
+printline
+echo '--- Verifying batches of inputs...'
+printline
+printf "| ${CYAN}%-30s${NC} | ${CYAN}%-12s${NC} | ${CYAN}%-6s${NC} |\n" \
+       "Compilation" "Executions" "Result"
+printline
+
+check "clang" ""
+if grep -q '^#define HAVE_LIBCLANG_CPP' "${DIR}/../config.h"
+then
+    check "in-process" "-compile-in-process"
+fi
+
+printline
+if test -n "${failure}"
+then
+    exit 1
+fi
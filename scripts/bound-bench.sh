@@ -0,0 +1,51 @@
+#!/bin/bash
+
+# Times context-bounded exploration of a parametric testcase as the number
+# of threads grows, e.g.:
+#
+#   bound-bench.sh -b 2 -n "2 3 4 5" tests/correct/synthetic/N-writers/variants/N_writers_a_reader0.c
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+# Get binary's full path
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+GenMC="${GenMC:-$DIR/../genmc}"
+
+bound=1
+threads="2 3 4 5"
+while getopts "b:n:" opt; do
+    case "${opt}" in
+	b) bound="${OPTARG}" ;;
+	n) threads="${OPTARG}" ;;
+	*) echo "Usage: $0 [-b bound] [-n \"N...\"] <file.c>"; exit 2 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+test_file="${1:-${DIR}/../tests/correct/synthetic/N-writers/variants/N_writers_a_reader0.c}"
+if [[ ! -f "${test_file}" ]]; then
+    echo "No such file: ${test_file}"
+    exit 2
+fi
+
+printf "%-6s %-12s %-12s %s\n" "N" "executions" "exceeded" "time"
+for n in ${threads}; do
+    output=`"${GenMC}" -disable-estimation --sc --bound "${bound}" --bound-type=context \
+	    -- -DN="${n}" "${test_file}" 2>&1`
+    explored=`echo "${output}" | awk '/explored/ { print $6 }'`
+    exceeded=`echo "${output}" | awk '/exceeded bound/ { gsub(/\(/, "", $7); print $7 }'`
+    time=`echo "${output}" | awk '/wall-clock/ { print $NF }'`
+    printf "%-6s %-12s %-12s %s\n" "${n}" "${explored}" "${exceeded:-0}" "${time}"
+done
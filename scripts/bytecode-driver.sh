@@ -0,0 +1,31 @@
+#!/bin/bash
+
+# Runs the test suite with local instructions executed as bytecode and
+# through the visitor (-disable-bytecode). Every run checks the expected
+# results of every testcase, so the two executors must agree.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+source "${DIR}/terminal.sh"
+
+status=0
+for flags in "" "-disable-bytecode"
+do
+    echo "--- ${flags:-bytecode}"
+    GENMCFLAGS="${GENMCFLAGS} ${flags}" "${DIR}/driver.sh" --fast
+    [[ $? -ne 0 ]] && status=1
+done
+exit "${status}"
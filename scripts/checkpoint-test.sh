@@ -0,0 +1,115 @@
+#!/bin/bash
+
+# Tests checkpointing. Each test is stopped after a fixed number of
+# executions, leaving a checkpoint, and is then resumed from that checkpoint
+# (compiling the test anew). The resumed exploration must report the same
+# number of executions as an uninterrupted one, and resuming under a
+# different model or with different options must be refused. Explorations
+# are interrupted and resumed both sequentially and with -nthreads (a
+# checkpoint does not depend on the number of threads).
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+# Get binary's full path
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+GenMC="${GenMC:-${DIR}/../genmc}"
+GENMCFLAGS="${GENMCFLAGS:---disable-estimation --disable-mm-detector}"
+STOP_AFTER="${STOP_AFTER:-100}"
+
+source "${DIR}/terminal.sh"
+
+# Test | arguments | executions explored (see the expected.rc11.mo.in files)
+TESTS=("synthetic/CoA/coa.c|-DN=5|57600"
+       "synthetic/lastzero/lastzero.c|-DN=15|147456")
+
+# Threads when interrupting | threads when resuming
+THREADS=("1|1" "2|2" "2|1" "1|2")
+
+CASES=()
+for t in "${TESTS[@]}"
+do
+    for th in "${THREADS[@]}"
+    do
+	CASES+=("${t}|${th}")
+    done
+done
+
+TMPDIR=$(mktemp -d)
+trap 'rm -rf "${TMPDIR}"' EXIT
+checkpoint="${TMPDIR}/checkpoint"
+
+printline
+echo '--- Interrupting and resuming explorations...'
+printline
+printf "| ${CYAN}%-30s${NC} | ${CYAN}%-7s${NC} | ${CYAN}%-10s${NC} | ${CYAN}%-8s${NC} | ${CYAN}%-6s${NC} |\n" \
+       "Testcase" "Threads" "Executions" "Resumed" "Result"
+printline
+
+for c in "${CASES[@]}"
+do
+    IFS='|' read -r file args expected stop_threads resume_threads <<< "${c}"
+    test_file="${DIR}/../tests/correct/${file}"
+    printf "| %-30s | %-7s | %-10s | " "${file##*/} ${args}" \
+	   "${stop_threads}->${resume_threads}" "${expected}"
+
+    rm -f "${checkpoint}"
+    "${GenMC}" ${GENMCFLAGS} -rc11 -nthreads="${stop_threads}" -checkpoint="${checkpoint}" \
+	       -checkpoint-stop-after="${STOP_AFTER}" -- ${args} "${test_file}" >/dev/null 2>&1
+    if test "$?" -ne 0 || ! test -f "${checkpoint}"
+    then
+	printf "%-8s | ${RED}%-6s${NC} |\n" "no" "ERROR"
+	echo "No checkpoint was taken after ${STOP_AFTER} executions"
+	failure=1
+	continue
+    fi
+
+    refused=1
+    for opts in "-sc" "-rc11 -disable-ipr"
+    do
+	output=$("${GenMC}" ${GENMCFLAGS} ${opts} -nthreads="${resume_threads}" \
+			 -resume="${checkpoint}" -- ${args} "${test_file}" 2>&1)
+	if test "$?" -eq 0 || ! [[ "${output}" =~ "different program or different options" ]]
+	then
+	    refused=""
+	    break
+	fi
+    done
+    if test -z "${refused}"
+    then
+	printf "%-8s | ${RED}%-6s${NC} |\n" "yes" "ERROR"
+	echo "Resuming with ${opts} was not refused"
+	failure=1
+	continue
+    fi
+
+    output=$("${GenMC}" ${GENMCFLAGS} -rc11 -nthreads="${resume_threads}" \
+		     -resume="${checkpoint}" -- ${args} "${test_file}" 2>&1)
+    ret_code="$?"
+    explored=$(echo "${output}" | sed -n 's/Number of complete executions explored: \([0-9][0-9]*\).*/\1/p')
+    if test "${ret_code}" -ne 0 -o "${explored}" != "${expected}"
+    then
+	printf "%-8s | ${RED}%-6s${NC} |\n" "yes" "ERROR"
+	echo "${output}"
+	failure=1
+	continue
+    fi
+    printf "%-8s | ${GREEN}%-6s${NC} |\n" "yes" "OK"
+done
+
+printline
+if test -n "${failure}"
+then
+    exit 1
+fi
@@ -0,0 +1,39 @@
+#!/bin/bash
+
+# Compares per-instruction dispatch, per-event dispatch through the
+# visitor, and per-event dispatch through bytecode in the interpreter
+# (see -disable-event-scheduling and -disable-bytecode) over the test
+# suite. All runs check the expected results of every testcase, so the
+# modes must agree.
+# Options are passed on to driver.sh, e.g.:
+#
+#   dispatch-bench.sh --fast
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+
+status=0
+for dispatch in instruction visitor bytecode; do
+    flags="${GENMCFLAGS:-}"
+    [[ "${dispatch}" == "instruction" ]] && flags="${flags} -disable-event-scheduling"
+    [[ "${dispatch}" == "visitor" ]] && flags="${flags} -disable-bytecode"
+
+    output=`GENMCFLAGS="${flags}" "${DIR}/driver.sh" "$@" 2>&1`
+    [[ $? -ne 0 ]] && status=1
+    total=`echo "${output}" | awk '/Total time:/ { print $NF }'`
+    printf "%-12s %s\n" "${dispatch}" "${total:-failed}"
+done
+exit "${status}"
@@ -0,0 +1,29 @@
+#!/bin/bash
+
+# Runs the test suite compiling the inputs in-process (-compile-in-process).
+# Skipped if GenMC was not built with the clang libraries.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+source "${DIR}/terminal.sh"
+
+if ! grep -q '^#define HAVE_LIBCLANG_CPP' "${DIR}/../config.h"
+then
+    echo "GenMC was built without --enable-in-process-compilation; skipping in-process compilation tests."
+    exit 77
+fi
+
+GENMCFLAGS="${GENMCFLAGS} -compile-in-process" "${DIR}/driver.sh" --fast --debug
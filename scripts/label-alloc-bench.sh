@@ -0,0 +1,64 @@
+#!/bin/bash
+
+# Reports how many label allocations reach the system allocator for
+# increasing numbers of worker threads (-nthreads >= 2). Without the slab
+# allocator, every label allocation is a separate malloc; with it, only
+# slabs and oversized labels are. The counts are taken from
+# -print-pool-stats and summed over all workers.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+# Get binary's full path
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+GenMC="${GenMC:-$DIR/../genmc}"
+
+size=5
+threads="2 4 8"
+while getopts "N:n:" opt; do
+    case "${opt}" in
+	N) size="${OPTARG}" ;;
+	n) threads="${OPTARG}" ;;
+	*) echo "Usage: $0 [-N size] [-n \"nthreads...\"] [<file.c>]"; exit 2 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+test_file="${1:-${DIR}/../tests/correct/synthetic/N-writers/variants/N_writers_a_reader0.c}"
+if [[ ! -f "${test_file}" ]]; then
+    echo "No such file: ${test_file}"
+    exit 2
+fi
+
+printf "%-9s %-12s %-14s %-14s %-10s %s\n" \
+       "nthreads" "executions" "before" "after" "recycled" "from pool"
+for n in ${threads}; do
+    output=`"${GenMC}" -disable-estimation -nthreads="${n}" -print-pool-stats \
+	    -- -DN="${size}" "${test_file}" 2>&1`
+    if [[ $? -ne 0 ]]; then
+	echo "${output}"
+	exit 1
+    fi
+    explored=`echo "${output}" | awk '/explored/ { print $6 }'`
+    # label allocs A (recycled R, from shared pool P, slabs S, large L)
+    echo "${output}" | awk -v n="${n}" -v explored="${explored}" '
+	/label allocs/ {
+	    gsub(/[(),]/, "");
+	    allocs += $3; recycled += $5; pool += $9; slabs += $11; large += $13;
+	}
+	END {
+	    printf "%-9s %-12s %-14d %-14d %-10d %d\n",
+		   n, explored, allocs + large, slabs + large, recycled, pool
+	}'
+done
@@ -0,0 +1,52 @@
+#!/bin/bash
+
+# Checks the implementations of tests/correct/relinche against their
+# specifications both with and without caching observations' hints
+# (-lin-spec-cache-size). Both runs must pass (i.e., report the expected
+# verdicts, error messages and numbers of checked hints), and must report
+# the same results for every testcase.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+source "${DIR}/terminal.sh"
+
+TMPDIR=$(mktemp -d)
+trap 'rm -rf "${TMPDIR}"' EXIT
+
+for size in 0 default
+do
+    flags="${CHE_FLAGS}"
+    [[ "${size}" != "default" ]] && flags="${flags} -lin-spec-cache-size=${size}"
+
+    echo "--- Hint cache size: ${size}"
+    CHE_FLAGS="${flags}" "${DIR}/run-relinche-impl.sh" --fast | tee "${TMPDIR}/${size}.out"
+    if test "${PIPESTATUS[0]}" -ne 0
+    then
+	failure=1
+    fi
+    grep '^| ' "${TMPDIR}/${size}.out" > "${TMPDIR}/${size}.rows"
+done
+
+if ! diff "${TMPDIR}/0.rows" "${TMPDIR}/default.rows"
+then
+    echo "${RED}Caching hints changes the results!${NC}"
+    failure=1
+fi
+
+if test -n "${failure}"
+then
+    exit 1
+fi
@@ -0,0 +1,100 @@
+#!/bin/bash
+
+# Tests the conversion of linearizability specifications between the text
+# and the binary format (-convert-lin-spec). Each specification under
+# tests/correct/relinche is converted to the binary format and back, which
+# must be a fixed point. A binary specification with the other byte order,
+# or with a corrupted record, must be rejected with an error.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+# Get binary's full path
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+GenMC="${GenMC:-${DIR}/../genmc}"
+
+source "${DIR}/terminal.sh"
+
+TMPDIR=$(mktemp -d)
+trap 'rm -rf "${TMPDIR}"' EXIT
+
+# Converts IN to OUT, and prints the number of observations
+convert() {
+    "${GenMC}" -convert-lin-spec="$2" "$1" 2>&1 |
+	sed -n 's/.*Number of observations: \([0-9][0-9]*\).*/\1/p'
+}
+
+printline
+echo '--- Converting specifications...'
+printline
+printf "| ${CYAN}%-30s${NC} | ${CYAN}%-12s${NC} | ${CYAN}%-6s${NC} |\n" \
+       "Specification" "Observations" "Result"
+printline
+
+for spec in "${DIR}"/../tests/correct/relinche/*/*_spec_*.in
+do
+    name="${spec##*/}"
+    printf "| %-30s | " "${name}"
+
+    # text -> binary -> text, and once more from the resulting text
+    n1=$(convert "${spec}" "${TMPDIR}/a.bin")
+    n2=$(convert "${TMPDIR}/a.bin" "${TMPDIR}/a.in")
+    n3=$(convert "${TMPDIR}/a.in" "${TMPDIR}/b.bin")
+    n4=$(convert "${TMPDIR}/b.bin" "${TMPDIR}/b.in")
+    if test -z "${n1}" || test "${n1}" != "${n2}" -o "${n1}" != "${n3}" -o "${n1}" != "${n4}" ||
+	    ! cmp -s "${TMPDIR}/a.bin" "${TMPDIR}/b.bin" ||
+	    ! cmp -s "${TMPDIR}/a.in" "${TMPDIR}/b.in"
+    then
+	printf "%-12s | ${RED}%-6s${NC} |\n" "${n1}" "ERROR"
+	failure=1
+	continue
+    fi
+    printf "%-12s | ${GREEN}%-6s${NC} |\n" "${n1}" "OK"
+done
+
+# A binary specification with the other byte order (i.e., a swapped magic)
+printf "| %-30s | %-12s | " "(foreign byte order)" ""
+magic=$(head -c 4 "${TMPDIR}/a.bin")
+(printf '%s' "${magic:3:1}${magic:2:1}${magic:1:1}${magic:0:1}"; tail -c +5 "${TMPDIR}/a.bin") \
+    > "${TMPDIR}/swapped.bin"
+output=$("${GenMC}" -convert-lin-spec="${TMPDIR}/c.in" "${TMPDIR}/swapped.bin" 2>&1)
+if test "$?" -ne 0 && [[ "${output}" =~ "different byte order" ]]
+then
+    printf "${GREEN}%-6s${NC} |\n" "OK"
+else
+    printf "${RED}%-6s${NC} |\n" "ERROR"
+    failure=1
+fi
+
+# A binary specification whose first record claims 2^60 calls
+printf "| %-30s | %-12s | " "(corrupted record)" ""
+buckets=$(od -An -t u8 -j 16 -N 8 "${TMPDIR}/a.bin" | tr -d ' ')
+record=$(od -An -t u8 -j $((24 + (buckets + 1) * 8)) -N 8 "${TMPDIR}/a.bin" | tr -d ' ')
+cp "${TMPDIR}/a.bin" "${TMPDIR}/corrupted.bin"
+printf '\x00\x00\x00\x00\x00\x00\x00\x10' |
+    dd of="${TMPDIR}/corrupted.bin" bs=1 seek="${record}" conv=notrunc 2>/dev/null
+output=$("${GenMC}" -convert-lin-spec="${TMPDIR}/c.in" "${TMPDIR}/corrupted.bin" 2>&1)
+if test "$?" -eq 17 && [[ "${output}" =~ "corrupted" ]]
+then
+    printf "${GREEN}%-6s${NC} |\n" "OK"
+else
+    printf "${RED}%-6s${NC} |\n" "ERROR"
+    failure=1
+fi
+
+printline
+if test -n "${failure}"
+then
+    exit 1
+fi
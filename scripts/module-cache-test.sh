@@ -0,0 +1,108 @@
+#!/bin/bash
+
+# Tests the module cache (-module-cache). A cached input must be reused
+# as long as neither the input, the headers it includes, nor GenMC itself
+# change, and must be recompiled (giving the new results) otherwise.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+# Get binary's full path
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+GenMC="${GenMC:-${DIR}/../genmc}"
+GENMCFLAGS="${GENMCFLAGS:---disable-estimation --disable-mm-detector --rc11}"
+
+source "${DIR}/terminal.sh"
+
+TMPDIR=$(mktemp -d)
+trap 'rm -rf "${TMPDIR}"' EXIT
+cache="${TMPDIR}/cache"
+
+# N threads incrementing a counter: N! executions
+cat > "${TMPDIR}/test.c" <<'EOT'
+#include <pthread.h>
+#include <stdatomic.h>
+#include "threads.h"
+
+atomic_int x;
+
+void *thread_n(void *unused)
+{
+	atomic_fetch_add_explicit(&x, 1, memory_order_relaxed);
+	return NULL;
+}
+
+int main()
+{
+	pthread_t t[N];
+
+	for (int i = 0; i < N; i++)
+		pthread_create(&t[i], NULL, thread_n, NULL);
+	for (int i = 0; i < N; i++)
+		pthread_join(t[i], NULL);
+	return 0;
+}
+EOT
+set_threads() {
+    echo "#define N $1" > "${TMPDIR}/threads.h"
+}
+
+# A different build of GenMC (same code, different executable)
+cp "${GenMC}" "${TMPDIR}/genmc"
+echo >> "${TMPDIR}/genmc"
+
+# Runs BINARY on the test, and checks whether the cache was REUSED and
+# that EXPECTED executions were explored
+check() {
+    name="$1"; binary="$2"; reused="$3"; expected="$4"
+    printf "| %-30s | %-6s | %-10s | " "${name}" "${reused}" "${expected}"
+
+    output=$("${binary}" ${GENMCFLAGS} -module-cache="${cache}" -- "${TMPDIR}/test.c" 2>&1)
+    ret_code="$?"
+    explored=$(echo "${output}" | sed -n 's/Number of complete executions explored: \([0-9][0-9]*\).*/\1/p')
+    hit="no"
+    if [[ "${output}" =~ "Reusing the compiled" ]]
+    then
+	hit="yes"
+    fi
+    if test "${ret_code}" -ne 0 -o "${explored}" != "${expected}" -o "${hit}" != "${reused}"
+    then
+	printf "${RED}%-6s${NC} |\n" "ERROR"
+	echo "${output}"
+	failure=1
+	return
+    fi
+    printf "${GREEN}%-6s${NC} |\n" "OK"
+}
+
+printline
+echo '--- Reusing cached inputs...'
+printline
+printf "| ${CYAN}%-30s${NC} | ${CYAN}%-6s${NC} | ${CYAN}%-10s${NC} | ${CYAN}%-6s${NC} |\n" \
+       "Run" "Reused" "Executions" "Result"
+printline
+
+set_threads 2
+check "first run" "${GenMC}" no 2
+check "unchanged input" "${GenMC}" yes 2
+set_threads 3
+check "changed header" "${GenMC}" no 6
+check "unchanged input" "${GenMC}" yes 6
+check "different GenMC build" "${TMPDIR}/genmc" no 6
+
+printline
+if test -n "${failure}"
+then
+    exit 1
+fi
@@ -0,0 +1,141 @@
+#!/bin/bash
+
+# Tests distributing the exploration across worker processes (-processes).
+# Each correct test must report the same number of executions as a
+# sequential exploration, and errors found by a worker must be reported.
+# Peers that connect to the coordinator (-listen) without ever becoming
+# workers must not disturb the exploration, and workers that connect
+# (-connect) with different exploration options must be rejected.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+# Get binary's full path
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+GenMC="${GenMC:-${DIR}/../genmc}"
+GENMCFLAGS="${GENMCFLAGS:---disable-estimation --disable-mm-detector --rc11}"
+PROCESSES="${PROCESSES:-2}"
+
+source "${DIR}/terminal.sh"
+
+# Test | arguments | executions explored (see the expected.rc11.mo.in files),
+# or "error" if the test is erroneous
+TESTS=("correct/synthetic/CoA/coa.c|-DN=5|57600"
+       "correct/synthetic/lastzero/lastzero.c|-DN=15|147456"
+       "wrong/safety/dekker_rlx/dekker_rlx.c||error")
+
+printline
+echo "--- Exploring with ${PROCESSES} worker processes..."
+printline
+printf "| ${CYAN}%-30s${NC} | ${CYAN}%-10s${NC} | ${CYAN}%-10s${NC} | ${CYAN}%-6s${NC} |\n" \
+       "Testcase" "Expected" "Explored" "Result"
+printline
+
+for t in "${TESTS[@]}"
+do
+    IFS='|' read -r file args expected <<< "${t}"
+    test_file="${DIR}/../tests/${file}"
+    printf "| %-30s | %-10s | " "${file##*/} ${args}" "${expected}"
+
+    output=$("${GenMC}" ${GENMCFLAGS} -processes="${PROCESSES}" -- ${args} "${test_file}" 2>&1)
+    ret_code="$?"
+    if test "${expected}" = "error"
+    then
+	if test "${ret_code}" -ne 0 && [[ "${output}" =~ "Verification unsuccessful" ]]
+	then
+	    printf "%-10s | ${GREEN}%-6s${NC} |\n" "error" "OK"
+	else
+	    printf "%-10s | ${RED}%-6s${NC} |\n" "none" "ERROR"
+	    echo "${output}"
+	    failure=1
+	fi
+	continue
+    fi
+
+    explored=$(echo "${output}" | sed -n 's/Number of complete executions explored: \([0-9][0-9]*\).*/\1/p')
+    if test "${ret_code}" -ne 0 -o "${explored}" != "${expected}"
+    then
+	printf "%-10s | ${RED}%-6s${NC} |\n" "${explored}" "ERROR"
+	echo "${output}"
+	failure=1
+	continue
+    fi
+    printf "%-10s | ${GREEN}%-6s${NC} |\n" "${explored}" "OK"
+done
+
+# Peers that hang up, and peers that send garbage
+IFS='|' read -r file args expected <<< "${TESTS[0]}"
+printf "| %-30s | %-10s | " "(stray peers)" "${expected}"
+port=$((20000 + RANDOM % 20000))
+output_file=$(mktemp)
+"${GenMC}" ${GENMCFLAGS} -processes="${PROCESSES}" -listen="127.0.0.1:${port}" -- ${args} \
+	   "${DIR}/../tests/${file}" > "${output_file}" 2>&1 &
+pid=$!
+for i in `seq 1 50`
+do
+    (exec 3<>"/dev/tcp/127.0.0.1/${port}") 2>/dev/null && break
+    sleep .1
+done
+(exec 3<>"/dev/tcp/127.0.0.1/${port}"; printf 'garbage' >&3) 2>/dev/null
+wait "${pid}"
+ret_code="$?"
+output=$(cat "${output_file}")
+rm -f "${output_file}"
+explored=$(echo "${output}" | sed -n 's/Number of complete executions explored: \([0-9][0-9]*\).*/\1/p')
+if test "${ret_code}" -ne 0 -o "${explored}" != "${expected}"
+then
+    printf "%-10s | ${RED}%-6s${NC} |\n" "${explored}" "ERROR"
+    echo "${output}"
+    failure=1
+else
+    printf "%-10s | ${GREEN}%-6s${NC} |\n" "${explored}" "OK"
+fi
+
+# A worker with different options, followed by a matching one. The coordinator
+# has no workers of its own, so it cannot finish before both have said hello
+printf "| %-30s | %-10s | " "(mismatched worker)" "${expected}"
+port=$((20000 + RANDOM % 20000))
+output_file=$(mktemp)
+"${GenMC}" ${GENMCFLAGS} -listen="127.0.0.1:${port}" -- ${args} \
+	   "${DIR}/../tests/${file}" > "${output_file}" 2>&1 &
+pid=$!
+for i in `seq 1 50`
+do
+    (exec 3<>"/dev/tcp/127.0.0.1/${port}") 2>/dev/null && break
+    sleep .1
+done
+timeout 60 "${GenMC}" ${GENMCFLAGS} -disable-ipr -connect="127.0.0.1:${port}" -- ${args} \
+	"${DIR}/../tests/${file}" >/dev/null 2>&1
+timeout 600 "${GenMC}" ${GENMCFLAGS} -connect="127.0.0.1:${port}" -- ${args} \
+	"${DIR}/../tests/${file}" >/dev/null 2>&1
+wait "${pid}"
+ret_code="$?"
+output=$(cat "${output_file}")
+rm -f "${output_file}"
+explored=$(echo "${output}" | sed -n 's/Number of complete executions explored: \([0-9][0-9]*\).*/\1/p')
+if test "${ret_code}" -ne 0 -o "${explored}" != "${expected}" ||
+	! [[ "${output}" =~ "Rejecting worker" ]]
+then
+    printf "%-10s | ${RED}%-6s${NC} |\n" "${explored}" "ERROR"
+    echo "${output}"
+    failure=1
+else
+    printf "%-10s | ${GREEN}%-6s${NC} |\n" "${explored}" "OK"
+fi
+
+printline
+if test -n "${failure}"
+then
+    exit 1
+fi
@@ -0,0 +1,71 @@
+#!/bin/bash
+
+# Runs the test suite pruning duplicate revisits (-prune-duplicates).
+# The default exploration is optimal, so no graph should be found twice:
+# the expected results (including the errors of the wrong/ tests) must be
+# reported unchanged. Arbitrary scheduling may expand optional blocks in
+# different orders and thus revisit the same prefix twice; there, some
+# revisits must actually be pruned, without losing any execution.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+GenMC="${GenMC:-${DIR}/../genmc}"
+source "${DIR}/terminal.sh"
+
+GENMCFLAGS="${GENMCFLAGS} -prune-duplicates" "${DIR}/driver.sh" --fast --debug || failure=1
+
+# Four writers followed by optional blocks: 4! complete executions
+test_file="${DIR}/../tests/correct/duplicates/opt-writers/opt-writers.c"
+expected=24
+SEEDS="${SEEDS:-1 2 3 4 5}"
+
+printline
+echo '--- Pruning duplicates under arbitrary scheduling...'
+printline
+printf "| ${CYAN}%-30s${NC} | ${CYAN}%-10s${NC} | ${CYAN}%-8s${NC} | ${CYAN}%-6s${NC} |\n" \
+       "Testcase" "Executions" "Pruned" "Result"
+printline
+
+total=0
+for seed in ${SEEDS}
+do
+    printf "| %-30s | %-10s | " "opt-writers.c (seed ${seed})" "${expected}"
+    output=$("${GenMC}" --disable-estimation -rc11 -prune-duplicates -schedule-policy=arbitrary \
+			-schedule-seed="${seed}" -- "${test_file}" 2>&1)
+    ret_code="$?"
+    explored=$(echo "${output}" | sed -n 's/Number of complete executions explored: \([0-9][0-9]*\).*/\1/p')
+    pruned=$(echo "${output}" | sed -n 's/Number of revisits pruned as duplicates: \([0-9][0-9]*\).*/\1/p')
+    if test "${ret_code}" -ne 0 -o "${explored}" != "${expected}" -o -z "${pruned}"
+    then
+	printf "%-8s | ${RED}%-6s${NC} |\n" "${pruned:-?}" "ERROR"
+	echo "${output}"
+	failure=1
+	continue
+    fi
+    total=$((total + pruned))
+    printf "%-8s | ${GREEN}%-6s${NC} |\n" "${pruned}" "OK"
+done
+
+printline
+if test "${total}" -eq 0
+then
+    echo "No revisit was pruned as a duplicate"
+    failure=1
+fi
+if test -n "${failure}"
+then
+    exit 1
+fi
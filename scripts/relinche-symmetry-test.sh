@@ -0,0 +1,135 @@
+#!/bin/bash
+
+# Checks symmetry reduction during specification analysis against the
+# exploration of all symmetric executions. For each specification, the
+# specification collected under symmetry reduction (canonical forms expanded
+# with -expand-lin-spec) must coincide with the one collected with
+# -disable-sr, and the compact specification (the default) must give the
+# same verdicts as the full one when checking the implementations. If GenMC
+# is built with debugging support, -relinche-debug additionally checks that
+# all the observations symmetric to a collected one have the same canonical
+# form.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+# Get binary's full path
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+GenMC="${GenMC:-${DIR}/../genmc}"
+GENMCFLAGS="${GENMCFLAGS:---disable-estimation --disable-mm-detector}"
+SPEC_ARGS=("-DSYNC_VAL" "-DSYNC_INS" "-DSYNC_REM" "-DSYNC_INS -DSYNC_REM")
+
+source "${DIR}/terminal.sh"
+
+SPECDIR=$(mktemp -d)
+trap 'rm -rf "${SPECDIR}"' EXIT
+
+SRFLAGS=""
+if "${GenMC}" -help-hidden 2>/dev/null | grep -q -- '-relinche-debug'
+then
+    SRFLAGS="-relinche-debug"
+fi
+
+# Collects the specifications of DS for SARG into SPECDIR, with FLAGS
+collect() {
+    ds="$1"; sarg="$2"; suffix="$3"; shift 3
+    path="${DIR}/../tests/correct/relinche/${ds}"
+    for i in `seq 1 4`
+    do
+	for j in `seq 1 4`
+	do
+	    file="${SPECDIR}/${ds}_spec_${SPEC_TYPE}_${suffix}_${i}${j}.in"
+	    "${GenMC}" ${GENMCFLAGS} "$@" -collect-lin-spec="${file}" -- -DWTN="${i}" -DRTN="${j}" \
+		       ${sarg} -include "${path}/spec.c" "${path}/mpc.c" >/dev/null 2>&1 || return 1
+	done
+    done
+    cat "${SPECDIR}/${ds}_spec_${SPEC_TYPE}_${suffix}"_??.in > "${SPECDIR}/${ds}_spec_${SPEC_TYPE}_${suffix}.in"
+}
+
+spec_type() {
+    SPEC_TYPE="v"
+    if [[ "$1" =~ "DSYNC_INS" ]]; then SPEC_TYPE="${SPEC_TYPE}i"; fi
+    if [[ "$1" =~ "DSYNC_REM" ]]; then SPEC_TYPE="${SPEC_TYPE}r"; fi
+}
+
+# Prints the verdict of checking the implementation of DS with ARGS against SPEC
+verdict() {
+    ds="$1"; args="$2"; spec="$3"
+    output=$("${GenMC}" ${GENMCFLAGS} --rc11 --check-lin-spec="${spec}" -- ${args} \
+			"${DIR}/../tests/correct/relinche/${ds}/mpc.c" 2>&1)
+    echo "$?" $(echo "${output}" | grep -o 'The library implementation[^.]*')
+}
+
+printline
+echo '--- Comparing symmetry reduction against full exploration...'
+printline
+printf "| ${CYAN}%-15s${NC} | ${CYAN}%-5s${NC} | ${CYAN}%-10s${NC} | ${CYAN}%-10s${NC} |\n" \
+       "Data-structure" "Spec" "Canonical" "Compact"
+printline
+
+for ds in queue stack
+do
+    for sarg in "${SPEC_ARGS[@]}"
+    do
+	spec_type "${sarg}"
+	printf "| %-15s | %-5s | " "${ds}" "${SPEC_TYPE}"
+
+	prefix="${SPECDIR}/${ds}_spec_${SPEC_TYPE}"
+	if ! collect "${ds}" "${sarg}" full -disable-sr ||
+	   ! collect "${ds}" "${sarg}" sr -expand-lin-spec ${SRFLAGS} ||
+	   ! collect "${ds}" "${sarg}" compact
+	then
+	    printf "${RED}%-10s${NC} | %-10s |\n" "ERROR" ""
+	    failure=1
+	    continue
+	fi
+
+	if diff "${prefix}_full.in" "${prefix}_sr.in" >/dev/null
+	then
+	    printf "${GREEN}%-10s${NC} | " "OK"
+	else
+	    printf "${RED}%-10s${NC} | " "DIFFERS"
+	    failure=1
+	fi
+
+	compact_failure=""
+	for test_in in "${DIR}/../tests/correct/relinche/${ds}"/args.*.in
+	do
+	    [[ "${test_in}" =~ "NxN" ]] && continue
+	    while read args_in || [[ $args_in ]]
+	    do
+		spec_type "${args_in}"
+		[[ "${prefix}" = "${SPECDIR}/${ds}_spec_${SPEC_TYPE}" ]] || continue
+		if [[ "$(verdict "${ds}" "${args_in}" "${prefix}_full.in")" != \
+		      "$(verdict "${ds}" "${args_in}" "${prefix}_compact.in")" ]]
+		then
+		    compact_failure=1
+		fi
+	    done < "${test_in}"
+	done
+	if test -n "${compact_failure}"
+	then
+	    printf "${RED}%-10s${NC} |\n" "DIFFERS"
+	    failure=1
+	else
+	    printf "${GREEN}%-10s${NC} |\n" "OK"
+	fi
+    done
+done
+
+printline
+if test -n "${failure}"
+then
+    exit 1
+fi
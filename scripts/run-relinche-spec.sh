@@ -72,7 +72,7 @@ do
 		for j in `seq 1 4`
 	        do
 		    file="${path}/${ds}_spec_${SPEC_TYPE}_${i}${j}.in"
-		    output=$("${GenMC}" ${GENMCFLAGS} -collect-lin-spec="${file}" -- -DWTN="${i}" -DRTN="${j}" "${sarg}" -include "${path}/spec.c" "${path}/mpc.c" 2>&1)
+		    output=$("${GenMC}" ${GENMCFLAGS} -expand-lin-spec -collect-lin-spec="${file}" -- -DWTN="${i}" -DRTN="${j}" "${sarg}" -include "${path}/spec.c" "${path}/mpc.c" 2>&1)
 
 		    # increase time
 		    time=$(echo "${output}" | sed -n 's/.*Total wall-clock time: \([0-9\.][0-9\.]*\).*/\1/p')
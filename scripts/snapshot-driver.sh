@@ -0,0 +1,33 @@
+#!/bin/bash
+
+# Runs the test suite without and with thread snapshots (-snapshot-cache-size),
+# also with instruction caching disabled, where threads are resumed from
+# snapshots the most. Every run checks the expected results of every testcase,
+# so resuming threads from snapshots must not change them.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+source "${DIR}/terminal.sh"
+
+status=0
+for flags in "-snapshot-cache-size=0" "-snapshot-cache-size=1024" \
+	     "-snapshot-cache-size=1024 -disable-instruction-caching"
+do
+    echo "--- ${flags}"
+    GENMCFLAGS="${GENMCFLAGS} ${flags}" "${DIR}/driver.sh" --fast
+    [[ $? -ne 0 ]] && status=1
+done
+exit "${status}"
@@ -0,0 +1,65 @@
+#!/bin/bash
+
+# Records the view updates GenMC performs on a testcase under a few
+# memory models (-record-view-updates) and replays each trace with
+# view-bench. That compares View::update() against hand-written SSE2,
+# SSE4.1 and AVX2 kernels for the element-wise max. Recording needs a
+# GenMC built with -DENABLE_GENMC_DEBUG; build view-bench first with
+# "make view-bench".
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, you can access it online at
+# http://www.gnu.org/licenses/gpl-2.0.html.
+
+# Get binaries' full paths
+DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" >/dev/null 2>&1 && pwd )"
+GenMC="${GenMC:-$DIR/../genmc}"
+ViewBench="${ViewBench:-$DIR/../view-bench}"
+
+size=4
+models="rc11 imm"
+while getopts "N:m:" opt; do
+    case "${opt}" in
+	N) size="${OPTARG}" ;;
+	m) models="${OPTARG}" ;;
+	*) echo "Usage: $0 [-N size] [-m \"model...\"] [<file.c>]"; exit 2 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+test_file="${1:-${DIR}/../tests/correct/synthetic/N-writers/variants/N_writers_a_reader0.c}"
+if [[ ! -f "${test_file}" ]]; then
+    echo "No such file: ${test_file}"
+    exit 2
+fi
+if [[ ! -x "${ViewBench}" ]]; then
+    echo "No view-bench binary at ${ViewBench} (run make view-bench)"
+    exit 2
+fi
+
+trace=`mktemp`
+trap 'rm -f "${trace}"' EXIT
+
+status=0
+for model in ${models}; do
+    echo "--- ${model}"
+    output=`"${GenMC}" -disable-estimation -"${model}" -record-view-updates="${trace}" \
+	    -- -DN="${size}" "${test_file}" 2>&1`
+    if [[ $? -ne 0 ]]; then
+	echo "${output}"
+	status=1
+	continue
+    fi
+    "${ViewBench}" "${trace}" || status=1
+done
+exit "${status}"
@@ -19,6 +19,7 @@
  */
 
 #include "ADT/DepView.hpp"
+#include "Support/BinaryIO.hpp"
 #include "Support/Error.hpp"
 
 auto DepView::contains(const Event e) const -> bool
@@ -92,3 +93,18 @@ void DepView::printData(llvm::raw_ostream &s) const
 
 	s << "]";
 }
+
+void serialize(BinaryWriter &w, const DepView &v)
+{
+	serialize(w, v.view_);
+	for (auto i = 0U; i < v.size(); i++)
+		w.writeRange(v.holes_[i]);
+}
+
+void deserialize(BinaryReader &r, DepView &v)
+{
+	v.clear();
+	deserialize(r, v.view_);
+	for (auto i = 0U; i < v.size(); i++)
+		v.holes_[i] = r.readVector<int>();
+}
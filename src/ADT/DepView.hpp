@@ -106,6 +106,15 @@ public:
 			removeHolesInRange(e, old + 1);
 	}
 
+	/** Sets E as the maximum of its thread, with no holes before it */
+	void setMaxNoHoles(Event e)
+	{
+		if (e.thread >= (int)view_.size())
+			holes_[e.thread]; // grow
+		view_.setMax(e);
+		removeAllHoles(e.thread);
+	}
+
 	/** Returns true if there's a hole in E's position */
 	[[nodiscard]] auto hasHole(const Event e) const -> bool
 	{
@@ -136,6 +145,9 @@ public:
 
 	void printData(llvm::raw_ostream &s) const override;
 
+	friend void serialize(BinaryWriter &w, const DepView &v);
+	friend void deserialize(BinaryReader &r, DepView &v);
+
 	static auto classof(const VectorClock *vc) -> bool { return vc->getKind() == VC_DepView; }
 
 private:
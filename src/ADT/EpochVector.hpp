@@ -0,0 +1,81 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#ifndef GENMC_EPOCH_VECTOR_HPP
+#define GENMC_EPOCH_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A vector whose clear() takes constant time: each element is tagged with
+ * the epoch it was last written in, and elements from older epochs read as
+ * value-initialized. Used for the per-thread data dependencies of
+ * DepTracker, which are cleared whenever a thread is reset but only have
+ * a few entries filled at any time.
+ */
+template <typename T> class EpochVector {
+
+	struct Entry {
+		uint32_t epoch;
+		T value;
+	};
+
+public:
+	EpochVector() = default;
+
+	/** Logically resets all elements to T() */
+	void clear()
+	{
+		size_ = 0;
+		if (++epoch_ == 0) {
+			/* Wrapped around: invalidate everything for real */
+			std::fill(entries_.begin(), entries_.end(), Entry{0, T()});
+			epoch_ = 1;
+		}
+	}
+
+	/** Resizes to N elements; new elements read as T() */
+	void resize(size_t n)
+	{
+		if (n > entries_.size())
+			entries_.resize(n, Entry{0, T()});
+		size_ = n;
+	}
+
+	auto size() const -> size_t { return size_; }
+
+	auto operator[](size_t i) -> T &
+	{
+		auto &e = entries_[i];
+		if (e.epoch != epoch_) {
+			e.epoch = epoch_;
+			e.value = T();
+		}
+		return e.value;
+	}
+
+private:
+	std::vector<Entry> entries_;
+	size_t size_ = 0;
+	uint32_t epoch_ = 1;
+};
+
+#endif /* GENMC_EPOCH_VECTOR_HPP */
@@ -0,0 +1,89 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#ifndef GENMC_LRU_CACHE_HPP
+#define GENMC_LRU_CACHE_HPP
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * A map holding at most a fixed number of entries. When full, inserting
+ * a new entry evicts the least-recently used one (both lookups and
+ * insertions count as uses).
+ */
+template <typename K, typename V, typename Hash = std::hash<K>> class LRUCache {
+
+	using ListT = std::list<std::pair<K, V>>;
+
+public:
+	/*** Constructors ***/
+
+	explicit LRUCache(std::size_t capacity) : capacity(capacity) {}
+
+	/*** Operations ***/
+
+	/** Returns the entry for KEY (or nullptr), marking it as recently used */
+	auto lookup(const K &key) -> V *
+	{
+		auto it = index.find(key);
+		if (it == index.end())
+			return nullptr;
+		entries.splice(entries.begin(), entries, it->second);
+		return &it->second->second;
+	}
+
+	/** Inserts (or replaces) the entry for KEY */
+	void insert(const K &key, V value)
+	{
+		if (capacity == 0)
+			return;
+
+		if (auto *v = lookup(key)) {
+			*v = std::move(value);
+			return;
+		}
+		if (entries.size() == capacity) {
+			index.erase(entries.back().first);
+			entries.pop_back();
+		}
+		entries.emplace_front(key, std::move(value));
+		index[key] = entries.begin();
+	}
+
+	void clear()
+	{
+		index.clear();
+		entries.clear();
+	}
+
+	auto size() const -> std::size_t { return entries.size(); }
+	auto getCapacity() const -> std::size_t { return capacity; }
+
+private:
+	std::size_t capacity;
+
+	/** Entries, from the most to the least recently used */
+	ListT entries;
+
+	std::unordered_map<K, typename ListT::iterator, Hash> index;
+};
+
+#endif /* GENMC_LRU_CACHE_HPP */
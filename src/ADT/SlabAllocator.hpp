@@ -0,0 +1,301 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#ifndef GENMC_SLAB_ALLOCATOR_HPP
+#define GENMC_SLAB_ALLOCATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * A thread-local, size-class based slab allocator for small objects that are
+ * allocated and freed in bulk (e.g., event labels). Objects are carved out of
+ * large slabs with a bump pointer, and freed objects are kept in per-class
+ * free lists for reuse, so that the hot path never reaches malloc/free.
+ *
+ * Objects may be freed by a different thread than the one that allocated them
+ * (e.g., when a task is stolen); the object is then recycled by the freeing
+ * thread. To keep such objects from piling up in one thread (or getting lost
+ * when the thread exits), free lists that grow too long spill batches of
+ * objects into a pool shared by all threads, and exiting threads hand all
+ * their free objects to the pool. Threads refill their free lists from the
+ * pool before allocating new slabs, so the memory held is bounded by the peak
+ * number of live objects rather than by the threads' history.
+ *
+ * Objects may also be freed during thread or program teardown (e.g., by the
+ * destructors of other thread-local or static objects). The allocator of a
+ * thread is thus trivially destructible and remains usable after its free
+ * objects have been handed to the pool, and the pool itself is never
+ * destroyed. As a consequence, slabs are never returned to the OS: memory is
+ * only reclaimed when the process exits.
+ */
+class SlabAllocator {
+
+public:
+	/** Allocation statistics (per thread) */
+	struct Stats {
+		uint64_t allocs{};   /**< Number of small-object allocations */
+		uint64_t reused{};   /**< Allocations served from a free list */
+		uint64_t slabs{};    /**< Number of slabs allocated */
+		uint64_t large{};    /**< Allocations forwarded to operator new */
+		uint64_t shared{};   /**< Objects taken from the shared pool */
+	};
+
+	SlabAllocator(const SlabAllocator &) = delete;
+	auto operator=(const SlabAllocator &) -> SlabAllocator & = delete;
+
+	/** Returns the allocator of the calling thread */
+	static auto local() -> SlabAllocator &
+	{
+		static thread_local SlabAllocator alloc;
+		static thread_local ThreadExitGuard guard(alloc);
+		return alloc;
+	}
+
+	/** Allocates SIZE bytes */
+	auto allocate(std::size_t size) -> void *
+	{
+		if (size > maxObjSize) {
+			++stats.large;
+			return ::operator new(size);
+		}
+
+		++stats.allocs;
+		auto c = getSizeClass(size);
+		auto &list = freeLists[c];
+		if (list.empty() && getPool().take(c, list))
+			stats.shared += list.count;
+		if (!list.empty()) {
+			++stats.reused;
+			return list.pop();
+		}
+		return carve(getClassSize(c));
+	}
+
+	/** Frees P, which was allocated with SIZE bytes */
+	void deallocate(void *p, std::size_t size)
+	{
+		if (size > maxObjSize) {
+			::operator delete(p);
+			return;
+		}
+
+		auto c = getSizeClass(size);
+		auto *node = static_cast<FreeNode *>(p);
+		if (exited) {
+			/* The free lists will not be handed to the pool again */
+			FreeList single;
+			single.push(node);
+			getPool().give(c, std::move(single));
+			return;
+		}
+
+		auto &list = freeLists[c];
+		list.push(node);
+		if (list.count >= 2 * batchSize)
+			getPool().give(c, list.split(batchSize));
+	}
+
+	auto getStats() const -> const Stats & { return stats; }
+
+private:
+	static constexpr std::size_t granularity = alignof(std::max_align_t);
+	static constexpr std::size_t maxObjSize = 512;
+	static constexpr std::size_t numClasses = maxObjSize / granularity;
+	static constexpr std::size_t slabSize = 64 * 1024;
+
+	/** Number of objects exchanged with the shared pool at a time */
+	static constexpr std::size_t batchSize = 256;
+
+	struct FreeNode {
+		FreeNode *next;
+	};
+
+	/** A singly-linked list of free objects of the same class */
+	struct FreeList {
+		FreeList() = default;
+		FreeList(FreeList &&other) noexcept
+			: head(std::exchange(other.head, nullptr)),
+			  count(std::exchange(other.count, 0))
+		{}
+		auto operator=(FreeList &&other) noexcept -> FreeList &
+		{
+			head = std::exchange(other.head, nullptr);
+			count = std::exchange(other.count, 0);
+			return *this;
+		}
+
+		auto empty() const -> bool { return head == nullptr; }
+
+		void push(FreeNode *node)
+		{
+			node->next = head;
+			head = node;
+			++count;
+		}
+
+		auto pop() -> FreeNode *
+		{
+			auto *node = head;
+			head = node->next;
+			--count;
+			return node;
+		}
+
+		/** Detaches (and returns) the first N objects of the list */
+		auto split(std::size_t n) -> FreeList
+		{
+			FreeList front;
+			front.head = head;
+			front.count = n;
+			auto *last = head;
+			for (auto i = 1U; i < n; i++)
+				last = last->next;
+			head = last->next;
+			count -= n;
+			last->next = nullptr;
+			return front;
+		}
+
+		FreeNode *head = nullptr;
+		std::size_t count = 0;
+	};
+
+	/** Slabs and free objects shared by all threads */
+	struct SharedPool {
+		/** Moves a list of free objects of class C into LIST (if any) */
+		auto take(std::size_t c, FreeList &list) -> bool
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (lists[c].empty())
+				return false;
+			list = std::move(lists[c].back());
+			lists[c].pop_back();
+			return true;
+		}
+
+		/** Adds LIST (of class C) to the pool */
+		void give(std::size_t c, FreeList list)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			lists[c].push_back(std::move(list));
+		}
+
+		void addSlab(std::unique_ptr<char[]> slab)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			slabs.push_back(std::move(slab));
+		}
+
+	private:
+		std::mutex mutex;
+		std::vector<std::unique_ptr<char[]>> slabs;
+		std::array<std::vector<FreeList>, numClasses> lists;
+	};
+
+	/** Hands the free objects of a thread's allocator to the shared pool on
+	 * thread exit. (Objects freed afterwards go to the pool directly.) */
+	struct ThreadExitGuard {
+		explicit ThreadExitGuard(SlabAllocator &alloc) : alloc(alloc) {}
+		~ThreadExitGuard()
+		{
+			for (auto c = 0U; c < numClasses; c++) {
+				if (!alloc.freeLists[c].empty())
+					getPool().give(c, std::move(alloc.freeLists[c]));
+			}
+			alloc.exited = true;
+		}
+
+		SlabAllocator &alloc;
+	};
+
+	SlabAllocator() = default;
+
+	static auto getSizeClass(std::size_t size) -> std::size_t
+	{
+		return size ? (size - 1) / granularity : 0;
+	}
+	static auto getClassSize(std::size_t c) -> std::size_t { return (c + 1) * granularity; }
+
+	/* Never destroyed, as objects can be freed during static destruction */
+	static auto getPool() -> SharedPool &
+	{
+		static auto *pool = new SharedPool;
+		return *pool;
+	}
+
+	/** Carves SIZE bytes from the current slab, allocating a new one if necessary */
+	auto carve(std::size_t size) -> void *
+	{
+		if (static_cast<std::size_t>(end - cur) < size) {
+			auto slab = std::unique_ptr<char[]>(new char[slabSize]);
+			cur = slab.get();
+			end = cur + slabSize;
+			++stats.slabs;
+			getPool().addSlab(std::move(slab));
+		}
+		auto *p = cur;
+		cur += size;
+		return p;
+	}
+
+	std::array<FreeList, numClasses> freeLists{};
+	char *cur = nullptr;
+	char *end = nullptr;
+	Stats stats;
+	bool exited = false;
+};
+
+static_assert(std::is_trivially_destructible_v<SlabAllocator>,
+	      "the allocator has to outlive the thread's other thread-local objects");
+
+/**
+ * An STL allocator that serves allocations from the calling thread's
+ * SlabAllocator, so that small containers owned by slab-allocated objects
+ * (e.g., the views saved in a label) are pooled along with their owner.
+ */
+template <typename T> struct SlabStlAllocator {
+	using value_type = T;
+
+	SlabStlAllocator() = default;
+	template <typename U> SlabStlAllocator(const SlabStlAllocator<U> &) {}
+
+	auto allocate(std::size_t n) -> T *
+	{
+		return static_cast<T *>(SlabAllocator::local().allocate(n * sizeof(T)));
+	}
+	void deallocate(T *p, std::size_t n) { SlabAllocator::local().deallocate(p, n * sizeof(T)); }
+
+	template <typename U> auto operator==(const SlabStlAllocator<U> &) const -> bool
+	{
+		return true;
+	}
+	template <typename U> auto operator!=(const SlabStlAllocator<U> &) const -> bool
+	{
+		return false;
+	}
+};
+
+#endif /* GENMC_SLAB_ALLOCATOR_HPP */
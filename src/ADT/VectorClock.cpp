@@ -22,6 +22,7 @@
 #include "ADT/DepView.hpp"
 #include "ADT/View.hpp"
 #include "ExecutionGraph/EventLabel.hpp"
+#include "Support/BinaryIO.hpp"
 
 auto VectorClock::contains(const EventLabel *lab) const -> bool { return contains(lab->getPos()); }
 
@@ -45,3 +46,36 @@ auto operator<<(llvm::raw_ostream &s, const VectorClock &vc) -> llvm::raw_ostrea
 auto VectorClock::empty() const -> bool { return size() == 0; }
 
 auto VectorClock::getMax(Event e) const -> int { return getMax(e.thread); }
+
+void serialize(BinaryWriter &w, const VectorClock &vc)
+{
+	w.write(vc.getKind());
+	switch (vc.getKind()) {
+	case VectorClock::VC_View:
+		serialize(w, *static_cast<const View *>(&vc));
+		return;
+	case VectorClock::VC_DepView:
+		serialize(w, *static_cast<const DepView *>(&vc));
+		return;
+	}
+	BUG();
+}
+
+void deserialize(BinaryReader &r, std::unique_ptr<VectorClock> &vc)
+{
+	switch (r.read<VectorClock::VectorClockKind>()) {
+	case VectorClock::VC_View: {
+		auto v = std::make_unique<View>();
+		deserialize(r, *v);
+		vc = std::move(v);
+		return;
+	}
+	case VectorClock::VC_DepView: {
+		auto v = std::make_unique<DepView>();
+		deserialize(r, *v);
+		vc = std::move(v);
+		return;
+	}
+	}
+	ERROR("Unknown vector clock kind in binary input!\n");
+}
@@ -31,6 +31,8 @@
 class View;
 class DepView;
 class EventLabel;
+class BinaryWriter;
+class BinaryReader;
 
 /**
  * An abstract class for modeling vector clocks. Contains the bare
@@ -99,6 +101,10 @@ private:
 	VectorClockKind kind;
 };
 
+/** Binary (de)serialization; the kind of the clock is preserved */
+void serialize(BinaryWriter &w, const VectorClock &vc);
+void deserialize(BinaryReader &r, std::unique_ptr<VectorClock> &vc);
+
 /** Helper cloner class */
 struct VectorClockCloner {
 	auto operator()(const VectorClock &x) const -> VectorClock * { return x.clone().release(); }
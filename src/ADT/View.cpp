@@ -19,23 +19,40 @@
  */
 
 #include "ADT/View.hpp"
+#include "Support/BinaryIO.hpp"
 #include "Support/Error.hpp"
 
-auto View::size() const -> unsigned int { return view_.size(); }
+#include <algorithm>
 
-auto View::empty() const -> bool { return size() == 0; }
+#ifdef ENABLE_GENMC_DEBUG
+/* Where view updates are recorded, if anywhere */
+static llvm::raw_ostream *updateTrace = nullptr;
 
-auto View::contains(const Event e) const -> bool { return e.index <= getMax(e.thread); }
+void View::recordUpdates(llvm::raw_ostream *os) { updateTrace = os; }
+#endif
 
 auto View::update(const View &v) -> View &
 {
-	if (v.empty())
-		return *this;
+#ifdef ENABLE_GENMC_DEBUG
+	if (updateTrace) [[unlikely]] {
+		BinaryWriter w(*updateTrace);
+		serialize(w, *this);
+		serialize(w, v);
+	}
+#endif
 
-	auto size = std::max(this->size(), v.size());
-	for (auto i = 0U; i < size; i++)
-		if (getMax(i) < v.getMax(i))
-			setMax(Event(i, v.getMax(i)));
+	/* Only grow up to the last entry that would actually change */
+	const auto *b = v.view_.data();
+	auto n = v.size();
+	while (n > size() && b[n - 1] <= 0)
+		--n;
+	if (n > size())
+		view_.resize(n, 0);
+
+	/* Element-wise max over contiguous storage */
+	auto *a = view_.data();
+	for (auto i = 0U; i < n; i++)
+		a[i] = std::max(a[i], b[i]);
 	return *this;
 }
 
@@ -55,3 +72,13 @@ void View::printData(llvm::raw_ostream &s) const
 		s << i << ":" << getMax(i) << " ";
 	s << "]";
 }
+
+void serialize(BinaryWriter &w, const View &v) { w.writeRange(v); }
+
+void deserialize(BinaryReader &r, View &v)
+{
+	v.clear();
+	auto entries = r.readVector<int>();
+	for (auto i = 0U; i < entries.size(); i++)
+		v.setMax(Event(i, entries[i]));
+}
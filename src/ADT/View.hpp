@@ -23,45 +23,52 @@
 
 #include "ADT/VectorClock.hpp"
 #include "ExecutionGraph/Event.hpp"
-#include <llvm/ADT/IndexedMap.h>
+#include <llvm/ADT/SmallVector.h>
 #include <llvm/Support/raw_ostream.h>
 
 /**
  * An instantiation of a vector clock where it is assumed that if an index
  * is contained in the clock, all of its po-predecessors are also contained
  * in the clock.
+ *
+ * Entries are stored contiguously and inline for small thread counts (so that
+ * updates compile to element-wise max loops), and the class is final so that
+ * calls through a View (rather than a VectorClock) are not dispatched virtually.
  */
-class View : public VectorClock {
+class View final : public VectorClock {
 private:
-	using EventView = llvm::IndexedMap<int>;
+	/** Number of threads stored inline before falling back to the heap */
+	static constexpr unsigned inlineThreads = 8;
+
+	using EventView = llvm::SmallVector<int, inlineThreads>;
 	EventView view_;
 
 public:
 	/** Constructors */
-	View() : VectorClock(VectorClock::VectorClockKind::VC_View), view_(EventView(0)) {}
+	View() : VectorClock(VectorClock::VectorClockKind::VC_View) {}
 
 	/** Iterators */
 	using iterator = int *;
 	using const_iterator = const int *;
 
-	auto begin() -> iterator { return &view_[0]; };
-	auto end() -> iterator { return &view_[0] + size(); }
-	[[nodiscard]] auto begin() const -> const_iterator { return empty() ? nullptr : &view_[0]; }
-	[[nodiscard]] auto end() const -> const_iterator
-	{
-		return empty() ? nullptr : &view_[0] + size();
-	}
+	auto begin() -> iterator { return view_.begin(); };
+	auto end() -> iterator { return view_.end(); }
+	[[nodiscard]] auto begin() const -> const_iterator { return view_.begin(); }
+	[[nodiscard]] auto end() const -> const_iterator { return view_.end(); }
 
 	/** Returns the size of this view (i.e., number of threads seen) */
-	[[nodiscard]] auto size() const -> unsigned int override;
+	[[nodiscard]] auto size() const -> unsigned int override { return view_.size(); }
 
 	/** Returns true if this view is empty */
-	[[nodiscard]] auto empty() const -> bool;
+	[[nodiscard]] auto empty() const -> bool { return view_.empty(); }
 
 	void clear() override { view_.clear(); }
 
 	/** Returns true if e is contained in the clock */
-	[[nodiscard]] auto contains(Event e) const -> bool override;
+	[[nodiscard]] auto contains(Event e) const -> bool override
+	{
+		return e.index <= getMax(e.thread);
+	}
 
 	/** Updates the view based on another vector clock. We can
 	 * only update the current view given another View (and not
@@ -88,13 +95,22 @@ public:
 	void setMax(Event e) override
 	{
 		if (e.thread >= (int)view_.size())
-			view_.grow(e.thread);
+			view_.resize(e.thread + 1, 0);
 		view_[e.thread] = e.index;
 	}
 
 	void printData(llvm::raw_ostream &s) const override;
 
+#ifdef ENABLE_GENMC_DEBUG
+	/** Makes update(const View &) write both its operands to OS before
+	 * updating (see -record-view-updates); a null OS stops the recording */
+	static void recordUpdates(llvm::raw_ostream *os);
+#endif
+
 	static auto classof(const VectorClock *vc) -> bool { return vc->getKind() == VC_View; }
 };
 
+void serialize(BinaryWriter &w, const View &v);
+void deserialize(BinaryReader &r, View &v);
+
 #endif /* GENMC_VIEW_HPP */
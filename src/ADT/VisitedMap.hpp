@@ -0,0 +1,83 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#ifndef GENMC_VISITED_MAP_HPP
+#define GENMC_VISITED_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A stamp-indexed map of DFS visit statuses, as used by the consistency
+ * checkers. Each traversal starts with clear() and resize(), like it would
+ * for a std::vector, but clear() only opens a new epoch: entries last written
+ * in an earlier epoch read as default-constructed. A traversal thus costs time
+ * proportional to the events it visits, not to the size of the graph.
+ */
+template <typename T> class VisitedMap {
+
+public:
+	/** Forgets all entries */
+	void clear()
+	{
+		fill_ = T();
+		if (++epoch_ == 0) {
+			/* Entries from old epochs would become current again */
+			for (auto &e : entries_)
+				e.epoch = 0;
+			epoch_ = 1;
+		}
+	}
+
+	/** Makes room for N entries (the map never shrinks) */
+	void resize(std::size_t n)
+	{
+		if (n > entries_.size())
+			entries_.resize(n);
+	}
+
+	/** Same as above, but entries not yet written in this epoch read as VAL */
+	void resize(std::size_t n, const T &val)
+	{
+		resize(n);
+		fill_ = val;
+	}
+
+	auto operator[](std::size_t i) -> T &
+	{
+		auto &e = entries_[i];
+		if (e.epoch != epoch_) {
+			e.value = fill_;
+			e.epoch = epoch_;
+		}
+		return e.value;
+	}
+
+private:
+	struct Entry {
+		T value{};
+		uint32_t epoch{};
+	};
+
+	std::vector<Entry> entries_;
+	uint32_t epoch_ = 1;
+	T fill_{};
+};
+
+#endif /* GENMC_VISITED_MAP_HPP */
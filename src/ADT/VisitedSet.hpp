@@ -0,0 +1,75 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#ifndef GENMC_VISITED_SET_HPP
+#define GENMC_VISITED_SET_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * A lock-free set of (64-bit) fingerprints with a fixed capacity, used to
+ * detect states that have already been visited. The table is open-addressed
+ * with bounded linear probing; once a neighborhood is full, new fingerprints
+ * are dropped (and reported as unseen), so the set never grows.
+ */
+class VisitedSet {
+
+public:
+	/** Creates a set holding (up to) CAPACITY fingerprints.
+	 * (CAPACITY is rounded up to a power of two.) */
+	explicit VisitedSet(std::size_t capacity)
+		: mask(std::bit_ceil(std::max<std::size_t>(capacity, maxProbes)) - 1),
+		  table(std::make_unique<std::atomic<uint64_t>[]>(mask + 1))
+	{}
+
+	/** Inserts FP; returns true if FP was not in the set already */
+	auto insert(uint64_t fp) -> bool
+	{
+		/* Zero marks empty slots */
+		if (fp == 0)
+			fp = 1;
+
+		for (auto i = 0U; i < maxProbes; i++) {
+			auto &slot = table[(fp + i) & mask];
+			auto cur = slot.load(std::memory_order_relaxed);
+			if (cur == 0 && slot.compare_exchange_strong(cur, fp, std::memory_order_relaxed))
+				return true;
+			if (cur == fp)
+				return false;
+		}
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/** Returns the number of fingerprints that did not fit in the set */
+	auto getNumDropped() const -> uint64_t { return dropped.load(std::memory_order_relaxed); }
+
+private:
+	static constexpr unsigned maxProbes = 16;
+
+	std::size_t mask;
+	std::unique_ptr<std::atomic<uint64_t>[]> table;
+	std::atomic<uint64_t> dropped{0};
+};
+
+#endif /* GENMC_VISITED_SET_HPP */
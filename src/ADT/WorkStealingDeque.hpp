@@ -0,0 +1,192 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#ifndef GENMC_WORK_STEALING_DEQUE_HPP
+#define GENMC_WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * A Chase-Lev work-stealing deque (using the C11 formulation of Le et al.,
+ * PPoPP'13). The owner thread pushes and pops at the bottom end, while
+ * other threads steal from the top end. The deque owns the items it holds.
+ *
+ * Buffers replaced due to growth are retired (not freed) until the deque is
+ * destroyed, as concurrent thieves may still be reading from them.
+ */
+template <typename T> class WorkStealingDeque {
+
+	/** A circular buffer of (owned) raw pointers */
+	class Buffer {
+	public:
+		explicit Buffer(int64_t cap) : mask(cap - 1), slots(new std::atomic<T *>[cap]) {}
+
+		auto capacity() const -> int64_t { return mask + 1; }
+
+		auto get(int64_t i) const -> T *
+		{
+			return slots[i & mask].load(std::memory_order_relaxed);
+		}
+		void put(int64_t i, T *item)
+		{
+			slots[i & mask].store(item, std::memory_order_relaxed);
+		}
+
+		/** Returns a buffer with twice the capacity holding the items in [T, B) */
+		auto grow(int64_t t, int64_t b) const -> std::unique_ptr<Buffer>
+		{
+			auto buf = std::make_unique<Buffer>(2 * capacity());
+			for (auto i = t; i < b; i++)
+				buf->put(i, get(i));
+			return buf;
+		}
+
+	private:
+		int64_t mask;
+		std::unique_ptr<std::atomic<T *>[]> slots;
+	};
+
+public:
+	/** The outcome of a steal attempt */
+	enum class StealStatus { Success, Empty, Abort };
+
+	/*** Constructors ***/
+
+	explicit WorkStealingDeque(int64_t initialCapacity = 64)
+	{
+		retired.push_back(std::make_unique<Buffer>(initialCapacity));
+		buffer.store(retired.back().get(), std::memory_order_relaxed);
+	}
+	WorkStealingDeque(const WorkStealingDeque &) = delete;
+	auto operator=(const WorkStealingDeque &) -> WorkStealingDeque & = delete;
+
+	/*** Owner operations ***/
+
+	/** Pushes ITEM at the bottom of the deque */
+	void push(std::unique_ptr<T> item)
+	{
+		auto b = bottom.load(std::memory_order_relaxed);
+		auto t = top.load(std::memory_order_acquire);
+		auto *buf = buffer.load(std::memory_order_relaxed);
+		if (b - t > buf->capacity() - 1) {
+			retired.push_back(buf->grow(t, b));
+			buf = retired.back().get();
+			buffer.store(buf, std::memory_order_release);
+		}
+		buf->put(b, item.release());
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	/** Pops an item from the bottom of the deque (nullptr if empty) */
+	auto pop() -> std::unique_ptr<T>
+	{
+		auto b = bottom.load(std::memory_order_relaxed) - 1;
+		auto *buf = buffer.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto t = top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		auto *item = buf->get(b);
+		if (t == b) {
+			/* Last item: race against thieves */
+			if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+							 std::memory_order_relaxed))
+				item = nullptr;
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return std::unique_ptr<T>(item);
+	}
+
+	/*** Thief operations ***/
+
+	/** Tries to steal an item from the top of the deque. On success, ITEM
+	 * holds the stolen item. Abort denotes a lost race with another thread */
+	auto steal(std::unique_ptr<T> &item) -> StealStatus
+	{
+		auto t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto b = bottom.load(std::memory_order_acquire);
+		if (t >= b)
+			return StealStatus::Empty;
+
+		auto *buf = buffer.load(std::memory_order_acquire);
+		auto *stolen = buf->get(t);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+						 std::memory_order_relaxed))
+			return StealStatus::Abort;
+		item.reset(stolen);
+		return StealStatus::Success;
+	}
+
+	/*** Queries ***/
+
+	/** Returns an approximation of the number of items in the deque */
+	auto size() const -> int64_t
+	{
+		auto b = bottom.load(std::memory_order_relaxed);
+		auto t = top.load(std::memory_order_relaxed);
+		return b > t ? b - t : 0;
+	}
+
+	/** Returns true if the deque seems to be empty */
+	auto empty() const -> bool { return size() == 0; }
+
+	/** Calls FUN on each item of the deque, from top to bottom.
+	 * No other thread may operate on the deque in the meantime */
+	template <typename F> void forEach(F &&fun) const
+	{
+		auto *buf = buffer.load(std::memory_order_relaxed);
+		auto b = bottom.load(std::memory_order_relaxed);
+		for (auto i = top.load(std::memory_order_relaxed); i < b; i++)
+			fun(*buf->get(i));
+	}
+
+	/*** Destructor ***/
+
+	~WorkStealingDeque()
+	{
+		auto *buf = buffer.load(std::memory_order_relaxed);
+		auto b = bottom.load(std::memory_order_relaxed);
+		for (auto i = top.load(std::memory_order_relaxed); i < b; i++)
+			delete buf->get(i);
+	}
+
+private:
+	/** Index of the next item to be stolen */
+	alignas(64) std::atomic<int64_t> top{0};
+
+	/** Index of the next free slot (owner-side) */
+	alignas(64) std::atomic<int64_t> bottom{0};
+
+	/** The currently active buffer */
+	std::atomic<Buffer *> buffer{nullptr};
+
+	/** All buffers ever allocated (incl. the active one) */
+	std::vector<std::unique_ptr<Buffer>> retired;
+};
+
+#endif /* GENMC_WORK_STEALING_DEQUE_HPP */
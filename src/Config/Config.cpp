@@ -41,6 +41,10 @@ static llvm::cl::list<std::string> clCFLAGS(llvm::cl::Positional, llvm::cl::Zero
 static llvm::cl::opt<std::string> clInputFile(llvm::cl::Positional, llvm::cl::Required,
 					      llvm::cl::desc("<input file>"));
 
+static llvm::cl::opt<bool>
+	clBatch("batch", llvm::cl::cat(clGeneral),
+		llvm::cl::desc("Verify each of the inputs listed (one per line) in the input file"));
+
 /*** Exploration options ***/
 
 static llvm::cl::opt<ModelType> clModelType(
@@ -60,6 +64,33 @@ static llvm::cl::opt<unsigned int>
 	clThreads("nthreads", llvm::cl::cat(clGeneral), llvm::cl::init(1),
 		  llvm::cl::desc("Number of threads to be used in the exploration"));
 
+static llvm::cl::opt<unsigned int> clProcesses(
+	"processes", llvm::cl::cat(clGeneral), llvm::cl::init(0), llvm::cl::value_desc("N"),
+	llvm::cl::desc("Distribute the exploration across N local worker processes"));
+
+static llvm::cl::opt<std::string>
+	clListen("listen", llvm::cl::cat(clGeneral), llvm::cl::value_desc("[host:]port"),
+		 llvm::cl::desc("Accept worker processes connecting at the given address "
+				"(workers are trusted; do not expose the address)"));
+
+static llvm::cl::opt<std::string>
+	clConnect("connect", llvm::cl::cat(clGeneral), llvm::cl::value_desc("host:port"),
+		  llvm::cl::desc("Run as a worker of the (trusted) coordinator at the given address"));
+
+static llvm::cl::opt<SplitPolicy> clSplitPolicy(
+	"split-policy", llvm::cl::cat(clGeneral), llvm::cl::init(SplitPolicy::fixed),
+	llvm::cl::desc("Choose when revisits are shipped to other workers (with -nthreads/-processes):"),
+	llvm::cl::values(
+		clEnumValN(SplitPolicy::fixed, "static",
+			   "Whenever fewer than 8 tasks per thread are pending (default)"),
+		clEnumValN(SplitPolicy::adaptive, "adaptive",
+			   "When threads starve, near the root or for large subtrees"),
+		clEnumValN(SplitPolicy::depth, "depth", "Like static, but only near the root")));
+
+static llvm::cl::opt<unsigned int> clSplitDepth(
+	"split-depth", llvm::cl::cat(clGeneral), llvm::cl::init(4), llvm::cl::value_desc("N"),
+	llvm::cl::desc("Revisit-tree depth up to which -split-policy=adaptive|depth split"));
+
 static llvm::cl::opt<int>
 	clBound("bound", llvm::cl::cat(clGeneral), llvm::cl::init(-1), llvm::cl::value_desc("N"),
 		llvm::cl::desc("Do not explore executions exceeding given bound"));
@@ -100,6 +131,25 @@ static llvm::cl::opt<bool> clDisableInstructionCaching(
 	"disable-instruction-caching", llvm::cl::cat(clGeneral),
 	llvm::cl::desc("Disable instruction caching (pure stateless exploration)"));
 
+static llvm::cl::opt<unsigned int> clSnapshotCacheSize(
+	"snapshot-cache-size", llvm::cl::init(0), llvm::cl::value_desc("N"),
+	llvm::cl::cat(clGeneral),
+	llvm::cl::desc("Number of thread snapshots kept for resuming threads on revisits "
+		       "(default: 0, i.e., re-execute threads from the start). Pays off "
+		       "for threads with long local computations"));
+
+static llvm::cl::opt<bool> clPruneDuplicates(
+	"prune-duplicates", llvm::cl::cat(clGeneral),
+	llvm::cl::desc("Skip revisits that lead to an already explored graph. Graphs are "
+		       "compared by 64-bit fingerprints: a collision (probability about "
+		       "2^-42 per revisit with the default -visited-set-size) silently "
+		       "skips unexplored executions, so results are not guaranteed complete"));
+
+static llvm::cl::opt<unsigned int> clVisitedSetSize(
+	"visited-set-size", llvm::cl::init(1U << 22), llvm::cl::value_desc("N"),
+	llvm::cl::cat(clGeneral),
+	llvm::cl::desc("Number of graph fingerprints remembered for detecting duplicates"));
+
 static llvm::cl::opt<bool> clDisableRaceDetection("disable-race-detection",
 						  llvm::cl::cat(clGeneral),
 						  llvm::cl::desc("Disable race detection"));
@@ -125,6 +175,47 @@ static llvm::cl::opt<std::string>
 		       llvm::cl::cat(clGeneral),
 		       llvm::cl::desc("Check implementation refinement of specification file"));
 
+static llvm::cl::opt<bool>
+	clBinaryLinSpec("binary-lin-spec", llvm::cl::cat(clGeneral),
+			llvm::cl::desc("Save the collected specification in the binary format"));
+
+static llvm::cl::opt<bool> clExpandLinSpec(
+	"expand-lin-spec", llvm::cl::cat(clDebugging),
+	llvm::cl::desc("Restore all symmetric observations in the collected specification "
+		       "(e.g., to compare it textually against an expected one)"));
+
+static llvm::cl::opt<std::string> clConvertLinSpec(
+	"convert-lin-spec", llvm::cl::init(""), llvm::cl::value_desc("file"),
+	llvm::cl::cat(clGeneral),
+	llvm::cl::desc("Convert the input specification into a file "
+		       "(text specifications to the binary format, and vice versa)"));
+
+static llvm::cl::opt<unsigned int> clLinSpecCacheSize(
+	"lin-spec-cache-size", llvm::cl::init(4096), llvm::cl::value_desc("N"),
+	llvm::cl::cat(clGeneral),
+	llvm::cl::desc("Number of observations whose hints are kept across executions "
+		       "when checking a specification (0 disables caching)"));
+
+static llvm::cl::opt<std::string>
+	clCheckpointFile("checkpoint", llvm::cl::init(""), llvm::cl::value_desc("file"),
+			 llvm::cl::cat(clGeneral),
+			 llvm::cl::desc("Periodically save the pending exploration to a file"));
+
+static llvm::cl::opt<unsigned int> clCheckpointInterval(
+	"checkpoint-interval", llvm::cl::init(60), llvm::cl::value_desc("secs"),
+	llvm::cl::cat(clGeneral),
+	llvm::cl::desc("Seconds between checkpoints (0: after every execution)"));
+
+static llvm::cl::opt<unsigned int> clCheckpointStopAfter(
+	"checkpoint-stop-after", llvm::cl::init(0), llvm::cl::value_desc("N"),
+	llvm::cl::cat(clDebugging),
+	llvm::cl::desc("Take a checkpoint and stop once N executions have been explored"));
+
+static llvm::cl::opt<std::string>
+	clResumeFile("resume", llvm::cl::init(""), llvm::cl::value_desc("file"),
+		     llvm::cl::cat(clGeneral),
+		     llvm::cl::desc("Resume the exploration saved in a checkpoint file"));
+
 static llvm::cl::opt<bool>
 	clDotPrintOnlyClientEvents("dot-print-only-client-events", llvm::cl::cat(clGeneral),
 				   llvm::cl::desc("Omit library events in the DOT file"));
@@ -204,6 +295,15 @@ static llvm::cl::opt<bool> clDisableMMDetector("disable-mm-detector",
 					       llvm::cl::cat(clTransformation),
 					       llvm::cl::desc("Disable MM detector pass"));
 
+static llvm::cl::opt<bool>
+	clCompileInProcess("compile-in-process", llvm::cl::cat(clTransformation),
+			   llvm::cl::desc("Compile the input using clang as a library"));
+
+static llvm::cl::opt<std::string> clModuleCache(
+	"module-cache", llvm::cl::init(""), llvm::cl::value_desc("dir"),
+	llvm::cl::cat(clTransformation),
+	llvm::cl::desc("Reuse compiled and transformed inputs across runs (cached in dir)"));
+
 /*** Debugging options ***/
 
 static llvm::cl::opt<unsigned int> clEstimationMax(
@@ -245,6 +345,16 @@ llvm::cl::opt<SchedulePolicy> clSchedulePolicy(
 			 clEnumValN(SchedulePolicy::wfr, "wfr", "Writes-first-random"),
 			 clEnumValN(SchedulePolicy::arbitrary, "arbitrary", "Arbitrary")));
 
+static llvm::cl::opt<bool> clDisableEventScheduling(
+	"disable-event-scheduling", llvm::cl::cat(clDebugging),
+	llvm::cl::desc("Reschedule before every instruction (instead of only before "
+		       "instructions that may add events)"));
+
+static llvm::cl::opt<bool> clDisableBytecode(
+	"disable-bytecode", llvm::cl::cat(clDebugging),
+	llvm::cl::desc("Execute every instruction through the visitor (instead of compiling "
+		       "local ones to bytecode)"));
+
 static llvm::cl::opt<bool> clPrintArbitraryScheduleSeed(
 	"print-schedule-seed", llvm::cl::cat(clDebugging),
 	llvm::cl::desc("Print the seed used for arbitrary scheduling"));
@@ -260,6 +370,10 @@ static llvm::cl::opt<bool> clPrintExecGraphs("print-exec-graphs", llvm::cl::cat(
 static llvm::cl::opt<bool> clPrintBlockedExecs("print-blocked-execs", llvm::cl::cat(clDebugging),
 					       llvm::cl::desc("Print blocked execution graphs"));
 
+static llvm::cl::opt<bool>
+	clPrintPoolStats("print-pool-stats", llvm::cl::cat(clDebugging),
+			 llvm::cl::desc("Print thread-pool statistics (with -nthreads)"));
+
 llvm::cl::opt<VerbosityLevel> clVLevel(
 	llvm::cl::cat(clDebugging), llvm::cl::init(VerbosityLevel::Tip),
 	llvm::cl::desc("Choose verbosity level:"),
@@ -299,8 +413,14 @@ static llvm::cl::opt<bool> clPrintEstimationStats("print-estimation-stats",
 						  llvm::cl::cat(clDebugging),
 						  llvm::cl::desc("Prints estimations statistics"));
 
-static llvm::cl::opt<bool> clRelincheDebug("relinche-debug", llvm::cl::cat(clDebugging),
-					   llvm::cl::desc("Enable debug printing for Relinche"));
+static llvm::cl::opt<bool>
+	clRelincheDebug("relinche-debug", llvm::cl::cat(clDebugging),
+			llvm::cl::desc("Enable debug printing and checks for Relinche"));
+
+static llvm::cl::opt<std::string> clRecordViewUpdates(
+	"record-view-updates", llvm::cl::init(""), llvm::cl::value_desc("file"),
+	llvm::cl::cat(clDebugging),
+	llvm::cl::desc("Record the operands of all view updates to a file (see view-bench)"));
 #endif /* ENABLE_GENMC_DEBUG */
 
 static void printVersion(llvm::raw_ostream &s)
@@ -328,6 +448,16 @@ static void checkConfigOptions()
 		clDisableIPR = true;
 	}
 
+	/* Check transformation options */
+#ifndef HAVE_LIBCLANG_CPP
+	ERROR_ON(clCompileInProcess,
+		 "--compile-in-process requires GenMC to be configured with "
+		 "--enable-in-process-compilation.\n");
+#endif
+	if (clCompileInProcess && clInputFromBitcodeFile) {
+		WARN("--compile-in-process used with -input-from-bitcode-file.\n");
+	}
+
 	/* Check debugging options */
 	if (clSchedulePolicy != SchedulePolicy::arbitrary && clPrintArbitraryScheduleSeed) {
 		WARN("--print-schedule-seed used without -schedule-policy=arbitrary.\n");
@@ -336,6 +466,15 @@ static void checkConfigOptions()
 		WARN("--schedule-seed used without -schedule-policy=arbitrary.\n");
 	}
 
+	auto distributed = clProcesses > 0 || !clListen.empty() || !clConnect.empty();
+	if (clThreads <= 1 && !distributed &&
+	    (clSplitPolicy.getNumOccurrences() > 0 || clSplitDepth.getNumOccurrences() > 0)) {
+		WARN("--split-policy/--split-depth used without -nthreads or -processes.\n");
+	}
+	if (clThreads <= 1 && clPrintPoolStats) {
+		WARN("--print-pool-stats used without -nthreads.\n");
+	}
+
 	/* Check bounding options */
 	if (clBound != -1 && clModelType != ModelType::SC) {
 		ERROR("Bounding can only be used with --sc.\n");
@@ -364,6 +503,62 @@ static void checkConfigOptions()
 		      "run.\n");
 	}
 
+	if (!clConvertLinSpec.empty() && (!clCollectLinSpec.empty() || !clCheckLinSpec.empty())) {
+		ERROR("-convert-lin-spec cannot be used with -collect-lin-spec or "
+		      "-check-lin-spec.\n");
+	}
+	if (clBinaryLinSpec && clCollectLinSpec.empty()) {
+		WARN("--binary-lin-spec used without --collect-lin-spec.\n");
+	}
+	if (clExpandLinSpec && clCollectLinSpec.empty()) {
+		WARN("--expand-lin-spec used without --collect-lin-spec.\n");
+	}
+
+	/* Check duplicate-detection options */
+	if (clVisitedSetSize == 0) {
+		ERROR("--visited-set-size must be positive.\n");
+	}
+
+	/* Check checkpointing options */
+	if ((!clCheckpointFile.empty() || !clResumeFile.empty()) && !clCollectLinSpec.empty()) {
+		ERROR("Checkpointing cannot be used with -collect-lin-spec.\n");
+	}
+	if (clCheckpointFile.empty() && clCheckpointInterval.getNumOccurrences() > 0) {
+		WARN("--checkpoint-interval used without --checkpoint.\n");
+	}
+	if (clCheckpointFile.empty() && clCheckpointStopAfter > 0) {
+		ERROR("--checkpoint-stop-after requires --checkpoint.\n");
+	}
+
+	/* Check distribution options */
+	if (distributed && clThreads > 1) {
+		ERROR("-processes/-listen/-connect cannot be used with -nthreads.\n");
+	}
+	if (!clConnect.empty() && (clProcesses > 0 || !clListen.empty())) {
+		ERROR("-connect cannot be used with -processes or -listen.\n");
+	}
+	if (distributed && (!clCheckpointFile.empty() || !clResumeFile.empty())) {
+		ERROR("Checkpointing cannot be used with distributed exploration.\n");
+	}
+	if (distributed && !clCollectLinSpec.empty()) {
+		ERROR("-collect-lin-spec cannot be used with distributed exploration.\n");
+	}
+
+	/* Check batch options */
+	if (clBatch && (distributed || !clCheckpointFile.empty() || !clResumeFile.empty())) {
+		ERROR("-batch cannot be used with distributed exploration or checkpointing.\n");
+	}
+	if (clBatch && (!clCollectLinSpec.empty() || !clConvertLinSpec.empty())) {
+		ERROR("-batch cannot be used with -collect-lin-spec or -convert-lin-spec.\n");
+	}
+
+#ifdef ENABLE_GENMC_DEBUG
+	/* Check tracing options */
+	if (!clRecordViewUpdates.empty() && (clThreads > 1 || distributed)) {
+		ERROR("-record-view-updates cannot be used with parallel exploration.\n");
+	}
+#endif
+
 	/* Make sure filename is a regular file */
 	if (!llvm::sys::fs::is_regular_file(clInputFile))
 		ERROR("Input file is not a regular file!\n");
@@ -374,16 +569,23 @@ static void saveConfigOptions(Config &conf)
 	/* General syntax */
 	conf.cflags.insert(conf.cflags.end(), clCFLAGS.begin(), clCFLAGS.end());
 	conf.inputFile = std::move(clInputFile);
+	conf.batch = clBatch;
 
 	/* Save exploration options */
 	conf.dotFile = std::move(clDotGraphFile);
 	conf.model = clModelType;
-	conf.estimate = !clDisableEstimation;
+	/* The state space of a resumed exploration has already been estimated */
+	conf.estimate = !clDisableEstimation && clResumeFile.empty();
 	conf.estimationMax = clEstimationMax;
 	conf.estimationMin = clEstimationMin;
 	conf.sdThreshold = clEstimationSdThreshold;
 	conf.isDepTrackingModel = (conf.model == ModelType::IMM);
 	conf.threads = clThreads;
+	conf.processes = clProcesses;
+	conf.listenAddr = clListen.empty() ? std::nullopt : std::optional(clListen.getValue());
+	conf.connectAddr = clConnect.empty() ? std::nullopt : std::optional(clConnect.getValue());
+	conf.splitPolicy = clSplitPolicy;
+	conf.splitDepth = clSplitDepth;
 	conf.bound = clBound >= 0 ? std::optional(clBound.getValue()) : std::nullopt;
 	conf.boundType = clBoundType;
 	conf.LAPOR = clLAPOR;
@@ -392,6 +594,9 @@ static void saveConfigOptions(Config &conf)
 	conf.printErrorTrace = clPrintErrorTrace;
 	conf.checkLiveness = clCheckLiveness;
 	conf.instructionCaching = !clDisableInstructionCaching;
+	conf.snapshotCacheSize = clSnapshotCacheSize;
+	conf.pruneDuplicates = clPruneDuplicates;
+	conf.visitedSetSize = clVisitedSetSize;
 	conf.disableRaceDetection = clDisableRaceDetection;
 	conf.disableBAM = clDisableBAM;
 	conf.ipr = !clDisableIPR;
@@ -401,6 +606,21 @@ static void saveConfigOptions(Config &conf)
 						       : std::optional(clCollectLinSpec.getValue());
 	conf.checkLinSpec = clCheckLinSpec.empty() ? std::nullopt
 						   : std::optional(clCheckLinSpec.getValue());
+	conf.binaryLinSpec = clBinaryLinSpec;
+	conf.expandLinSpec = clExpandLinSpec;
+	conf.convertLinSpec = clConvertLinSpec.empty()
+				      ? std::nullopt
+				      : std::optional(clConvertLinSpec.getValue());
+	conf.linSpecCacheSize = clLinSpecCacheSize;
+	conf.checkpointFile = clCheckpointFile.empty()
+				      ? std::nullopt
+				      : std::optional(clCheckpointFile.getValue());
+	conf.checkpointInterval = clCheckpointInterval;
+	conf.checkpointStopAfter = clCheckpointStopAfter > 0
+					   ? std::optional(clCheckpointStopAfter.getValue())
+					   : std::nullopt;
+	conf.resumeFile =
+		clResumeFile.empty() ? std::nullopt : std::optional(clResumeFile.getValue());
 	conf.dotPrintOnlyClientEvents = clDotPrintOnlyClientEvents;
 	conf.maxExtSize = clMaxExtSize;
 
@@ -423,15 +643,21 @@ static void saveConfigOptions(Config &conf)
 	conf.assumePropagation = !clDisableAssumePropagation;
 	conf.confirmAnnot = !clDisableConfirmAnnot;
 	conf.mmDetector = !clDisableMMDetector;
+	conf.compileInProcess = clCompileInProcess;
+	conf.moduleCacheDir =
+		clModuleCache.empty() ? std::nullopt : std::optional(clModuleCache.getValue());
 
 	/* Save debugging options */
 	conf.programEntryFun = std::move(clProgramEntryFunction);
 	conf.warnOnGraphSize = clWarnOnGraphSize;
 	conf.schedulePolicy = clSchedulePolicy;
+	conf.eventScheduling = !clDisableEventScheduling;
+	conf.bytecode = !clDisableBytecode;
 	conf.printRandomScheduleSeed = clPrintArbitraryScheduleSeed;
 	conf.randomScheduleSeed = std::move(clArbitraryScheduleSeed);
 	conf.printExecGraphs = clPrintExecGraphs;
 	conf.printBlockedExecs = clPrintBlockedExecs;
+	conf.printPoolStats = clPrintPoolStats;
 	conf.inputFromBitcodeFile = clInputFromBitcodeFile;
 	conf.transformFile = std::move(clTransformFile);
 	conf.vLevel = clVLevel;
@@ -444,6 +670,9 @@ static void saveConfigOptions(Config &conf)
 	conf.printEstimationStats = clPrintEstimationStats;
 	conf.boundsHistogram = clBoundsHistogram;
 	conf.relincheDebug = clRelincheDebug;
+	conf.viewTraceFile = clRecordViewUpdates.empty()
+				     ? std::nullopt
+				     : std::optional(clRecordViewUpdates.getValue());
 #endif
 }
 
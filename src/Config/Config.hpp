@@ -32,17 +32,24 @@
 
 enum class SchedulePolicy : std::uint8_t { ltr, wf, wfr, arbitrary };
 enum class BoundType : std::uint8_t { context, round };
+enum class SplitPolicy : std::uint8_t { fixed, adaptive, depth };
 
 struct Config {
 	/*** General syntax ***/
 	std::vector<std::string> cflags;
 	std::string inputFile;
+	bool batch{};
 
 	/*** Exploration options ***/
 	ModelType model{};
 	bool estimate{};
 	bool isDepTrackingModel{};
 	unsigned int threads{};
+	unsigned int processes{};
+	std::optional<std::string> listenAddr;
+	std::optional<std::string> connectAddr;
+	SplitPolicy splitPolicy{};
+	unsigned int splitDepth{};
 	std::optional<unsigned int> bound;
 	BoundType boundType{};
 	bool LAPOR{};
@@ -52,6 +59,9 @@ struct Config {
 	bool printErrorTrace{};
 	std::string dotFile;
 	bool instructionCaching{};
+	unsigned int snapshotCacheSize{};
+	bool pruneDuplicates{};
+	unsigned int visitedSetSize{};
 	bool disableRaceDetection{};
 	bool disableBAM{};
 	bool ipr{};
@@ -59,6 +69,14 @@ struct Config {
 	bool warnUnfreedMemory{};
 	std::optional<std::string> collectLinSpec;
 	std::optional<std::string> checkLinSpec;
+	bool binaryLinSpec{};
+	bool expandLinSpec{};
+	std::optional<std::string> convertLinSpec;
+	unsigned int linSpecCacheSize{};
+	std::optional<std::string> checkpointFile;
+	unsigned int checkpointInterval{};
+	std::optional<unsigned int> checkpointStopAfter;
+	std::optional<std::string> resumeFile;
 	unsigned int maxExtSize{};
 	bool dotPrintOnlyClientEvents{};
 
@@ -81,6 +99,8 @@ struct Config {
 	bool assumePropagation{};
 	bool confirmAnnot{};
 	bool mmDetector{};
+	bool compileInProcess{};
+	std::optional<std::string> moduleCacheDir;
 
 	/*** Debugging options ***/
 	unsigned int estimationMax{};
@@ -89,7 +109,10 @@ struct Config {
 	bool inputFromBitcodeFile{};
 	bool printExecGraphs{};
 	bool printBlockedExecs{};
+	bool printPoolStats{};
 	SchedulePolicy schedulePolicy{};
+	bool eventScheduling{};
+	bool bytecode{};
 	std::string randomScheduleSeed;
 	bool printRandomScheduleSeed{};
 	std::string transformFile;
@@ -105,6 +128,7 @@ struct Config {
 	bool printEstimationStats{};
 	bool boundsHistogram{};
 	bool relincheDebug{};
+	std::optional<std::string> viewTraceFile;
 #endif
 };
 
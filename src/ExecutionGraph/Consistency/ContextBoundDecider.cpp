@@ -23,7 +23,11 @@
 #include "ExecutionGraph/ExecutionGraph.hpp"
 #include "ExecutionGraph/GraphIterators.hpp"
 
+#include <llvm/ADT/Hashing.h>
+
+#include <limits>
 #include <ranges>
+#include <unordered_map>
 
 auto canBlock(const ExecutionGraph &g, const View &s, int t) -> bool
 {
@@ -133,48 +137,137 @@ void unfoldPrefix(const ExecutionGraph &g, View &v, int t)
 		shrinkViewByOneInPlace(v, t);
 }
 
-auto ContextBoundDecider::doesPrefixExceedBound(View v, int t, unsigned int bound) const -> bool
+namespace {
+
+/*
+ * Computes the number of pre-emptions needed to reach a view, going backwards
+ * from the view. The result for each (unfolded) prefix only depends on the
+ * prefix and the thread that was scheduled last, so results are memoized on
+ * these. Searches are given a budget and give up as soon as it is exhausted.
+ * Unless the exact minimum is requested, a search also stops as soon as it
+ * finds a way to stay within the budget.
+ */
+class PreemptionSearch {
+
+public:
+	PreemptionSearch(const ExecutionGraph &g, bool exact) : g(g), exact(exact) {}
+
+	/** Returns the number of pre-emptions needed to reach V with T scheduled
+	 * last, or BUDGET + 1 if the minimum number exceeds BUDGET */
+	auto search(View v, int t, unsigned budget) -> unsigned;
+
+private:
+	/** A view (compacted to the threads of the graph) and a thread */
+	struct Key {
+		llvm::SmallVector<int, 8> maxes;
+		int t;
+
+		auto operator==(const Key &other) const -> bool
+		{
+			return t == other.t && maxes == other.maxes;
+		}
+	};
+
+	struct KeyHasher {
+		auto operator()(const Key &k) const -> size_t
+		{
+			return llvm::hash_combine(
+				k.t, llvm::hash_combine_range(k.maxes.begin(), k.maxes.end()));
+		}
+	};
+
+	/** Bounds on the minimum cost of a prefix (lower <= min <= upper) */
+	struct Entry {
+		unsigned lower = 0;
+		unsigned upper = std::numeric_limits<unsigned>::max();
+	};
+
+	auto makeKey(const View &v, int t) const -> Key
+	{
+		Key k{{}, t};
+		k.maxes.reserve(g.getNumThreads());
+		for (auto i = 0U; i < g.getNumThreads(); i++)
+			k.maxes.push_back(v.getMax(i));
+		return k;
+	}
+
+	const ExecutionGraph &g;
+	bool exact;
+	std::unordered_map<Key, Entry, KeyHasher> memo;
+};
+
+auto PreemptionSearch::search(View v, int t, unsigned budget) -> unsigned
 {
-	auto &g = getGraph();
 	unfoldPrefix(g, v, t);
 
 	if (std::all_of(v.begin(), v.end(), [](auto &max) { return !max; }))
-		return true;
+		return 0;
+
+	auto key = makeKey(v, t);
+	if (auto it = memo.find(key); it != memo.end()) {
+		auto &e = it->second;
+		if (e.lower > budget)
+			return budget + 1;
+		if (e.upper <= budget && (!exact || e.lower == e.upper))
+			return e.upper;
+	}
 
+	/* F(s) = {t' | exists s'. s' ->(t') s}; continuing with T is free, so try it first */
+	auto best = budget + 1;
 	auto exists = false;
-	for (auto tp = 0u; tp < g.getNumThreads(); tp++) {
+	auto done = [&] { return best == 0 || (!exact && best <= budget); };
+	auto visit = [&](int tp) {
 		if (!v.getMax(tp) || !isSCMaximal(g, v, tp))
-			continue;
+			return;
 		exists = true;
-		auto sp = shrinkViewByOne(v, tp);
-		if ((tp != t) && isEnabled(g, v, tp)) {
-			if (bound && doesPrefixExceedBound(sp, tp, bound - 1))
-				return true;
-		} else if (doesPrefixExceedBound(sp, tp, bound))
-			return true;
+		auto cost = (tp != t && isEnabled(g, v, tp)) ? 1U : 0U;
+		if (cost >= best)
+			return;
+		auto sub = search(shrinkViewByOne(v, tp), tp, best - 1 - cost);
+		best = std::min(best, sub + cost);
+	};
+	visit(t);
+	for (auto tp = 0; !done() && tp < (int)g.getNumThreads(); tp++) {
+		if (tp != t)
+			visit(tp);
 	}
 	BUG_ON(!exists);
 
-	return false;
+	auto &e = memo[key];
+	if (best <= budget) {
+		e.upper = std::min(e.upper, best);
+		if (exact)
+			e.lower = best;
+	} else {
+		e.lower = std::max(e.lower, budget + 1);
+	}
+	return best;
 }
 
-auto ContextBoundDecider::doesExecutionExceedBound(unsigned int bound) const -> bool
+} // namespace
+
+auto ContextBoundDecider::computeBound(unsigned budget, bool exact) const -> unsigned
 {
 	const auto &g = getGraph();
 	const auto v = *llvm::dyn_cast<View>(g.getViewFromStamp(g.getMaxStamp()).get());
+	PreemptionSearch search(g, exact);
 
+	auto best = budget + 1;
 	auto exists = false;
-	for (auto i = 0U; i < g.getNumThreads(); i++) {
+	for (auto i = 0U; i < g.getNumThreads() && best > 0 && (exact || best > budget); i++) {
 		if (!v.getMax(i) || !isSCMaximal(g, v, i))
 			continue;
 		exists = true;
-		auto sp = shrinkViewByOne(v, i);
-		if (doesPrefixExceedBound(sp, i, bound))
-			return false;
+		best = std::min(best, search.search(shrinkViewByOne(v, i), i, best - 1));
 	}
 	BUG_ON(!exists);
 
-	return true;
+	return best;
+}
+
+auto ContextBoundDecider::doesExecutionExceedBound(unsigned int bound) const -> bool
+{
+	return computeBound(bound, false) > bound;
 }
 
 auto ContextBoundDecider::getSlack() const -> unsigned
@@ -192,39 +285,6 @@ auto ContextBoundDecider::getSlack() const -> unsigned
 #ifdef ENABLE_GENMC_DEBUG
 auto ContextBoundDecider::calculate() const -> unsigned
 {
-	auto &g = getGraph();
-	const auto v = *llvm::dyn_cast<View>(g.getViewFromStamp(g.getMaxStamp()).get());
-	std::optional<unsigned> res;
-
-	for (auto i = 0U; i < g.getNumThreads(); i++) {
-		if (!v.getMax(i) || !isSCMaximal(g, v, i))
-			continue;
-		auto sp = shrinkViewByOne(v, i);
-		auto b = calculate(sp, i);
-		res = res ? std::min(*res, b) : b;
-	}
-
-	return *res;
-}
-
-auto ContextBoundDecider::calculate(View v, int t) const -> unsigned
-{
-	auto &g = getGraph();
-	unfoldPrefix(g, v, t);
-
-	if (std::all_of(v.begin(), v.end(), [](auto &max) { return !max; }))
-		return 0;
-
-	std::optional<unsigned> res;
-	for (auto tp = 0u; tp < g.getNumThreads(); tp++) {
-		/* F(s) = {t' | exists s'. s' ->(t') s} */
-		if (!v.getMax(tp) || !isSCMaximal(g, v, tp))
-			continue;
-		auto sp = shrinkViewByOne(v, tp);
-		auto bound = calculate(sp, tp) + ((t != tp) && isEnabled(g, v, tp) ? 1 : 0);
-		res = res ? std::min(*res, bound) : bound;
-	}
-
-	return *res;
+	return computeBound(std::numeric_limits<unsigned>::max() - 1, true);
 }
 #endif
@@ -32,12 +32,15 @@ public:
 
 private:
 	[[nodiscard]] auto doesExecutionExceedBound(unsigned int bound) const -> bool override;
-	[[nodiscard]] auto doesPrefixExceedBound(View v, int t, unsigned int bound) const -> bool;
 	[[nodiscard]] auto getSlack() const -> unsigned override;
 #ifdef ENABLE_GENMC_DEBUG
 	[[nodiscard]] auto calculate() const -> unsigned override;
-	[[nodiscard]] auto calculate(View v, int t) const -> unsigned;
 #endif
+
+	/** Returns a number of pre-emptions with which the current execution can be
+	 * obtained (the minimum one, if EXACT), or BUDGET + 1 if the minimum is
+	 * greater than BUDGET */
+	[[nodiscard]] auto computeBound(unsigned budget, bool exact) const -> unsigned;
 };
 
 #endif /* GENMC_CONTEXT_BOUND_DECIDER_HPP */
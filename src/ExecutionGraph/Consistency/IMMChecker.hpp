@@ -25,6 +25,7 @@
 #ifndef GENMC_IMM_CHECKER_HPP
 #define GENMC_IMM_CHECKER_HPP
 
+#include "ADT/VisitedMap.hpp"
 #include "ExecutionGraph/Consistency/ConsistencyChecker.hpp"
 #include "ExecutionGraph/EventLabel.hpp"
 #include <cstdint>
@@ -62,14 +63,14 @@ private:
 	void calculateViews(EventLabel *lab);
 	mutable const EventLabel *cexLab{};
 
-	mutable std::vector<NodeStatus> visitedCalc66_0;
-	mutable std::vector<NodeStatus> visitedCalc66_1;
-	mutable std::vector<NodeStatus> visitedCalc66_2;
-	mutable std::vector<NodeStatus> visitedCalc66_3;
-	mutable std::vector<NodeStatus> visitedCalc66_4;
-	mutable std::vector<NodeStatus> visitedCalc66_5;
-	mutable std::vector<NodeStatus> visitedCalc66_6;
-	mutable std::vector<NodeStatus> visitedCalc66_7;
+	mutable VisitedMap<NodeStatus> visitedCalc66_0;
+	mutable VisitedMap<NodeStatus> visitedCalc66_1;
+	mutable VisitedMap<NodeStatus> visitedCalc66_2;
+	mutable VisitedMap<NodeStatus> visitedCalc66_3;
+	mutable VisitedMap<NodeStatus> visitedCalc66_4;
+	mutable VisitedMap<NodeStatus> visitedCalc66_5;
+	mutable VisitedMap<NodeStatus> visitedCalc66_6;
+	mutable VisitedMap<NodeStatus> visitedCalc66_7;
 
 	bool visitCalc66_0(const EventLabel *lab, View &calcRes) const;
 	bool visitCalc66_1(const EventLabel *lab, View &calcRes) const;
@@ -84,14 +85,14 @@ private:
 	const View&getHbStableView(const EventLabel *lab) const { return lab->view(0); }
 
 	auto checkCalc66(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedCalc68_0;
-	mutable std::vector<NodeStatus> visitedCalc68_1;
-	mutable std::vector<NodeStatus> visitedCalc68_2;
-	mutable std::vector<NodeStatus> visitedCalc68_3;
-	mutable std::vector<NodeStatus> visitedCalc68_4;
-	mutable std::vector<NodeStatus> visitedCalc68_5;
-	mutable std::vector<NodeStatus> visitedCalc68_6;
-	mutable std::vector<NodeStatus> visitedCalc68_7;
+	mutable VisitedMap<NodeStatus> visitedCalc68_0;
+	mutable VisitedMap<NodeStatus> visitedCalc68_1;
+	mutable VisitedMap<NodeStatus> visitedCalc68_2;
+	mutable VisitedMap<NodeStatus> visitedCalc68_3;
+	mutable VisitedMap<NodeStatus> visitedCalc68_4;
+	mutable VisitedMap<NodeStatus> visitedCalc68_5;
+	mutable VisitedMap<NodeStatus> visitedCalc68_6;
+	mutable VisitedMap<NodeStatus> visitedCalc68_7;
 
 	bool visitCalc68_0(const EventLabel *lab, View &calcRes) const;
 	bool visitCalc68_1(const EventLabel *lab, View &calcRes) const;
@@ -106,10 +107,10 @@ private:
 	const View&getHbRelincheView(const EventLabel *lab) const { return lab->view(1); }
 
 	auto checkCalc68(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedCalc79_0;
-	mutable std::vector<NodeStatus> visitedCalc79_1;
-	mutable std::vector<NodeStatus> visitedCalc79_2;
-	mutable std::vector<NodeStatus> visitedCalc79_3;
+	mutable VisitedMap<NodeStatus> visitedCalc79_0;
+	mutable VisitedMap<NodeStatus> visitedCalc79_1;
+	mutable VisitedMap<NodeStatus> visitedCalc79_2;
+	mutable VisitedMap<NodeStatus> visitedCalc79_3;
 
 	bool visitCalc79_0(const EventLabel *lab, View &calcRes) const;
 	bool visitCalc79_1(const EventLabel *lab, View &calcRes) const;
@@ -120,21 +121,21 @@ private:
 	const View&getPorfStableView(const EventLabel *lab) const { return lab->view(2); }
 
 	auto checkCalc79(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedCoherence_0;
-	mutable std::vector<NodeStatus> visitedCoherence_1;
-	mutable std::vector<NodeStatus> visitedCoherence_2;
-	mutable std::vector<NodeStatus> visitedCoherence_3;
-	mutable std::vector<NodeStatus> visitedCoherence_4;
-	mutable std::vector<NodeStatus> visitedCoherence_5;
-	mutable std::vector<NodeStatus> visitedCoherence_6;
-	mutable std::vector<NodeStatus> visitedCoherence_7;
-	mutable std::vector<NodeStatus> visitedCoherence_8;
-	mutable std::vector<NodeStatus> visitedCoherence_9;
-	mutable std::vector<NodeStatus> visitedCoherence_10;
-	mutable std::vector<NodeStatus> visitedCoherence_11;
-	mutable std::vector<NodeStatus> visitedCoherence_12;
-	mutable std::vector<NodeStatus> visitedCoherence_13;
-	mutable std::vector<NodeStatus> visitedCoherence_14;
+	mutable VisitedMap<NodeStatus> visitedCoherence_0;
+	mutable VisitedMap<NodeStatus> visitedCoherence_1;
+	mutable VisitedMap<NodeStatus> visitedCoherence_2;
+	mutable VisitedMap<NodeStatus> visitedCoherence_3;
+	mutable VisitedMap<NodeStatus> visitedCoherence_4;
+	mutable VisitedMap<NodeStatus> visitedCoherence_5;
+	mutable VisitedMap<NodeStatus> visitedCoherence_6;
+	mutable VisitedMap<NodeStatus> visitedCoherence_7;
+	mutable VisitedMap<NodeStatus> visitedCoherence_8;
+	mutable VisitedMap<NodeStatus> visitedCoherence_9;
+	mutable VisitedMap<NodeStatus> visitedCoherence_10;
+	mutable VisitedMap<NodeStatus> visitedCoherence_11;
+	mutable VisitedMap<NodeStatus> visitedCoherence_12;
+	mutable VisitedMap<NodeStatus> visitedCoherence_13;
+	mutable VisitedMap<NodeStatus> visitedCoherence_14;
 
 	bool visitCoherence_0(const EventLabel *lab, const EventLabel *initLab) const;
 	bool visitCoherence_1(const EventLabel *lab, const EventLabel *initLab) const;
@@ -154,28 +155,28 @@ private:
 
 	bool visitCoherenceRelinche(const ExecutionGraph &g) const;
 
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_0;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_1;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_2;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_3;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_4;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_5;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_6;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_7;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_8;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_9;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_10;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_11;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_12;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_13;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_14;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_15;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_16;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_17;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_18;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_19;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_20;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_21;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_0;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_1;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_2;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_3;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_4;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_5;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_6;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_7;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_8;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_9;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_10;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_11;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_12;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_13;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_14;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_15;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_16;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_17;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_18;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_19;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_20;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_21;
 	mutable uint32_t visitedConsAcyclic1Accepting;
 
 	bool visitConsAcyclic1_0(const EventLabel *lab) const;
@@ -205,8 +206,8 @@ private:
 
 	bool visitConsAcyclic1Full(const ExecutionGraph &g) const;
 
-	mutable std::vector<NodeStatus> visitedLHSUnlessConsAcyclic1_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessConsAcyclic1_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessConsAcyclic1_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessConsAcyclic1_1;
 
 	bool visitLHSUnlessConsAcyclic1_0(const EventLabel *lab) const;
 	bool visitLHSUnlessConsAcyclic1_1(const EventLabel *lab) const;
@@ -218,26 +219,26 @@ private:
 	bool visitUnlessConsAcyclic1(const EventLabel *lab) const;
 	bool checkConsAcyclic1(const EventLabel *lab) const;
 	bool checkConsAcyclic1(const ExecutionGraph &g) const;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_0;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_1;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_2;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_3;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_4;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_5;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_6;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_7;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_8;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_9;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_10;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_11;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_12;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_13;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_14;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_15;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_16;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_17;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_18;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic2_19;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_0;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_1;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_2;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_3;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_4;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_5;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_6;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_7;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_8;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_9;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_10;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_11;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_12;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_13;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_14;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_15;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_16;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_17;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_18;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic2_19;
 	mutable uint32_t visitedConsAcyclic2Accepting;
 
 	bool visitConsAcyclic2_0(const EventLabel *lab) const;
@@ -269,8 +270,8 @@ private:
 	bool checkConsAcyclic2(const EventLabel *lab) const;
 	bool checkConsAcyclic2(const ExecutionGraph &g) const;
 	bool visitWarning3(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessWarning3_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessWarning3_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessWarning3_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessWarning3_1;
 
 	bool visitLHSUnlessWarning3_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessWarning3_1(const EventLabel *lab, const View &v) const;
@@ -290,14 +291,14 @@ private:
 
 	DepView calcPPoRfBefore(const EventLabel *lab) const;
 
-	mutable std::vector<NodeStatus> visitedPPoRf0;
-	mutable std::vector<NodeStatus> visitedPPoRf1;
-	mutable std::vector<NodeStatus> visitedPPoRf2;
-	mutable std::vector<NodeStatus> visitedPPoRf3;
-	mutable std::vector<NodeStatus> visitedPPoRf4;
-	mutable std::vector<NodeStatus> visitedPPoRf5;
-	mutable std::vector<NodeStatus> visitedPPoRf6;
-	mutable std::vector<NodeStatus> visitedPPoRf7;
+	mutable VisitedMap<NodeStatus> visitedPPoRf0;
+	mutable VisitedMap<NodeStatus> visitedPPoRf1;
+	mutable VisitedMap<NodeStatus> visitedPPoRf2;
+	mutable VisitedMap<NodeStatus> visitedPPoRf3;
+	mutable VisitedMap<NodeStatus> visitedPPoRf4;
+	mutable VisitedMap<NodeStatus> visitedPPoRf5;
+	mutable VisitedMap<NodeStatus> visitedPPoRf6;
+	mutable VisitedMap<NodeStatus> visitedPPoRf7;
 
 
 };
@@ -25,6 +25,7 @@
 #ifndef GENMC_RA_CHECKER_HPP
 #define GENMC_RA_CHECKER_HPP
 
+#include "ADT/VisitedMap.hpp"
 #include "ExecutionGraph/Consistency/ConsistencyChecker.hpp"
 #include "ExecutionGraph/EventLabel.hpp"
 #include <cstdint>
@@ -62,10 +63,10 @@ private:
 	void calculateViews(EventLabel *lab);
 	mutable const EventLabel *cexLab{};
 
-	mutable std::vector<NodeStatus> visitedCalc61_0;
-	mutable std::vector<NodeStatus> visitedCalc61_1;
-	mutable std::vector<NodeStatus> visitedCalc61_2;
-	mutable std::vector<NodeStatus> visitedCalc61_3;
+	mutable VisitedMap<NodeStatus> visitedCalc61_0;
+	mutable VisitedMap<NodeStatus> visitedCalc61_1;
+	mutable VisitedMap<NodeStatus> visitedCalc61_2;
+	mutable VisitedMap<NodeStatus> visitedCalc61_3;
 
 	bool visitCalc61_0(const EventLabel *lab, View &calcRes) const;
 	bool visitCalc61_1(const EventLabel *lab, View &calcRes) const;
@@ -76,14 +77,14 @@ private:
 	const View&getPorfStableView(const EventLabel *lab) const { return lab->view(0); }
 
 	auto checkCalc61(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedCalc67_0;
-	mutable std::vector<NodeStatus> visitedCalc67_1;
-	mutable std::vector<NodeStatus> visitedCalc67_2;
-	mutable std::vector<NodeStatus> visitedCalc67_3;
-	mutable std::vector<NodeStatus> visitedCalc67_4;
-	mutable std::vector<NodeStatus> visitedCalc67_5;
-	mutable std::vector<NodeStatus> visitedCalc67_6;
-	mutable std::vector<NodeStatus> visitedCalc67_7;
+	mutable VisitedMap<NodeStatus> visitedCalc67_0;
+	mutable VisitedMap<NodeStatus> visitedCalc67_1;
+	mutable VisitedMap<NodeStatus> visitedCalc67_2;
+	mutable VisitedMap<NodeStatus> visitedCalc67_3;
+	mutable VisitedMap<NodeStatus> visitedCalc67_4;
+	mutable VisitedMap<NodeStatus> visitedCalc67_5;
+	mutable VisitedMap<NodeStatus> visitedCalc67_6;
+	mutable VisitedMap<NodeStatus> visitedCalc67_7;
 
 	bool visitCalc67_0(const EventLabel *lab, View &calcRes) const;
 	bool visitCalc67_1(const EventLabel *lab, View &calcRes) const;
@@ -98,14 +99,14 @@ private:
 	const View&getHbStableView(const EventLabel *lab) const { return lab->view(1); }
 
 	auto checkCalc67(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedCalc69_0;
-	mutable std::vector<NodeStatus> visitedCalc69_1;
-	mutable std::vector<NodeStatus> visitedCalc69_2;
-	mutable std::vector<NodeStatus> visitedCalc69_3;
-	mutable std::vector<NodeStatus> visitedCalc69_4;
-	mutable std::vector<NodeStatus> visitedCalc69_5;
-	mutable std::vector<NodeStatus> visitedCalc69_6;
-	mutable std::vector<NodeStatus> visitedCalc69_7;
+	mutable VisitedMap<NodeStatus> visitedCalc69_0;
+	mutable VisitedMap<NodeStatus> visitedCalc69_1;
+	mutable VisitedMap<NodeStatus> visitedCalc69_2;
+	mutable VisitedMap<NodeStatus> visitedCalc69_3;
+	mutable VisitedMap<NodeStatus> visitedCalc69_4;
+	mutable VisitedMap<NodeStatus> visitedCalc69_5;
+	mutable VisitedMap<NodeStatus> visitedCalc69_6;
+	mutable VisitedMap<NodeStatus> visitedCalc69_7;
 
 	bool visitCalc69_0(const EventLabel *lab, View &calcRes) const;
 	bool visitCalc69_1(const EventLabel *lab, View &calcRes) const;
@@ -120,21 +121,21 @@ private:
 	const View&getHbRelincheView(const EventLabel *lab) const { return lab->view(2); }
 
 	auto checkCalc69(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedCoherence_0;
-	mutable std::vector<NodeStatus> visitedCoherence_1;
-	mutable std::vector<NodeStatus> visitedCoherence_2;
-	mutable std::vector<NodeStatus> visitedCoherence_3;
-	mutable std::vector<NodeStatus> visitedCoherence_4;
-	mutable std::vector<NodeStatus> visitedCoherence_5;
-	mutable std::vector<NodeStatus> visitedCoherence_6;
-	mutable std::vector<NodeStatus> visitedCoherence_7;
-	mutable std::vector<NodeStatus> visitedCoherence_8;
-	mutable std::vector<NodeStatus> visitedCoherence_9;
-	mutable std::vector<NodeStatus> visitedCoherence_10;
-	mutable std::vector<NodeStatus> visitedCoherence_11;
-	mutable std::vector<NodeStatus> visitedCoherence_12;
-	mutable std::vector<NodeStatus> visitedCoherence_13;
-	mutable std::vector<NodeStatus> visitedCoherence_14;
+	mutable VisitedMap<NodeStatus> visitedCoherence_0;
+	mutable VisitedMap<NodeStatus> visitedCoherence_1;
+	mutable VisitedMap<NodeStatus> visitedCoherence_2;
+	mutable VisitedMap<NodeStatus> visitedCoherence_3;
+	mutable VisitedMap<NodeStatus> visitedCoherence_4;
+	mutable VisitedMap<NodeStatus> visitedCoherence_5;
+	mutable VisitedMap<NodeStatus> visitedCoherence_6;
+	mutable VisitedMap<NodeStatus> visitedCoherence_7;
+	mutable VisitedMap<NodeStatus> visitedCoherence_8;
+	mutable VisitedMap<NodeStatus> visitedCoherence_9;
+	mutable VisitedMap<NodeStatus> visitedCoherence_10;
+	mutable VisitedMap<NodeStatus> visitedCoherence_11;
+	mutable VisitedMap<NodeStatus> visitedCoherence_12;
+	mutable VisitedMap<NodeStatus> visitedCoherence_13;
+	mutable VisitedMap<NodeStatus> visitedCoherence_14;
 
 	bool visitCoherence_0(const EventLabel *lab, const EventLabel *initLab) const;
 	bool visitCoherence_1(const EventLabel *lab, const EventLabel *initLab) const;
@@ -155,8 +156,8 @@ private:
 	bool visitCoherenceRelinche(const ExecutionGraph &g) const;
 
 	bool visitError1(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError1_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError1_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError1_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError1_1;
 
 	bool visitLHSUnlessError1_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessError1_1(const EventLabel *lab, const View &v) const;
@@ -165,8 +166,8 @@ private:
 	bool visitUnlessError1(const EventLabel *lab) const;
 	bool checkError1(const EventLabel *lab) const;
 	bool visitError2(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError2_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError2_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError2_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError2_1;
 
 	bool visitLHSUnlessError2_0(const EventLabel *lab) const;
 	bool visitLHSUnlessError2_1(const EventLabel *lab) const;
@@ -178,9 +179,9 @@ private:
 	bool visitUnlessError2(const EventLabel *lab) const;
 	bool checkError2(const EventLabel *lab) const;
 	bool visitError3(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError3_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError3_1;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError3_2;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError3_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError3_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError3_2;
 
 	bool visitLHSUnlessError3_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessError3_1(const EventLabel *lab, const View &v) const;
@@ -190,9 +191,9 @@ private:
 	bool visitUnlessError3(const EventLabel *lab) const;
 	bool checkError3(const EventLabel *lab) const;
 	bool visitError4(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError4_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError4_1;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError4_2;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError4_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError4_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError4_2;
 
 	bool visitLHSUnlessError4_0(const EventLabel *lab) const;
 	bool visitLHSUnlessError4_1(const EventLabel *lab) const;
@@ -205,9 +206,9 @@ private:
 	bool visitUnlessError4(const EventLabel *lab) const;
 	bool checkError4(const EventLabel *lab) const;
 	bool visitError5(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError5_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError5_1;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError5_2;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError5_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError5_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError5_2;
 
 	bool visitLHSUnlessError5_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessError5_1(const EventLabel *lab, const View &v) const;
@@ -217,9 +218,9 @@ private:
 	bool visitUnlessError5(const EventLabel *lab) const;
 	bool checkError5(const EventLabel *lab) const;
 	bool visitError6(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError6_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError6_1;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError6_2;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError6_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError6_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError6_2;
 
 	bool visitLHSUnlessError6_0(const EventLabel *lab) const;
 	bool visitLHSUnlessError6_1(const EventLabel *lab) const;
@@ -232,8 +233,8 @@ private:
 	bool visitUnlessError6(const EventLabel *lab) const;
 	bool checkError6(const EventLabel *lab) const;
 	bool visitError7(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError7_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError7_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError7_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError7_1;
 
 	bool visitLHSUnlessError7_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessError7_1(const EventLabel *lab, const View &v) const;
@@ -242,8 +243,8 @@ private:
 	bool visitUnlessError7(const EventLabel *lab) const;
 	bool checkError7(const EventLabel *lab) const;
 	bool visitWarning8(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessWarning8_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessWarning8_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessWarning8_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessWarning8_1;
 
 	bool visitLHSUnlessWarning8_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessWarning8_1(const EventLabel *lab, const View &v) const;
@@ -257,8 +258,8 @@ private:
 
 	View calcPPoRfBefore(const EventLabel *lab) const;
 
-	mutable std::vector<NodeStatus> visitedPPoRf0;
-	mutable std::vector<NodeStatus> visitedPPoRf1;
+	mutable VisitedMap<NodeStatus> visitedPPoRf0;
+	mutable VisitedMap<NodeStatus> visitedPPoRf1;
 
 
 };
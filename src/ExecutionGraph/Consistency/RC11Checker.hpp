@@ -25,6 +25,7 @@
 #ifndef GENMC_RC11_CHECKER_HPP
 #define GENMC_RC11_CHECKER_HPP
 
+#include "ADT/VisitedMap.hpp"
 #include "ExecutionGraph/Consistency/ConsistencyChecker.hpp"
 #include "ExecutionGraph/EventLabel.hpp"
 #include <cstdint>
@@ -62,10 +63,10 @@ private:
 	void calculateViews(EventLabel *lab);
 	mutable const EventLabel *cexLab{};
 
-	mutable std::vector<NodeStatus> visitedCalc63_0;
-	mutable std::vector<NodeStatus> visitedCalc63_1;
-	mutable std::vector<NodeStatus> visitedCalc63_2;
-	mutable std::vector<NodeStatus> visitedCalc63_3;
+	mutable VisitedMap<NodeStatus> visitedCalc63_0;
+	mutable VisitedMap<NodeStatus> visitedCalc63_1;
+	mutable VisitedMap<NodeStatus> visitedCalc63_2;
+	mutable VisitedMap<NodeStatus> visitedCalc63_3;
 
 	bool visitCalc63_0(const EventLabel *lab, View &calcRes) const;
 	bool visitCalc63_1(const EventLabel *lab, View &calcRes) const;
@@ -76,14 +77,14 @@ private:
 	const View&getPorfStableView(const EventLabel *lab) const { return lab->view(0); }
 
 	auto checkCalc63(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedCalc69_0;
-	mutable std::vector<NodeStatus> visitedCalc69_1;
-	mutable std::vector<NodeStatus> visitedCalc69_2;
-	mutable std::vector<NodeStatus> visitedCalc69_3;
-	mutable std::vector<NodeStatus> visitedCalc69_4;
-	mutable std::vector<NodeStatus> visitedCalc69_5;
-	mutable std::vector<NodeStatus> visitedCalc69_6;
-	mutable std::vector<NodeStatus> visitedCalc69_7;
+	mutable VisitedMap<NodeStatus> visitedCalc69_0;
+	mutable VisitedMap<NodeStatus> visitedCalc69_1;
+	mutable VisitedMap<NodeStatus> visitedCalc69_2;
+	mutable VisitedMap<NodeStatus> visitedCalc69_3;
+	mutable VisitedMap<NodeStatus> visitedCalc69_4;
+	mutable VisitedMap<NodeStatus> visitedCalc69_5;
+	mutable VisitedMap<NodeStatus> visitedCalc69_6;
+	mutable VisitedMap<NodeStatus> visitedCalc69_7;
 
 	bool visitCalc69_0(const EventLabel *lab, View &calcRes) const;
 	bool visitCalc69_1(const EventLabel *lab, View &calcRes) const;
@@ -98,14 +99,14 @@ private:
 	const View&getHbStableView(const EventLabel *lab) const { return lab->view(1); }
 
 	auto checkCalc69(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedCalc71_0;
-	mutable std::vector<NodeStatus> visitedCalc71_1;
-	mutable std::vector<NodeStatus> visitedCalc71_2;
-	mutable std::vector<NodeStatus> visitedCalc71_3;
-	mutable std::vector<NodeStatus> visitedCalc71_4;
-	mutable std::vector<NodeStatus> visitedCalc71_5;
-	mutable std::vector<NodeStatus> visitedCalc71_6;
-	mutable std::vector<NodeStatus> visitedCalc71_7;
+	mutable VisitedMap<NodeStatus> visitedCalc71_0;
+	mutable VisitedMap<NodeStatus> visitedCalc71_1;
+	mutable VisitedMap<NodeStatus> visitedCalc71_2;
+	mutable VisitedMap<NodeStatus> visitedCalc71_3;
+	mutable VisitedMap<NodeStatus> visitedCalc71_4;
+	mutable VisitedMap<NodeStatus> visitedCalc71_5;
+	mutable VisitedMap<NodeStatus> visitedCalc71_6;
+	mutable VisitedMap<NodeStatus> visitedCalc71_7;
 
 	bool visitCalc71_0(const EventLabel *lab, View &calcRes) const;
 	bool visitCalc71_1(const EventLabel *lab, View &calcRes) const;
@@ -120,21 +121,21 @@ private:
 	const View&getHbRelincheView(const EventLabel *lab) const { return lab->view(2); }
 
 	auto checkCalc71(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedCoherence_0;
-	mutable std::vector<NodeStatus> visitedCoherence_1;
-	mutable std::vector<NodeStatus> visitedCoherence_2;
-	mutable std::vector<NodeStatus> visitedCoherence_3;
-	mutable std::vector<NodeStatus> visitedCoherence_4;
-	mutable std::vector<NodeStatus> visitedCoherence_5;
-	mutable std::vector<NodeStatus> visitedCoherence_6;
-	mutable std::vector<NodeStatus> visitedCoherence_7;
-	mutable std::vector<NodeStatus> visitedCoherence_8;
-	mutable std::vector<NodeStatus> visitedCoherence_9;
-	mutable std::vector<NodeStatus> visitedCoherence_10;
-	mutable std::vector<NodeStatus> visitedCoherence_11;
-	mutable std::vector<NodeStatus> visitedCoherence_12;
-	mutable std::vector<NodeStatus> visitedCoherence_13;
-	mutable std::vector<NodeStatus> visitedCoherence_14;
+	mutable VisitedMap<NodeStatus> visitedCoherence_0;
+	mutable VisitedMap<NodeStatus> visitedCoherence_1;
+	mutable VisitedMap<NodeStatus> visitedCoherence_2;
+	mutable VisitedMap<NodeStatus> visitedCoherence_3;
+	mutable VisitedMap<NodeStatus> visitedCoherence_4;
+	mutable VisitedMap<NodeStatus> visitedCoherence_5;
+	mutable VisitedMap<NodeStatus> visitedCoherence_6;
+	mutable VisitedMap<NodeStatus> visitedCoherence_7;
+	mutable VisitedMap<NodeStatus> visitedCoherence_8;
+	mutable VisitedMap<NodeStatus> visitedCoherence_9;
+	mutable VisitedMap<NodeStatus> visitedCoherence_10;
+	mutable VisitedMap<NodeStatus> visitedCoherence_11;
+	mutable VisitedMap<NodeStatus> visitedCoherence_12;
+	mutable VisitedMap<NodeStatus> visitedCoherence_13;
+	mutable VisitedMap<NodeStatus> visitedCoherence_14;
 
 	bool visitCoherence_0(const EventLabel *lab, const EventLabel *initLab) const;
 	bool visitCoherence_1(const EventLabel *lab, const EventLabel *initLab) const;
@@ -154,28 +155,28 @@ private:
 
 	bool visitCoherenceRelinche(const ExecutionGraph &g) const;
 
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_0;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_1;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_2;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_3;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_4;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_5;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_6;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_7;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_8;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_9;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_10;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_11;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_12;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_13;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_14;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_15;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_16;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_17;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_18;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_19;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_20;
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_21;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_0;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_1;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_2;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_3;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_4;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_5;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_6;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_7;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_8;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_9;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_10;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_11;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_12;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_13;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_14;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_15;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_16;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_17;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_18;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_19;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_20;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_21;
 	mutable uint32_t visitedConsAcyclic1Accepting;
 
 	bool visitConsAcyclic1_0(const EventLabel *lab) const;
@@ -205,8 +206,8 @@ private:
 
 	bool visitConsAcyclic1Full(const ExecutionGraph &g) const;
 
-	mutable std::vector<NodeStatus> visitedLHSUnlessConsAcyclic1_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessConsAcyclic1_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessConsAcyclic1_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessConsAcyclic1_1;
 
 	bool visitLHSUnlessConsAcyclic1_0(const EventLabel *lab) const;
 	bool visitLHSUnlessConsAcyclic1_1(const EventLabel *lab) const;
@@ -219,8 +220,8 @@ private:
 	bool checkConsAcyclic1(const EventLabel *lab) const;
 	bool checkConsAcyclic1(const ExecutionGraph &g) const;
 	bool visitError2(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError2_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError2_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError2_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError2_1;
 
 	bool visitLHSUnlessError2_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessError2_1(const EventLabel *lab, const View &v) const;
@@ -229,8 +230,8 @@ private:
 	bool visitUnlessError2(const EventLabel *lab) const;
 	bool checkError2(const EventLabel *lab) const;
 	bool visitError3(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError3_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError3_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError3_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError3_1;
 
 	bool visitLHSUnlessError3_0(const EventLabel *lab) const;
 	bool visitLHSUnlessError3_1(const EventLabel *lab) const;
@@ -242,9 +243,9 @@ private:
 	bool visitUnlessError3(const EventLabel *lab) const;
 	bool checkError3(const EventLabel *lab) const;
 	bool visitError4(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError4_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError4_1;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError4_2;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError4_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError4_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError4_2;
 
 	bool visitLHSUnlessError4_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessError4_1(const EventLabel *lab, const View &v) const;
@@ -254,9 +255,9 @@ private:
 	bool visitUnlessError4(const EventLabel *lab) const;
 	bool checkError4(const EventLabel *lab) const;
 	bool visitError5(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError5_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError5_1;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError5_2;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError5_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError5_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError5_2;
 
 	bool visitLHSUnlessError5_0(const EventLabel *lab) const;
 	bool visitLHSUnlessError5_1(const EventLabel *lab) const;
@@ -269,9 +270,9 @@ private:
 	bool visitUnlessError5(const EventLabel *lab) const;
 	bool checkError5(const EventLabel *lab) const;
 	bool visitError6(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError6_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError6_1;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError6_2;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError6_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError6_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError6_2;
 
 	bool visitLHSUnlessError6_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessError6_1(const EventLabel *lab, const View &v) const;
@@ -281,9 +282,9 @@ private:
 	bool visitUnlessError6(const EventLabel *lab) const;
 	bool checkError6(const EventLabel *lab) const;
 	bool visitError7(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError7_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError7_1;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError7_2;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError7_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError7_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError7_2;
 
 	bool visitLHSUnlessError7_0(const EventLabel *lab) const;
 	bool visitLHSUnlessError7_1(const EventLabel *lab) const;
@@ -296,8 +297,8 @@ private:
 	bool visitUnlessError7(const EventLabel *lab) const;
 	bool checkError7(const EventLabel *lab) const;
 	bool visitError8(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError8_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError8_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError8_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError8_1;
 
 	bool visitLHSUnlessError8_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessError8_1(const EventLabel *lab, const View &v) const;
@@ -306,8 +307,8 @@ private:
 	bool visitUnlessError8(const EventLabel *lab) const;
 	bool checkError8(const EventLabel *lab) const;
 	bool visitWarning9(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessWarning9_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessWarning9_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessWarning9_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessWarning9_1;
 
 	bool visitLHSUnlessWarning9_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessWarning9_1(const EventLabel *lab, const View &v) const;
@@ -321,8 +322,8 @@ private:
 
 	View calcPPoRfBefore(const EventLabel *lab) const;
 
-	mutable std::vector<NodeStatus> visitedPPoRf0;
-	mutable std::vector<NodeStatus> visitedPPoRf1;
+	mutable VisitedMap<NodeStatus> visitedPPoRf0;
+	mutable VisitedMap<NodeStatus> visitedPPoRf1;
 
 
 };
@@ -23,6 +23,10 @@
 #include "ExecutionGraph/ExecutionGraph.hpp"
 #include "ExecutionGraph/GraphIterators.hpp"
 
+#include <algorithm>
+#include <ranges>
+#include <vector>
+
 auto areSCPredsInView(const ExecutionGraph &g, const View &v, Event e) -> bool
 {
 	auto *lab = g.getEventLabel(e);
@@ -48,14 +52,52 @@ auto areSCPredsInView(const ExecutionGraph &g, const View &v, Event e) -> bool
 			    [&](const auto &rLab) { return !v.contains(rLab.getPos()); });
 }
 
-auto RoundBoundDecider::doesExecutionExceedBound(unsigned int bound) const -> bool
+/* Returns the round in which LAB is scheduled given the rounds of its
+ * SC-predecessors (see areSCPredsInView()), or std::nullopt if the round
+ * of some predecessor is unknown */
+static auto calcRound(const ExecutionGraph &g, const EventLabel *lab) -> std::optional<unsigned>
 {
+	/* First events are considered scheduled from the start */
+	if (lab->getIndex() == 0)
+		return 0;
+
+	auto round = g.getEventLabel(lab->getPos().prev())->getRound();
+	auto addPred = [&](const EventLabel *pLab) {
+		if (!round || pLab->getIndex() == 0)
+			return;
+		auto pRound = pLab->getRound();
+		if (!pRound) {
+			round = std::nullopt;
+			return;
+		}
+		/* Threads after LAB's in the round-robin order only run later in the round */
+		round = std::max(*round, *pRound + (pLab->getThread() > lab->getThread() ? 1 : 0));
+	};
+
+	if (llvm::isa<ThreadJoinLabel>(lab)) {
+		addPred(tj_pred(g, lab));
+	} else if (auto *rLab = llvm::dyn_cast<ReadLabel>(lab)) {
+		BUG_ON(!rLab->getRf());
+		addPred(rLab->getRf());
+	} else if (auto *wLab = llvm::dyn_cast<WriteLabel>(lab)) {
+		if (auto *pLab = g.co_imm_pred(wLab))
+			addPred(pLab);
+		std::for_each(g.fr_imm_pred_begin(wLab), g.fr_imm_pred_end(wLab),
+			      [&](auto &rLab) { addPred(&rLab); });
+	}
+	return round;
+}
 
+void RoundBoundDecider::recalculateRounds() const
+{
 	auto &g = getGraph();
 	const auto full = *llvm::dyn_cast<View>(g.getViewFromStamp(g.getMaxStamp()).get());
 	View curr;
 
-	do {
+	for (auto i = 0U; i < g.getNumThreads(); i++)
+		g.getEventLabel(Event(i, 0))->setRound(0);
+
+	for (auto round = 0U;; round++) {
 		auto exists = false;
 		auto done = true;
 		for (auto i = 0U; i < g.getNumThreads(); i++) {
@@ -67,42 +109,102 @@ auto RoundBoundDecider::doesExecutionExceedBound(unsigned int bound) const -> bo
 				}
 				exists = true;
 				curr.updateIdx(next);
+				g.getEventLabel(next)->setRound(round);
 			}
 		}
-		BUG_ON(!exists);
 		if (done)
-			return false;
-	} while (bound--);
-	return true;
+			return;
+		BUG_ON(!exists);
+	}
 }
 
-#ifdef ENABLE_GENMC_DEBUG
-auto RoundBoundDecider::calculate() const -> unsigned
+auto RoundBoundDecider::calculateNewRounds() const -> bool
 {
 	auto &g = getGraph();
-	const auto full = *llvm::dyn_cast<View>(g.getViewFromStamp(g.getMaxStamp()).get());
-	View curr;
-	unsigned bound = 0;
 
-	while (true) {
-		auto exists = false;
-		auto done = true;
-		for (auto i = 0U; i < g.getNumThreads(); i++) {
-			for (auto j = curr.getMax(i); j < full.getMax(i); j++) {
-				auto next = Event(i, j + 1);
-				if (!areSCPredsInView(g, curr, next)) {
-					done = false;
-					break;
-				}
-				exists = true;
-				curr.updateIdx(next);
+	/* Labels without a round are either new (at the back of the insertion
+	 * order), or had an SC-predecessor removed or changed */
+	std::vector<const EventLabel *> pending;
+	for (const auto &lab : g.labels() | std::views::reverse) {
+		if (lab.getRound())
+			break;
+		pending.push_back(&lab);
+	}
+	std::ranges::reverse(pending);
+	for (const auto &e : g.takeStaleRounds()) {
+		if (g.containsPos(e) && !g.getEventLabel(e)->getRound())
+			pending.push_back(g.getEventLabel(e));
+	}
+
+	/* New labels can only delay existing ones (e.g., a new read
+	 * can delay the write it is fr-before); propagate such delays.
+	 * Rounds cannot exceed the number of events in acyclic graphs */
+	auto maxRound = 0U;
+	for (auto i = 0U; i < g.getNumThreads(); i++)
+		maxRound += g.getThreadSize(i);
+
+	std::vector<const EventLabel *> worklist;
+	auto pushSuccs = [&](const EventLabel *lab) {
+		g.forEachSCSucc(lab, [&](auto *sLab) {
+			if (sLab->getRound())
+				worklist.push_back(sLab);
+		});
+	};
+	while (!pending.empty()) {
+		/* A label's round is calculated after the rounds of its predecessors */
+		auto progress = false;
+		std::vector<const EventLabel *> deferred;
+		for (const auto *lab : pending) {
+			if (lab->getRound())
+				continue;
+			auto round = calcRound(g, lab);
+			if (!round) {
+				deferred.push_back(lab);
+				continue;
+			}
+			progress = true;
+			lab->setRound(*round);
+			pushSuccs(lab);
+
+			while (!worklist.empty()) {
+				const auto *sLab = worklist.back();
+				worklist.pop_back();
+
+				/* Labels with pending predecessors are updated once these are */
+				auto sRound = calcRound(g, sLab);
+				if (!sRound || *sRound <= *sLab->getRound())
+					continue;
+				if (*sRound > maxRound)
+					return false;
+				sLab->setRound(*sRound);
+				pushSuccs(sLab);
 			}
 		}
-		if (done)
-			break;
-		BUG_ON(!exists);
-		bound++;
+		if (!progress && !deferred.empty())
+			return false;
+		pending = std::move(deferred);
 	}
-	return bound;
+	return true;
+}
+
+auto RoundBoundDecider::updateRounds() const -> unsigned
+{
+	auto &g = getGraph();
+	if (!calculateNewRounds())
+		recalculateRounds();
+
+	/* Rounds are monotone in po */
+	auto max = 0U;
+	for (auto i = 0U; i < g.getNumThreads(); i++)
+		max = std::max(max, *g.getLastThreadLabel(i)->getRound());
+	return max;
 }
+
+auto RoundBoundDecider::doesExecutionExceedBound(unsigned int bound) const -> bool
+{
+	return updateRounds() > bound;
+}
+
+#ifdef ENABLE_GENMC_DEBUG
+auto RoundBoundDecider::calculate() const -> unsigned { return updateRounds(); }
 #endif
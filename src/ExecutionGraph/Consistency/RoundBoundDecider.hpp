@@ -24,7 +24,15 @@
 #include "BoundDecider.hpp"
 #include "ExecutionGraph/Event.hpp"
 
-/** Bound the number of round-robin scheduling rounds */
+/**
+ * Bound the number of round-robin scheduling rounds.
+ *
+ * The round in which each label is scheduled is stored in the label, and is
+ * maintained incrementally as labels are added to the graph. When labels are
+ * removed or their rf/co change, the graph only invalidates the rounds of the
+ * labels SC-after them (see ExecutionGraph::invalidateRounds()); these are
+ * calculated again from the rounds of the surviving labels.
+ */
 class RoundBoundDecider : public BoundDecider {
 
 public:
@@ -35,6 +43,16 @@ private:
 #ifdef ENABLE_GENMC_DEBUG
 	[[nodiscard]] auto calculate() const -> unsigned override;
 #endif
+
+	/** Brings the rounds of all labels up to date, and returns the maximum one */
+	auto updateRounds() const -> unsigned;
+
+	/** Calculates the rounds of all labels from scratch */
+	void recalculateRounds() const;
+
+	/** Calculates the rounds of the labels added or invalidated since the
+	 * last update. Returns false if that cannot be done incrementally */
+	auto calculateNewRounds() const -> bool;
 };
 
 #endif /* GENMC_ROUND_BOUND_DECIDER_HPP */
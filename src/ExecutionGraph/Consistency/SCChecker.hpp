@@ -25,6 +25,7 @@
 #ifndef GENMC_SC_CHECKER_HPP
 #define GENMC_SC_CHECKER_HPP
 
+#include "ADT/VisitedMap.hpp"
 #include "ExecutionGraph/Consistency/ConsistencyChecker.hpp"
 #include "ExecutionGraph/EventLabel.hpp"
 #include <cstdint>
@@ -62,10 +63,10 @@ private:
 	void calculateViews(EventLabel *lab);
 	mutable const EventLabel *cexLab{};
 
-	mutable std::vector<NodeStatus> visitedCalc62_0;
-	mutable std::vector<NodeStatus> visitedCalc62_1;
-	mutable std::vector<NodeStatus> visitedCalc62_2;
-	mutable std::vector<NodeStatus> visitedCalc62_3;
+	mutable VisitedMap<NodeStatus> visitedCalc62_0;
+	mutable VisitedMap<NodeStatus> visitedCalc62_1;
+	mutable VisitedMap<NodeStatus> visitedCalc62_2;
+	mutable VisitedMap<NodeStatus> visitedCalc62_3;
 
 	bool visitCalc62_0(const EventLabel *lab, View &calcRes) const;
 	bool visitCalc62_1(const EventLabel *lab, View &calcRes) const;
@@ -76,10 +77,10 @@ private:
 	const View&getPorfStableView(const EventLabel *lab) const { return lab->view(0); }
 
 	auto checkCalc62(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedCalc63_0;
-	mutable std::vector<NodeStatus> visitedCalc63_1;
-	mutable std::vector<NodeStatus> visitedCalc63_2;
-	mutable std::vector<NodeStatus> visitedCalc63_3;
+	mutable VisitedMap<NodeStatus> visitedCalc63_0;
+	mutable VisitedMap<NodeStatus> visitedCalc63_1;
+	mutable VisitedMap<NodeStatus> visitedCalc63_2;
+	mutable VisitedMap<NodeStatus> visitedCalc63_3;
 
 	bool visitCalc63_0(const EventLabel *lab, View &calcRes) const;
 	bool visitCalc63_1(const EventLabel *lab, View &calcRes) const;
@@ -90,11 +91,11 @@ private:
 	const View&getHbStableView(const EventLabel *lab) const { return lab->view(1); }
 
 	auto checkCalc63(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedCalc64_0;
-	mutable std::vector<NodeStatus> visitedCalc64_1;
-	mutable std::vector<NodeStatus> visitedCalc64_2;
-	mutable std::vector<NodeStatus> visitedCalc64_3;
-	mutable std::vector<NodeStatus> visitedCalc64_4;
+	mutable VisitedMap<NodeStatus> visitedCalc64_0;
+	mutable VisitedMap<NodeStatus> visitedCalc64_1;
+	mutable VisitedMap<NodeStatus> visitedCalc64_2;
+	mutable VisitedMap<NodeStatus> visitedCalc64_3;
+	mutable VisitedMap<NodeStatus> visitedCalc64_4;
 
 	bool visitCalc64_0(const EventLabel *lab, View &calcRes) const;
 	bool visitCalc64_1(const EventLabel *lab, View &calcRes) const;
@@ -106,13 +107,13 @@ private:
 	const View&getHbRelincheView(const EventLabel *lab) const { return lab->view(2); }
 
 	auto checkCalc64(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedCoherence_0;
-	mutable std::vector<NodeStatus> visitedCoherence_1;
-	mutable std::vector<NodeStatus> visitedCoherence_2;
-	mutable std::vector<NodeStatus> visitedCoherence_3;
-	mutable std::vector<NodeStatus> visitedCoherence_4;
-	mutable std::vector<NodeStatus> visitedCoherence_5;
-	mutable std::vector<NodeStatus> visitedCoherence_6;
+	mutable VisitedMap<NodeStatus> visitedCoherence_0;
+	mutable VisitedMap<NodeStatus> visitedCoherence_1;
+	mutable VisitedMap<NodeStatus> visitedCoherence_2;
+	mutable VisitedMap<NodeStatus> visitedCoherence_3;
+	mutable VisitedMap<NodeStatus> visitedCoherence_4;
+	mutable VisitedMap<NodeStatus> visitedCoherence_5;
+	mutable VisitedMap<NodeStatus> visitedCoherence_6;
 
 	bool visitCoherence_0(const EventLabel *lab, const EventLabel *initLab) const;
 	bool visitCoherence_1(const EventLabel *lab, const EventLabel *initLab) const;
@@ -124,7 +125,7 @@ private:
 
 	bool visitCoherenceRelinche(const ExecutionGraph &g) const;
 
-	mutable std::vector<NodeVisitStatus> visitedConsAcyclic1_0;
+	mutable VisitedMap<NodeVisitStatus> visitedConsAcyclic1_0;
 	mutable uint32_t visitedConsAcyclic1Accepting;
 
 	bool visitConsAcyclic1_0(const EventLabel *lab) const;
@@ -137,8 +138,8 @@ private:
 	bool checkConsAcyclic1(const EventLabel *lab) const;
 	bool checkConsAcyclic1(const ExecutionGraph &g) const;
 	bool visitError2(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError2_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError2_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError2_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError2_1;
 
 	bool visitLHSUnlessError2_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessError2_1(const EventLabel *lab, const View &v) const;
@@ -147,8 +148,8 @@ private:
 	bool visitUnlessError2(const EventLabel *lab) const;
 	bool checkError2(const EventLabel *lab) const;
 	bool visitError3(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError3_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError3_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError3_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError3_1;
 
 	bool visitLHSUnlessError3_0(const EventLabel *lab) const;
 	bool visitLHSUnlessError3_1(const EventLabel *lab) const;
@@ -160,9 +161,9 @@ private:
 	bool visitUnlessError3(const EventLabel *lab) const;
 	bool checkError3(const EventLabel *lab) const;
 	bool visitError4(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError4_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError4_1;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError4_2;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError4_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError4_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError4_2;
 
 	bool visitLHSUnlessError4_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessError4_1(const EventLabel *lab, const View &v) const;
@@ -172,9 +173,9 @@ private:
 	bool visitUnlessError4(const EventLabel *lab) const;
 	bool checkError4(const EventLabel *lab) const;
 	bool visitError5(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError5_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError5_1;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError5_2;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError5_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError5_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError5_2;
 
 	bool visitLHSUnlessError5_0(const EventLabel *lab) const;
 	bool visitLHSUnlessError5_1(const EventLabel *lab) const;
@@ -187,9 +188,9 @@ private:
 	bool visitUnlessError5(const EventLabel *lab) const;
 	bool checkError5(const EventLabel *lab) const;
 	bool visitError6(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError6_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError6_1;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError6_2;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError6_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError6_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError6_2;
 
 	bool visitLHSUnlessError6_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessError6_1(const EventLabel *lab, const View &v) const;
@@ -199,9 +200,9 @@ private:
 	bool visitUnlessError6(const EventLabel *lab) const;
 	bool checkError6(const EventLabel *lab) const;
 	bool visitError7(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError7_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError7_1;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError7_2;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError7_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError7_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError7_2;
 
 	bool visitLHSUnlessError7_0(const EventLabel *lab) const;
 	bool visitLHSUnlessError7_1(const EventLabel *lab) const;
@@ -214,8 +215,8 @@ private:
 	bool visitUnlessError7(const EventLabel *lab) const;
 	bool checkError7(const EventLabel *lab) const;
 	bool visitError8(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError8_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessError8_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError8_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessError8_1;
 
 	bool visitLHSUnlessError8_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessError8_1(const EventLabel *lab, const View &v) const;
@@ -224,8 +225,8 @@ private:
 	bool visitUnlessError8(const EventLabel *lab) const;
 	bool checkError8(const EventLabel *lab) const;
 	bool visitWarning9(const EventLabel *lab) const;
-	mutable std::vector<NodeStatus> visitedLHSUnlessWarning9_0;
-	mutable std::vector<NodeStatus> visitedLHSUnlessWarning9_1;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessWarning9_0;
+	mutable VisitedMap<NodeStatus> visitedLHSUnlessWarning9_1;
 
 	bool visitLHSUnlessWarning9_0(const EventLabel *lab, const View &v) const;
 	bool visitLHSUnlessWarning9_1(const EventLabel *lab, const View &v) const;
@@ -239,8 +240,8 @@ private:
 
 	View calcPPoRfBefore(const EventLabel *lab) const;
 
-	mutable std::vector<NodeStatus> visitedPPoRf0;
-	mutable std::vector<NodeStatus> visitedPPoRf1;
+	mutable VisitedMap<NodeStatus> visitedPPoRf0;
+	mutable VisitedMap<NodeStatus> visitedPPoRf1;
 
 
 };
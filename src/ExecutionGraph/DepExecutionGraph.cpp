@@ -25,8 +25,15 @@ std::unique_ptr<VectorClock> DepExecutionGraph::getViewFromStamp(Stamp stamp) co
 {
 	auto preds = std::make_unique<DepView>();
 
+	/* Events before the stamp window are all included, and the ones after it are not */
 	for (auto i = 0u; i < getNumThreads(); i++) {
-		for (auto j = 1u; j < getThreadSize(i); j++) {
+		auto [lo, hi] = getStampWindow(i, stamp);
+		auto j = 1;
+		if (lo > 1) {
+			preds->setMaxNoHoles(Event(i, lo - 1));
+			j = lo;
+		}
+		for (; j < hi; j++) {
 			const EventLabel *lab = getEventLabel(Event(i, j));
 			if (lab->getStamp() <= stamp)
 				preds->setMax(Event(i, j));
@@ -129,6 +136,9 @@ void DepExecutionGraph::cutToStamp(Stamp stamp)
 			poLists[i].insert(it, *getEventLabel(Event(i, j)));
 		}
 	}
+	recalcFingerprint();
+	recalcLocReads();
+	recalcStampBounds();
 }
 
 std::unique_ptr<ExecutionGraph> DepExecutionGraph::getCopyUpTo(const VectorClock &v) const
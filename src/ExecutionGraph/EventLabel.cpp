@@ -39,6 +39,34 @@ SVal EventLabel::getAccessValue(const AAccess &access) const
 	return wLab->getVal();
 }
 
+void EventLabel::toggleOrderFingerprint()
+{
+	/* Labels only contribute once they are part of the graph */
+	if (getParent() && getParent()->hasFingerprints() && getParent()->containsLab(this))
+		getParent()->toggleOrderFingerprint(*this);
+}
+
+void EventLabel::setRevisitStatus(bool status)
+{
+	toggleOrderFingerprint();
+	revisitable = status;
+	toggleOrderFingerprint();
+}
+
+void MemAccessLabel::setAddedMax(bool status)
+{
+	toggleOrderFingerprint();
+	maximal = status;
+	toggleOrderFingerprint();
+}
+
+void ReadLabel::setIPRStatus(bool status)
+{
+	toggleOrderFingerprint();
+	ipr = status;
+	toggleOrderFingerprint();
+}
+
 SVal EventLabel::getReturnValue() const
 {
 	if (auto *rLab = llvm::dyn_cast<ReadLabel>(this)) {
@@ -167,7 +195,17 @@ void ReadLabel::setRf(EventLabel *rfLab)
 {
 	/* Remember old rf before setting */
 	auto *oldRfLab = getRf();
+	/* The read's rf and the write it is fr-before change */
+	auto hadRound = getRound().has_value() && getParent();
+	if (hadRound)
+		getParent()->invalidateRounds(this);
+	if (getParent())
+		getParent()->toggleFingerprint(*this);
 	setRfNoCascade(rfLab);
+	if (getParent())
+		getParent()->toggleFingerprint(*this);
+	if (hadRound)
+		getParent()->invalidateRounds(this);
 
 	/*
 	 * Delete the read from the readers list of oldRf.
@@ -201,15 +239,41 @@ void WriteLabel::addCo(EventLabel *predLab)
 {
 	auto &g = *getParent();
 	auto *predLabW = llvm::dyn_cast<WriteLabel>(predLab);
-	g.coherence[getAddr()].insert(
-		predLabW ? ++ExecutionGraph::co_iterator(*predLabW) : g.co_begin(getAddr()), *this);
+	auto it = predLabW ? ++ExecutionGraph::co_iterator(*predLabW) : g.co_begin(getAddr());
+
+	/* The co-successor (if any) changes its co-predecessor */
+	auto *succLab = it == g.co_end(getAddr()) ? nullptr : &*it;
+	if (succLab)
+		g.toggleCoFingerprint(*succLab);
+	g.coherence[getAddr()].insert(it, *this);
+	g.toggleCoFingerprint(*this);
+	if (succLab)
+		g.toggleCoFingerprint(*succLab);
+
+	/* The co-successor loses its co- and fr-predecessors to this label */
+	if (getRound())
+		g.invalidateRounds(this);
+	else if (succLab && succLab->getRound())
+		g.invalidateRounds(succLab);
 }
 
 void WriteLabel::moveCo(EventLabel *predLab)
 {
 	auto &g = *getParent();
+	/* Invalidate the rounds around both the old and the new place in co */
+	auto hadRound = getRound().has_value();
+	if (hadRound)
+		g.invalidateRounds(this);
+	const auto *succLab = g.hasFingerprints() ? g.co_imm_succ(this) : nullptr;
+	g.toggleCoFingerprint(*this);
+	if (succLab)
+		g.toggleCoFingerprint(*succLab);
 	g.coherence[getAddr()].remove(*this);
+	if (succLab)
+		g.toggleCoFingerprint(*succLab);
 	addCo(predLab);
+	if (hadRound)
+		g.invalidateRounds(this);
 }
 
 llvm::raw_ostream &operator<<(llvm::raw_ostream &s, const EventLabel::EventLabelKind k)
@@ -21,6 +21,7 @@
 #ifndef GENMC_EVENTLABEL_HPP
 #define GENMC_EVENTLABEL_HPP
 
+#include "ADT/SlabAllocator.hpp"
 #include "ADT/VSet.hpp"
 #include "ADT/View.hpp"
 #include "ADT/value_ptr.hpp"
@@ -97,6 +98,10 @@ protected:
 		: kind(k), position(p), ordering(o), deps(deps)
 	{}
 
+	/** Adds (or removes) this label's status to its graph's order fingerprint.
+	 * Must be called before and after each status change */
+	void toggleOrderFingerprint();
+
 	using const_dep_iterator = DepInfo::const_iterator;
 	using const_dep_range = llvm::iterator_range<const_dep_iterator>;
 
@@ -106,6 +111,19 @@ protected:
 public:
 	virtual ~EventLabel() = default;
 
+	/* Labels are allocated and freed in bulk (graph copies, cuts, restrictions),
+	 * so they are served from a thread-local slab allocator */
+	static void *operator new(std::size_t size) { return SlabAllocator::local().allocate(size); }
+	static void operator delete(void *p, std::size_t size)
+	{
+		SlabAllocator::local().deallocate(p, size);
+	}
+
+	/** Saved calculations and views are (re)computed for each label added,
+	 * so their storage comes from the same allocator as the label */
+	using CalcRels = std::vector<VSet<Event>, SlabStlAllocator<VSet<Event>>>;
+	using CalcViews = std::vector<View, SlabStlAllocator<View>>;
+
 	/** Iterators for dependencies */
 	const_dep_iterator data_begin() const { return deps.data.begin(); }
 	const_dep_iterator data_end() const { return deps.data.end(); }
@@ -171,9 +189,14 @@ public:
 	VectorClock &getPrefixView() { return *prefixView; }
 	void setPrefixView(std::unique_ptr<VectorClock> v) const { prefixView = std::move(v); }
 
-	void setCalculated(std::vector<VSet<Event>> &&calc) { calculatedRels = std::move(calc); }
+	/** Returns the scheduling round of this label, if it has been calculated
+	 * (see RoundBoundDecider) */
+	std::optional<unsigned> getRound() const { return round; }
+	void setRound(std::optional<unsigned> r) const { round = r; }
+
+	void setCalculated(CalcRels &&calc) { calculatedRels = std::move(calc); }
 
-	void setViews(std::vector<View> &&views) { calculatedViews = std::move(views); }
+	void setViews(CalcViews &&views) { calculatedViews = std::move(views); }
 	void addView(View &&view) { calculatedViews.emplace_back(view); }
 
 	/** Iterators for calculated relations */
@@ -232,7 +255,7 @@ public:
 
 	/** Makes the relevant event revisitable/non-revisitable. The
 	 * execution graph is responsible for making such changes */
-	void setRevisitStatus(bool status) { revisitable = status; }
+	void setRevisitStatus(bool status);
 
 	/** Returns true if this event cannot be revisited or deleted */
 	bool isStable() const;
@@ -251,6 +274,7 @@ public:
 		calculatedRels.clear();
 		calculatedViews.clear();
 		prefixView = nullptr;
+		round = std::nullopt;
 		revisitable = true;
 	}
 
@@ -287,10 +311,13 @@ private:
 	mutable value_ptr<VectorClock, VectorClockCloner> prefixView = nullptr;
 
 	/** Saved calculations */
-	std::vector<VSet<Event>> calculatedRels;
+	CalcRels calculatedRels;
 
 	/** Saved views */
-	std::vector<View> calculatedViews;
+	CalcViews calculatedViews;
+
+	/** Scheduling round (maintained incrementally by the bound decider) */
+	mutable std::optional<unsigned> round = std::nullopt;
 
 	/** Revisitability status */
 	bool revisitable = true;
@@ -634,7 +661,7 @@ public:
 
 	/** Helper flag for maximality checks */
 	bool wasAddedMax() const { return maximal; }
-	void setAddedMax(bool status) { maximal = status; }
+	void setAddedMax(bool status);
 
 	/** Getter for allocating event */
 	MallocLabel *getAlloc() const { return allocLab; }
@@ -739,7 +766,7 @@ public:
 	bool valueMakesAssumeSucceed(const SVal &val) const;
 
 	/** Sets the IPR status for this read */
-	void setIPRStatus(bool status) { ipr = status; }
+	void setIPRStatus(bool status);
 
 	/** Helper: Whether this is a confirmation read */
 	bool isConfirming() const { return isConfirming(getKind()); }
@@ -19,6 +19,7 @@
  */
 
 #include "ExecutionGraph.hpp"
+#include "ExecutionGraph/GraphIterators.hpp"
 #include <llvm/IR/DebugInfo.h>
 
 #include <memory>
@@ -39,29 +40,47 @@ auto ExecutionGraph::addLabelToGraph(std::unique_ptr<EventLabel> lab) -> EventLa
 	if (!lab->hasStamp())
 		lab->setStamp(nextStamp());
 
+	/* Rounds are calculated per graph (cloned labels may carry stale ones) */
+	lab->setRound(std::nullopt);
+
 	/* Track coherence if necessary */
 	if (auto *mLab = llvm::dyn_cast<MemAccessLabel>(&*lab))
 		trackCoherenceAtLoc(mLab->getAddr());
 
+	/* Index reads by location (stamps mostly increase, so this usually appends) */
+	if (auto *rLab = llvm::dyn_cast<ReadLabel>(&*lab)) {
+		auto &reads = locReads[rLab->getAddr()];
+		auto it = std::upper_bound(reads.begin(), reads.end(), rLab->getStamp(),
+					   [](auto s, auto *oLab) { return s < oLab->getStamp(); });
+		reads.insert(it, rLab);
+	}
+
 	auto pos = lab->getPos();
 	auto *lastLab = getLastThreadLabel(pos.thread);
 	if (lastLab && pos.index < lastLab->getIndex()) {
 		auto eLab = getEventLabel(pos);
 		BUG_ON(eLab && !llvm::isa<EmptyLabel>(eLab));
 		auto &oldLab = *events[pos.thread][pos.index];
+		if (oldLab.getRound())
+			invalidateRounds(&oldLab);
+		toggleFingerprint(oldLab);
 		auto it = poLists[pos.thread].erase(po_iterator(oldLab));
-		insertionOrder.remove(oldLab);
+		removeFromInsertionOrder(oldLab);
 		events[pos.thread][pos.index] = std::move(lab);
 		auto &newLab = *events[pos.thread][pos.index];
-		insertionOrder.push_back(newLab);
+		appendToInsertionOrder(newLab);
 		poLists[pos.thread].insert(it, newLab);
+		toggleFingerprint(newLab);
+		updateStampBounds(pos.thread, pos.index);
 		BUG_ON(pos.index > events[pos.thread].size());
 		return &newLab;
 	}
 	events[pos.thread].push_back(std::move(lab));
 	auto &newLab = *events[pos.thread].back();
-	insertionOrder.push_back(newLab);
+	appendToInsertionOrder(newLab);
 	poLists[pos.thread].push_back(newLab);
+	toggleFingerprint(newLab);
+	updateStampBounds(pos.thread, events[pos.thread].size() - 1);
 	return &newLab;
 }
 
@@ -71,6 +90,170 @@ void ExecutionGraph::trackCoherenceAtLoc(SAddr addr)
 	getInitLabel()->initRfs.emplace(addr, CopyableIList<ReadLabel>());
 }
 
+/************************************************************
+ ** Fingerprinting
+ ***********************************************************/
+
+static auto hashEvent(Event e) -> uint64_t
+{
+	return hash_mix((static_cast<uint64_t>(static_cast<uint32_t>(e.thread)) << 32) |
+			static_cast<uint32_t>(e.index));
+}
+
+/* Labels and co edges contribute independently (and are XOR-ed together),
+ * so that each change only needs to update the contributions it affects */
+void ExecutionGraph::toggleFingerprint(const EventLabel &lab)
+{
+	if (!fingerprinting)
+		return;
+
+	auto h = hash_mix(hashEvent(lab.getPos()) + lab.getKind());
+	if (const auto *rLab = llvm::dyn_cast<ReadLabel>(&lab))
+		h = hash_mix(h ^ hashEvent(rLab->getRf() ? rLab->getRf()->getPos()
+							  : Event::getBottom()));
+	fingerprint ^= h;
+}
+
+void ExecutionGraph::toggleCoFingerprint(const WriteLabel &wLab)
+{
+	if (!fingerprinting)
+		return;
+
+	const auto *pLab = co_imm_pred(&wLab);
+	fingerprint ^= hash_mix(~hashEvent(wLab.getPos()) ^
+				hashEvent(pLab ? pLab->getPos() : Event::getInit()));
+}
+
+/* The insertion order is determined by the predecessor of each label in it,
+ * so each label contributes its predecessor (along with its status) */
+void ExecutionGraph::toggleOrderFingerprint(const EventLabel &lab)
+{
+	if (!fingerprinting)
+		return;
+
+	auto it = decltype(insertionOrder)::const_iterator(lab);
+	auto prev = it == insertionOrder.begin() ? Event::getBottom() : std::prev(it)->getPos();
+	uint64_t status = lab.isRevisitable();
+	if (const auto *mLab = llvm::dyn_cast<MemAccessLabel>(&lab))
+		status |= static_cast<uint64_t>(mLab->wasAddedMax()) << 1;
+	if (const auto *rLab = llvm::dyn_cast<ReadLabel>(&lab))
+		status |= static_cast<uint64_t>(rLab->isIPR()) << 2;
+	orderFingerprint ^= hash_mix(hashEvent(lab.getPos()) ^ hash_mix(hashEvent(prev) + status));
+}
+
+void ExecutionGraph::appendToInsertionOrder(EventLabel &lab)
+{
+	insertionOrder.push_back(lab);
+	toggleOrderFingerprint(lab);
+}
+
+void ExecutionGraph::removeFromInsertionOrder(EventLabel &lab)
+{
+	if (!fingerprinting) {
+		insertionOrder.remove(lab);
+		return;
+	}
+
+	/* LAB's successor takes LAB's predecessor */
+	auto next = std::next(decltype(insertionOrder)::iterator(lab));
+	toggleOrderFingerprint(lab);
+	if (next != insertionOrder.end())
+		toggleOrderFingerprint(*next);
+	insertionOrder.remove(lab);
+	if (next != insertionOrder.end())
+		toggleOrderFingerprint(*next);
+}
+
+void ExecutionGraph::recalcFingerprint()
+{
+	if (!fingerprinting)
+		return;
+
+	fingerprint = 0;
+	orderFingerprint = 0;
+	for (const auto &lab : labels()) {
+		toggleFingerprint(lab);
+		toggleOrderFingerprint(lab);
+	}
+	for (const auto &[addr, stores] : coherence)
+		for (const auto &wLab : stores)
+			toggleCoFingerprint(wLab);
+}
+
+void ExecutionGraph::recalcLocReads()
+{
+	locReads.clear();
+	for (auto &lab : labels()) {
+		if (auto *rLab = llvm::dyn_cast<ReadLabel>(&lab))
+			locReads[rLab->getAddr()].push_back(rLab);
+	}
+	for (auto &[addr, reads] : locReads)
+		std::ranges::sort(reads, [](auto *a, auto *b) { return a->getStamp() < b->getStamp(); });
+}
+
+/************************************************************
+ ** Stamp bounds
+ ***********************************************************/
+
+void ExecutionGraph::updateStampBounds(int thread, int index)
+{
+	if (stampBounds.size() < events.size())
+		stampBounds.resize(events.size());
+
+	auto &thr = events[thread];
+	auto &bounds = stampBounds[thread];
+	auto size = (int)thr.size();
+	bounds.resize(size, {0U, 0U});
+
+	/* Prefix maxima can only change from INDEX onwards... */
+	for (auto j = index; j < size; j++) {
+		auto s = thr[j]->getStamp();
+		auto max = j > 0 ? std::max(bounds[j - 1].maxUpTo, s) : s;
+		if (j > index && bounds[j].maxUpTo == max)
+			break;
+		bounds[j].maxUpTo = max;
+	}
+
+	/* ... and suffix minima up to INDEX */
+	for (auto j = std::min(index, size - 1); j >= 0; j--) {
+		auto s = thr[j]->getStamp();
+		auto min = j + 1 < size ? std::min(bounds[j + 1].minFrom, s) : s;
+		if (j < index && bounds[j].minFrom == min)
+			break;
+		bounds[j].minFrom = min;
+	}
+}
+
+void ExecutionGraph::recalcStampBounds()
+{
+	stampBounds.clear();
+	stampBounds.resize(events.size());
+	for (auto i = 0U; i < events.size(); i++) {
+		auto &thr = events[i];
+		auto &bounds = stampBounds[i];
+		auto size = (int)thr.size();
+		bounds.resize(size, {0U, 0U});
+		for (auto j = 0; j < size; j++)
+			bounds[j].maxUpTo = j > 0 ? std::max(bounds[j - 1].maxUpTo, thr[j]->getStamp())
+						  : thr[j]->getStamp();
+		for (auto j = size - 1; j >= 0; j--)
+			bounds[j].minFrom = j + 1 < size
+						    ? std::min(bounds[j + 1].minFrom, thr[j]->getStamp())
+						    : thr[j]->getStamp();
+	}
+}
+
+auto ExecutionGraph::getStampWindow(int thread, Stamp st) const -> std::pair<int, int>
+{
+	if (thread >= (int)stampBounds.size())
+		return {0, 0};
+
+	const auto &bounds = stampBounds[thread];
+	auto lo = std::ranges::partition_point(bounds, [&](auto &b) { return b.maxUpTo <= st; });
+	auto hi = std::ranges::partition_point(bounds, [&](auto &b) { return b.minFrom <= st; });
+	return {lo - bounds.begin(), hi - bounds.begin()};
+}
+
 /************************************************************
  ** Calculation of writes a read can read from
  ***********************************************************/
@@ -78,14 +261,21 @@ void ExecutionGraph::trackCoherenceAtLoc(SAddr addr)
 void ExecutionGraph::removeLast(unsigned int thread)
 {
 	auto *lab = getLastThreadLabel(thread);
+	if (lab && lab->getRound())
+		invalidateRounds(lab);
+	toggleFingerprint(*lab);
 	if (auto *rLab = llvm::dyn_cast_or_null<ReadLabel>(lab)) {
 		if (auto *wLab = llvm::dyn_cast_or_null<WriteLabel>(rLab->getRf())) {
 			wLab->removeReader([&](ReadLabel &oLab) { return &oLab == rLab; });
 		}
+		auto &reads = locReads[rLab->getAddr()];
+		reads.erase(std::find(reads.rbegin(), reads.rend(), rLab).base() - 1);
 	}
 	if (auto *wLab = llvm::dyn_cast<WriteLabel>(lab)) {
 		for (auto &rLab : wLab->readers()) {
+			toggleFingerprint(rLab);
 			rLab.setRfNoCascade(nullptr);
+			toggleFingerprint(rLab);
 		}
 	}
 	if (auto *mLab = llvm::dyn_cast<MemAccessLabel>(lab)) {
@@ -100,15 +290,61 @@ void ExecutionGraph::removeLast(unsigned int thread)
 			dLab->setAlloc(nullptr);
 	}
 	/* Nothing to do for create/join: childId remains the same */
-	insertionOrder.remove(*lab);
+	removeFromInsertionOrder(*lab);
 	poLists[lab->getThread()].remove(*lab);
 	events[thread].pop_back();
+	updateStampBounds(thread, events[thread].size());
 }
 
 /************************************************************
  ** Graph modification methods
  ***********************************************************/
 
+void ExecutionGraph::forEachSCSucc(const EventLabel *lab,
+				   llvm::function_ref<void(const EventLabel *)> f) const
+{
+	if (containsPos(lab->getPos().next()))
+		f(getEventLabel(lab->getPos().next()));
+	if (llvm::isa<ThreadFinishLabel>(lab)) {
+		if (auto *jLab = tj_succ(*this, lab))
+			f(jLab);
+	}
+	if (auto *wLab = llvm::dyn_cast<WriteLabel>(lab)) {
+		for (const auto &rLab : wLab->readers())
+			f(&rLab);
+		if (auto *sLab = co_imm_succ(wLab))
+			f(sLab);
+	}
+	if (auto *rLab = llvm::dyn_cast<ReadLabel>(lab)) {
+		auto addr = rLab->getAddr();
+		if (llvm::isa_and_nonnull<InitLabel>(rLab->getRf()) && !isLocEmpty(addr))
+			f(&*co_begin(addr));
+		else if (auto *wLab = llvm::dyn_cast_or_null<WriteLabel>(rLab->getRf())) {
+			if (auto *sLab = co_imm_succ(wLab))
+				f(sLab);
+		}
+	}
+}
+
+void ExecutionGraph::invalidateRounds(const EventLabel *lab)
+{
+	/* Rounds are only ever calculated from the rounds of SC-predecessors,
+	 * so labels not SC-after LAB keep theirs */
+	std::vector<const EventLabel *> worklist = {lab};
+	lab->setRound(std::nullopt);
+	while (!worklist.empty()) {
+		const auto *iLab = worklist.back();
+		worklist.pop_back();
+		staleRounds.push_back(iLab->getPos());
+		forEachSCSucc(iLab, [&](const EventLabel *sLab) {
+			if (!sLab->getRound())
+				return;
+			sLab->setRound(std::nullopt);
+			worklist.push_back(sLab);
+		});
+	}
+}
+
 void ExecutionGraph::addAlloc(MallocLabel *aLab, MemAccessLabel *mLab)
 {
 	if (aLab) {
@@ -121,20 +357,20 @@ void ExecutionGraph::addAlloc(MallocLabel *aLab, MemAccessLabel *mLab)
  * In the case where the events are not added out-of-order in the graph
  * (i.e., an event has a larger timestamp than all its po-predecessors)
  * we can obtain a view of the graph, given a timestamp. This function
- * returns such a view.
+ * returns such a view. Only the events within the stamp window of each
+ * thread need to be inspected (typically none).
  */
 auto ExecutionGraph::getViewFromStamp(Stamp stamp) const -> std::unique_ptr<VectorClock>
 {
 	auto preds = std::make_unique<View>();
 
 	for (auto i = 0U; i < getNumThreads(); i++) {
-		for (auto j = (int)getThreadSize(i) - 1; j >= 0; j--) {
-			const auto *lab = getEventLabel(Event(i, j));
-			if (lab->getStamp() <= stamp) {
-				preds->setMax(Event(i, j));
-				break;
-			}
-		}
+		auto [lo, hi] = getStampWindow(i, stamp);
+		auto j = hi - 1;
+		while (j >= lo && getEventLabel(Event(i, j))->getStamp() > stamp)
+			--j;
+		if (j >= 0)
+			preds->setMax(Event(i, j));
 	}
 	return preds;
 }
@@ -143,6 +379,12 @@ void ExecutionGraph::removeAfter(const VectorClock &preds)
 {
 	VSet<SAddr> keep;
 
+	/* Only the rounds of labels SC-after removed ones can change */
+	for (const auto &lab : labels()) {
+		if (lab.getRound() && !preds.contains(lab.getPos()))
+			invalidateRounds(&lab);
+	}
+
 	/* Check which locations should be kept */
 	for (auto i = 0U; i < preds.size(); i++) {
 		for (auto j = 0U; j <= preds.getMax(i); j++) {
@@ -251,6 +493,10 @@ void ExecutionGraph::cutToStamp(Stamp stamp)
 	resetStamp(0U);
 	for (auto &lab : labels())
 		lab.setStamp(nextStamp());
+
+	recalcFingerprint();
+	recalcLocReads();
+	recalcStampBounds();
 }
 
 void ExecutionGraph::copyGraphUpTo(ExecutionGraph &other, const VectorClock &v) const
@@ -402,6 +648,11 @@ void ExecutionGraph::copyGraphUpTo(ExecutionGraph &other, const VectorClock &v)
 			}
 		}
 	}
+	/* Fingerprints are computed once, after all labels and edges are in place */
+	other.fingerprinting = fingerprinting;
+	other.recalcFingerprint();
+	other.recalcLocReads();
+	other.recalcStampBounds();
 }
 
 auto ExecutionGraph::getCopyUpTo(const VectorClock &v) const -> std::unique_ptr<ExecutionGraph>
@@ -478,6 +729,39 @@ void ExecutionGraph::validate()
 			}
 		}
 	}
+
+	auto incremental = fingerprint;
+	auto incrementalOrder = orderFingerprint;
+	recalcFingerprint();
+	if (fingerprinting &&
+	    (incremental != fingerprint || incrementalOrder != orderFingerprint)) {
+		llvm::errs() << "Stale fingerprint!\n";
+		llvm::errs() << *this << "\n";
+		BUG();
+	}
+
+	auto indexed = std::move(locReads);
+	recalcLocReads();
+	if (std::ranges::any_of(indexed,
+				[&](auto &kv) { return kv.second != loc_reads(kv.first); }) ||
+	    std::ranges::any_of(locReads, [&](auto &kv) { return kv.second != indexed[kv.first]; })) {
+		llvm::errs() << "Stale read index!\n";
+		llvm::errs() << *this << "\n";
+		BUG();
+	}
+
+	auto bounds = std::move(stampBounds);
+	recalcStampBounds();
+	for (auto i = 0U; i < stampBounds.size(); i++) {
+		if (i < bounds.size() &&
+		    std::ranges::equal(stampBounds[i], bounds[i], [](auto &a, auto &b) {
+			    return a.maxUpTo == b.maxUpTo && a.minFrom == b.minFrom;
+		    }))
+			continue;
+		llvm::errs() << "Stale stamp bounds: thread " << i << "\n";
+		llvm::errs() << *this << "\n";
+		BUG();
+	}
 }
 
 /*******************************************************************************
@@ -27,15 +27,22 @@
 #include "ExecutionGraph/Stamp.hpp"
 #include "Support/Hash.hpp"
 #include "config.h"
+#include <llvm/ADT/STLExtras.h>
 #include <llvm/ADT/StringMap.h>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <ranges>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 // NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast)
 
+class BinaryWriter;
+class BinaryReader;
+
 /*******************************************************************************
  **                           ExecutionGraph Class
  ******************************************************************************/
@@ -54,6 +61,8 @@ public:
 	using ThreadList = std::vector<Thread>;
 	using StoreList = llvm::simple_ilist<WriteLabel>;
 	using LocMap = std::unordered_map<SAddr, StoreList>;
+	using ReadList = std::vector<ReadLabel *>;
+	using ReadMap = std::unordered_map<SAddr, ReadList>;
 	using InitValGetter = std::function<SVal(const AAccess &)>;
 	using PoList = llvm::simple_ilist<EventLabel, llvm::ilist_tag<po_tag>>;
 	using PoLists = std::vector<PoList>;
@@ -220,6 +229,14 @@ public:
 		return getInitLabel()->rf_end(addr);
 	}
 
+	/* Returns all reads from ADDR (regardless of their rf), in stamp order */
+	auto loc_reads(SAddr addr) const -> const ReadList &
+	{
+		static const ReadList empty;
+		auto it = locReads.find(addr);
+		return it == locReads.end() ? empty : it->second;
+	}
+
 	auto co_succ_begin(WriteLabel *lab) -> co_iterator { return ++co_iterator(lab); }
 	auto co_succ_begin(const WriteLabel *lab) const -> const_co_iterator
 	{
@@ -337,6 +354,7 @@ public:
 	{
 		events.pop_back();
 		poLists.pop_back();
+		stampBounds.resize(std::min(stampBounds.size(), events.size()));
 		recoveryTID = -1;
 	};
 
@@ -353,6 +371,15 @@ public:
 	/* Returns true if the thread tid is empty */
 	auto isThreadEmpty(int tid) const -> bool { return getThreadSize(tid) == 0; };
 
+	/* Returns the number of events (incl. holes) currently in the graph */
+	auto getNumEvents() const -> unsigned int
+	{
+		auto size = 0U;
+		for (auto i = 0U; i < getNumThreads(); i++)
+			size += getThreadSize(i);
+		return size;
+	}
+
 	/* Event addition/removal methods */
 
 	auto getInitLabel() const -> const InitLabel *
@@ -368,6 +395,39 @@ public:
 	/* Returns the maximum stamp used */
 	auto getMaxStamp() const -> Stamp { return timestamp; }
 
+	/* Calls F on all labels that have LAB as an SC-predecessor
+	 * (i.e., its po-, rf-, co-, fr-, and tj-successors) */
+	void forEachSCSucc(const EventLabel *lab,
+			   llvm::function_ref<void(const EventLabel *)> f) const;
+
+	/* Invalidates the calculated rounds of LAB and of all labels SC-after it.
+	 * Has to be called before LAB is removed or its SC-successors change.
+	 * (Adding labels to the graph does not invalidate any rounds.) */
+	void invalidateRounds(const EventLabel *lab);
+
+	/* Returns (and forgets) the positions of the labels whose rounds
+	 * have been invalidated since the last call */
+	auto takeStaleRounds() const -> std::vector<Event> { return std::exchange(staleRounds, {}); }
+
+	/* Starts maintaining the fingerprints below. They are only needed for
+	 * detecting duplicates, so by default they are not maintained (and are 0) */
+	void enableFingerprints()
+	{
+		fingerprinting = true;
+		recalcFingerprint();
+	}
+	bool hasFingerprints() const { return fingerprinting; }
+
+	/* Returns a fingerprint of the graph's events, rf, and co. It is maintained
+	 * incrementally and does not depend on the insertion order, so graphs
+	 * reached in different ways can be compared in constant time */
+	auto getFingerprint() const -> uint64_t { return fingerprint; }
+
+	/* Returns a fingerprint of the order in which the graph's labels were added,
+	 * and of their exploration status (revisitability, maximality, IPR status).
+	 * Like getFingerprint(), it is maintained incrementally */
+	auto getOrderFingerprint() const -> uint64_t { return orderFingerprint; }
+
 	/* Adds LAB to the graph. If a label exists in the respective
 	 * position, it is replaced.
 	 * (Maintains well-formedness for read removals.) */
@@ -505,11 +565,21 @@ public:
 		return getCopyUpTo(*getViewFromStamp(getMaxStamp()));
 	}
 
+	/* Writes the graph in binary form to W */
+	void serialize(BinaryWriter &w) const;
+
+	/* Restores a graph written by serialize(). The graph must be freshly
+	 * constructed (i.e., only contain INIT) and of the same kind */
+	void deserialize(BinaryReader &r);
+
 	/* Overloaded operators */
 	friend auto operator<<(llvm::raw_ostream &s, const ExecutionGraph &g)
 		-> llvm::raw_ostream &;
 
 protected:
+	friend class EventLabel;
+	friend class MemAccessLabel;
+	friend class ReadLabel;
 	friend class WriteLabel;
 
 	static auto indirect(const std::unique_ptr<EventLabel> &ptr) -> EventLabel &
@@ -535,6 +605,38 @@ protected:
 
 	void trackCoherenceAtLoc(SAddr addr);
 
+	/* Adds (or removes) the contribution of LAB (and its rf) to the fingerprint */
+	void toggleFingerprint(const EventLabel &lab);
+
+	/* Adds (or removes) the contribution of WLAB's place in co to the fingerprint */
+	void toggleCoFingerprint(const WriteLabel &wLab);
+
+	/* Adds (or removes) the contribution of LAB (its place in the insertion
+	 * order, and its status) to the order fingerprint */
+	void toggleOrderFingerprint(const EventLabel &lab);
+
+	/* Adds LAB to the end of the insertion order, or removes it from the
+	 * insertion order, keeping the order fingerprint up to date */
+	void appendToInsertionOrder(EventLabel &lab);
+	void removeFromInsertionOrder(EventLabel &lab);
+
+	/* Recalculates the fingerprints from scratch (after bulk changes) */
+	void recalcFingerprint();
+
+	/* Rebuilds the per-location read index from scratch (after bulk changes) */
+	void recalcLocReads();
+
+	/* Updates the stamp bounds of THREAD after the stamp at INDEX changed
+	 * (or the thread grew/shrank at INDEX) */
+	void updateStampBounds(int thread, int index);
+
+	/* Rebuilds the stamp bounds of all threads (after bulk changes) */
+	void recalcStampBounds();
+
+	/* Returns [LO, HI) such that all events of THREAD before LO have stamps <= ST,
+	 * and all events from HI onwards have stamps > ST */
+	auto getStampWindow(int thread, Stamp st) const -> std::pair<int, int>;
+
 	void copyGraphUpTo(ExecutionGraph &other, const VectorClock &v) const;
 
 	void addInitRfToLoc(ReadLabel *rLab) { getInitLabel()->addReader(rLab); }
@@ -547,6 +649,12 @@ protected:
 
 	void removeAfter(const VectorClock &preds);
 
+	static void serializeLabel(BinaryWriter &w, const EventLabel &lab);
+	static auto deserializeLabel(BinaryReader &r) -> std::unique_ptr<EventLabel>;
+	static auto deserializeMemAccessLabel(BinaryReader &r, EventLabel::EventLabelKind kind,
+					      Event pos, MemOrdering ord)
+		-> std::unique_ptr<EventLabel>;
+
 	static auto createHoleLabel(Event pos) -> std::unique_ptr<EmptyLabel>
 	{
 		auto lab = EmptyLabel::create(pos);
@@ -561,8 +669,32 @@ protected:
 	/* The next available timestamp */
 	Stamp timestamp = 0;
 
+	/* Positions of labels whose rounds have been invalidated (see takeStaleRounds()) */
+	mutable std::vector<Event> staleRounds;
+
+	/* Whether the fingerprints are maintained (see enableFingerprints()) */
+	bool fingerprinting = false;
+
+	/* The XOR of the contributions of all labels and co edges (see getFingerprint()) */
+	uint64_t fingerprint = 0;
+
+	/* The XOR of the contributions of all labels (see getOrderFingerprint()) */
+	uint64_t orderFingerprint = 0;
+
 	LocMap coherence;
 
+	/* The reads of each location, in stamp order (see loc_reads()) */
+	ReadMap locReads;
+
+	/* For each event, the maximum stamp of its po-prefix and the minimum
+	 * stamp of its po-suffix (both inclusive). These are monotone, so the
+	 * events with stamps <= st can be found by binary search */
+	struct StampBounds {
+		Stamp maxUpTo;
+		Stamp minFrom;
+	};
+	std::vector<std::vector<StampBounds>> stampBounds;
+
 	llvm::simple_ilist<EventLabel> insertionOrder;
 
 	PoLists poLists{};
@@ -0,0 +1,571 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#include "ExecutionGraph/ExecutionGraph.hpp"
+#include "Support/BinaryIO.hpp"
+
+/*
+ * Binary (de)serialization of execution graphs (e.g., for checkpointing).
+ *
+ * Labels are stored in po order along with all the information that is
+ * not a link to another label. Links (rf, co, alloc, etc) are stored in
+ * a separate pass as positions, so that they can be restored once all
+ * labels are in place. All lists that are order-sensitive (insertion
+ * order, coherence, readers, etc) are stored in their current order.
+ */
+
+namespace {
+
+void writeDeps(BinaryWriter &w, const DepInfo &dep)
+{
+	std::vector<Event> es(dep.begin(), dep.end());
+	w.writeRange(es);
+}
+
+auto readDeps(BinaryReader &r) -> DepInfo
+{
+	DepInfo dep;
+	for (auto &e : r.readVector<Event>())
+		dep.update(DepInfo(e));
+	return dep;
+}
+
+void writeThreadInfo(BinaryWriter &w, const ThreadInfo &info)
+{
+	w.write(info.id);
+	w.write(info.parentId);
+	w.write(info.funId);
+	w.write(info.arg);
+	w.write(info.symmId);
+}
+
+auto readThreadInfo(BinaryReader &r) -> ThreadInfo
+{
+	ThreadInfo info;
+	info.id = r.read<int>();
+	info.parentId = r.read<int>();
+	info.funId = r.read<unsigned int>();
+	info.arg = r.read<SVal>();
+	info.symmId = r.read<int>();
+	return info;
+}
+
+/* Links are stored as positions; BOTTOM denotes the lack of a link */
+void writeLink(BinaryWriter &w, const EventLabel *lab)
+{
+	w.write(lab ? lab->getPos() : Event::getBottom());
+}
+
+template <typename Range> void writeLinks(BinaryWriter &w, const Range &labs)
+{
+	std::vector<Event> es;
+	for (const auto &lab : labs) {
+		if constexpr (std::is_pointer_v<std::decay_t<decltype(lab)>>)
+			es.push_back(lab->getPos());
+		else
+			es.push_back(lab.getPos());
+	}
+	w.writeRange(es);
+}
+
+} // namespace
+
+void ExecutionGraph::serializeLabel(BinaryWriter &w, const EventLabel &lab)
+{
+	w.write(lab.getKind());
+	w.write(lab.getPos());
+	w.write(lab.getOrdering());
+	w.write(lab.getStamp());
+	w.write(lab.isRevisitable());
+
+	const auto &deps = lab.getDeps();
+	for (const auto *dep : {&deps.addr, &deps.data, &deps.ctrl, &deps.addrPo, &deps.cas})
+		writeDeps(w, *dep);
+
+	w.write(!lab.calculatedRels.empty());
+	if (!lab.calculatedRels.empty()) {
+		w.writeSize(lab.calculatedRels.size());
+		for (const auto &rel : lab.calculatedRels)
+			w.writeRange(rel);
+	}
+	w.write(!lab.calculatedViews.empty());
+	if (!lab.calculatedViews.empty()) {
+		w.writeSize(lab.calculatedViews.size());
+		for (const auto &view : lab.calculatedViews)
+			::serialize(w, view);
+	}
+	w.write(lab.hasPrefixView());
+	if (lab.hasPrefixView())
+		::serialize(w, lab.getPrefixView());
+
+	if (const auto *tsLab = llvm::dyn_cast<ThreadStartLabel>(&lab)) {
+		w.write(tsLab->getCreateId());
+		writeThreadInfo(w, tsLab->getThreadInfo());
+		w.write(tsLab->getSymmPredTid());
+		w.write(tsLab->getSymmSuccTid());
+	} else if (const auto *bLab = llvm::dyn_cast<JoinBlockLabel>(&lab)) {
+		w.write(bLab->getChildId());
+	} else if (const auto *bLab = llvm::dyn_cast<ReadOptBlockLabel>(&lab)) {
+		w.write(bLab->getAddr());
+	} else if (const auto *eLab = llvm::dyn_cast<ThreadFinishLabel>(&lab)) {
+		w.write(eLab->getRetVal());
+	} else if (const auto *mLab = llvm::dyn_cast<MemAccessLabel>(&lab)) {
+		w.write(mLab->getAddr());
+		w.write(mLab->getSize());
+		w.write(mLab->getType());
+		w.write(mLab->wasAddedMax());
+		if (const auto *rLab = llvm::dyn_cast<ReadLabel>(&lab)) {
+			w.write(rLab->isIPR());
+			w.write(rLab->getAnnot() != nullptr);
+			if (rLab->getAnnot())
+				::serialize(w, *rLab->getAnnot());
+		}
+		if (const auto *fLab = llvm::dyn_cast<FaiReadLabel>(&lab)) {
+			w.write(fLab->getOp());
+			w.write(fLab->getOpVal());
+			w.write(fLab->getAttr());
+		} else if (const auto *cLab = llvm::dyn_cast<CasReadLabel>(&lab)) {
+			w.write(cLab->getExpected());
+			w.write(cLab->getSwapVal());
+			w.write(cLab->getAttr());
+		} else if (const auto *wLab = llvm::dyn_cast<WriteLabel>(&lab)) {
+			w.write(wLab->getVal());
+			w.write(wLab->getAttr());
+		}
+	} else if (const auto *aLab = llvm::dyn_cast<MallocLabel>(&lab)) {
+		w.write(aLab->getAllocAddr());
+		w.write(aLab->getAllocSize());
+		w.write(aLab->getAlignment());
+		w.write(aLab->getStorageDuration());
+		w.write(aLab->getStorageType());
+		w.write(aLab->getAddressSpace());
+		w.writeString(aLab->getName());
+	} else if (const auto *dLab = llvm::dyn_cast<FreeLabel>(&lab)) {
+		w.write(dLab->getFreedAddr());
+		w.write(dLab->getFreedSize());
+	} else if (const auto *tcLab = llvm::dyn_cast<ThreadCreateLabel>(&lab)) {
+		writeThreadInfo(w, tcLab->getChildInfo());
+	} else if (const auto *tjLab = llvm::dyn_cast<ThreadJoinLabel>(&lab)) {
+		w.write(tjLab->getChildId());
+	} else if (const auto *hpLab = llvm::dyn_cast<HpProtectLabel>(&lab)) {
+		w.write(hpLab->getHpAddr());
+		w.write(hpLab->getProtectedAddr());
+	} else if (const auto *hLab = llvm::dyn_cast<HelpingCasLabel>(&lab)) {
+		w.write(hLab->getAddr());
+		w.write(hLab->getSize());
+		w.write(hLab->getType());
+		w.write(hLab->getExpected());
+		w.write(hLab->getSwapVal());
+	} else if (const auto *oLab = llvm::dyn_cast<OptionalLabel>(&lab)) {
+		w.write(oLab->isExpandable());
+		w.write(oLab->isExpanded());
+	} else if (const auto *mbLab = llvm::dyn_cast<MethodBeginLabel>(&lab)) {
+		w.writeString(mbLab->getName());
+		w.write(mbLab->getArgument());
+	} else if (const auto *meLab = llvm::dyn_cast<MethodEndLabel>(&lab)) {
+		w.writeString(meLab->getName());
+		w.write(meLab->getResult());
+	}
+}
+
+auto ExecutionGraph::deserializeLabel(BinaryReader &r) -> std::unique_ptr<EventLabel>
+{
+	auto kind = r.read<EventLabel::EventLabelKind>();
+	auto pos = r.read<Event>();
+	auto ord = r.read<MemOrdering>();
+	auto stamp = r.read<Stamp>();
+	auto revisitable = r.read<bool>();
+
+	EventDeps deps;
+	for (auto *dep : {&deps.addr, &deps.data, &deps.ctrl, &deps.addrPo, &deps.cas})
+		*dep = readDeps(r);
+
+	std::optional<EventLabel::CalcRels> rels;
+	if (r.read<bool>()) {
+		rels.emplace(r.readSize(sizeof(uint64_t)));
+		for (auto &rel : *rels)
+			rel = r.readVector<Event>();
+	}
+	std::optional<EventLabel::CalcViews> views;
+	if (r.read<bool>()) {
+		views.emplace(r.readSize(sizeof(uint64_t)));
+		for (auto &view : *views)
+			::deserialize(r, view);
+	}
+	std::unique_ptr<VectorClock> prefix;
+	if (r.read<bool>())
+		::deserialize(r, prefix);
+
+	std::unique_ptr<EventLabel> lab;
+	switch (kind) {
+	case EventLabel::ThreadStart: {
+		auto createId = r.read<Event>();
+		auto info = readThreadInfo(r);
+		auto symmPred = r.read<int>();
+		auto tsLab = ThreadStartLabel::create(pos, ord, createId, nullptr, info, symmPred);
+		tsLab->setSymmSuccTid(r.read<int>());
+		lab = std::move(tsLab);
+		break;
+	}
+#define HANDLE_PURE_BLOCK(name)                                                                    \
+	case EventLabel::name:                                                                     \
+		lab = name##Label::create(pos);                                                    \
+		break;
+		HANDLE_PURE_BLOCK(SpinloopBlock)
+		HANDLE_PURE_BLOCK(FaiZNEBlock)
+		HANDLE_PURE_BLOCK(LockZNEBlock)
+		HANDLE_PURE_BLOCK(HelpedCASBlock)
+		HANDLE_PURE_BLOCK(ConfirmationBlock)
+		HANDLE_PURE_BLOCK(LockNotAcqBlock)
+		HANDLE_PURE_BLOCK(LockNotRelBlock)
+		HANDLE_PURE_BLOCK(BarrierBlock)
+		HANDLE_PURE_BLOCK(ErrorBlock)
+		HANDLE_PURE_BLOCK(UserBlock)
+		HANDLE_PURE_BLOCK(ThreadKill)
+		HANDLE_PURE_BLOCK(LoopBegin)
+		HANDLE_PURE_BLOCK(SpinStart)
+		HANDLE_PURE_BLOCK(FaiZNESpinEnd)
+		HANDLE_PURE_BLOCK(LockZNESpinEnd)
+		HANDLE_PURE_BLOCK(Empty)
+#undef HANDLE_PURE_BLOCK
+	case EventLabel::JoinBlock:
+		lab = JoinBlockLabel::create(pos, r.read<unsigned>());
+		break;
+	case EventLabel::ReadOptBlock:
+		lab = ReadOptBlockLabel::create(pos, r.read<SAddr>());
+		break;
+	case EventLabel::ThreadFinish:
+		lab = ThreadFinishLabel::create(pos, ord, r.read<SVal>());
+		break;
+	case EventLabel::Malloc: {
+		auto addr = r.read<SAddr>();
+		auto size = r.read<unsigned int>();
+		auto align = r.read<unsigned int>();
+		auto sdur = r.read<StorageDuration>();
+		auto stype = r.read<StorageType>();
+		auto spc = r.read<AddressSpace>();
+		lab = MallocLabel::create(pos, ord, addr, size, align, sdur, stype, spc, nullptr,
+					  r.readString());
+		break;
+	}
+	case EventLabel::Free:
+	case EventLabel::HpRetire: {
+		auto addr = r.read<SAddr>();
+		auto size = r.read<unsigned int>();
+		if (kind == EventLabel::Free)
+			lab = FreeLabel::create(pos, ord, addr, size);
+		else
+			lab = HpRetireLabel::create(pos, ord, addr, size);
+		break;
+	}
+	case EventLabel::ThreadCreate:
+		lab = ThreadCreateLabel::create(pos, ord, readThreadInfo(r));
+		break;
+	case EventLabel::ThreadJoin:
+		lab = ThreadJoinLabel::create(pos, ord, r.read<unsigned int>());
+		break;
+	case EventLabel::HpProtect: {
+		auto hp = r.read<SAddr>();
+		lab = HpProtectLabel::create(pos, ord, hp, r.read<SAddr>());
+		break;
+	}
+	case EventLabel::HelpingCas: {
+		auto addr = r.read<SAddr>();
+		auto size = r.read<ASize>();
+		auto type = r.read<AType>();
+		auto exp = r.read<SVal>();
+		lab = HelpingCasLabel::create(pos, ord, addr, size, type, exp, r.read<SVal>());
+		break;
+	}
+	case EventLabel::Optional: {
+		auto oLab = OptionalLabel::create(pos);
+		oLab->setExpandable(r.read<bool>());
+		oLab->setExpanded(r.read<bool>());
+		lab = std::move(oLab);
+		break;
+	}
+	case EventLabel::MethodBegin: {
+		auto name = r.readString();
+		lab = MethodBeginLabel::create(pos, name, r.read<int32_t>());
+		break;
+	}
+	case EventLabel::MethodEnd: {
+		auto name = r.readString();
+		lab = MethodEndLabel::create(pos, name, r.read<int32_t>());
+		break;
+	}
+	default: {
+		if (!MemAccessLabel::classofKind(kind))
+			ERROR("Unknown label kind in binary input!\n");
+		lab = deserializeMemAccessLabel(r, kind, pos, ord);
+		break;
+	}
+	}
+
+	lab->setOrdering(ord);
+	lab->setDeps(std::move(deps));
+	lab->setStamp(stamp);
+	lab->setRevisitStatus(revisitable);
+	if (rels)
+		lab->setCalculated(std::move(*rels));
+	if (views)
+		lab->setViews(std::move(*views));
+	if (prefix)
+		lab->setPrefixView(std::move(prefix));
+	return lab;
+}
+
+auto ExecutionGraph::deserializeMemAccessLabel(BinaryReader &r, EventLabel::EventLabelKind kind,
+					       Event pos, MemOrdering ord)
+	-> std::unique_ptr<EventLabel>
+{
+	auto addr = r.read<SAddr>();
+	auto size = r.read<ASize>();
+	auto type = r.read<AType>();
+	auto maximal = r.read<bool>();
+
+	std::unique_ptr<MemAccessLabel> lab;
+	if (ReadLabel::classofKind(kind)) {
+		auto ipr = r.read<bool>();
+		std::unique_ptr<ReadLabel::AnnotT> annot;
+		if (r.read<bool>())
+			::deserialize(r, annot);
+
+		std::unique_ptr<ReadLabel> rLab;
+		if (FaiReadLabel::classofKind(kind)) {
+			auto op = r.read<RMWBinOp>();
+			auto val = r.read<SVal>();
+			auto wattr = r.read<WriteAttr>();
+			switch (kind) {
+#define HANDLE_FAI_READ(name)                                                                      \
+	case EventLabel::name:                                                                     \
+		rLab = name##Label::create(pos, ord, addr, size, type, op, val, wattr);            \
+		break;
+				HANDLE_FAI_READ(FaiRead)
+				HANDLE_FAI_READ(NoRetFaiRead)
+				HANDLE_FAI_READ(BIncFaiRead)
+#undef HANDLE_FAI_READ
+			default:
+				BUG();
+			}
+		} else if (CasReadLabel::classofKind(kind)) {
+			auto exp = r.read<SVal>();
+			auto swap = r.read<SVal>();
+			auto wattr = r.read<WriteAttr>();
+			switch (kind) {
+#define HANDLE_CAS_READ(name)                                                                      \
+	case EventLabel::name:                                                                     \
+		rLab = name##Label::create(pos, ord, addr, size, type, exp, swap, wattr, nullptr); \
+		break;
+				HANDLE_CAS_READ(CasRead)
+				HANDLE_CAS_READ(LockCasRead)
+				HANDLE_CAS_READ(TrylockCasRead)
+				HANDLE_CAS_READ(HelpedCasRead)
+				HANDLE_CAS_READ(ConfirmingCasRead)
+#undef HANDLE_CAS_READ
+			case EventLabel::AbstractLockCasRead: {
+				auto cLab = AbstractLockCasReadLabel::create(pos, addr, size);
+				cLab->setAttr(wattr);
+				rLab = std::move(cLab);
+				break;
+			}
+			default:
+				BUG();
+			}
+		} else {
+			switch (kind) {
+#define HANDLE_READ(name)                                                                          \
+	case EventLabel::name:                                                                     \
+		rLab = name##Label::create(pos, ord, addr, size, type);                            \
+		break;
+				HANDLE_READ(Read)
+				HANDLE_READ(BWaitRead)
+				HANDLE_READ(SpeculativeRead)
+				HANDLE_READ(ConfirmingRead)
+				HANDLE_READ(CondVarWaitRead)
+#undef HANDLE_READ
+			default:
+				BUG();
+			}
+		}
+		rLab->setIPRStatus(ipr);
+		if (annot)
+			rLab->setAnnot(std::move(annot));
+		lab = std::move(rLab);
+	} else {
+		auto val = r.read<SVal>();
+		auto wattr = r.read<WriteAttr>();
+		std::unique_ptr<WriteLabel> wLab;
+		switch (kind) {
+#define HANDLE_WRITE(name)                                                                         \
+	case EventLabel::name:                                                                     \
+		wLab = name##Label::create(pos, ord, addr, size, type, val, wattr);                \
+		break;
+			HANDLE_WRITE(Write)
+			HANDLE_WRITE(BInitWrite)
+			HANDLE_WRITE(BDestroyWrite)
+			HANDLE_WRITE(CondVarInitWrite)
+			HANDLE_WRITE(CondVarSignalWrite)
+			HANDLE_WRITE(CondVarBcastWrite)
+			HANDLE_WRITE(CondVarDestroyWrite)
+			HANDLE_WRITE(UnlockWrite)
+			HANDLE_WRITE(AbstractUnlockWrite)
+			HANDLE_WRITE(CasWrite)
+			HANDLE_WRITE(LockCasWrite)
+			HANDLE_WRITE(AbstractLockCasWrite)
+			HANDLE_WRITE(TrylockCasWrite)
+			HANDLE_WRITE(HelpedCasWrite)
+			HANDLE_WRITE(ConfirmingCasWrite)
+			HANDLE_WRITE(FaiWrite)
+			HANDLE_WRITE(NoRetFaiWrite)
+			HANDLE_WRITE(BIncFaiWrite)
+#undef HANDLE_WRITE
+		default:
+			BUG();
+		}
+		/* Not all constructors honor the attribute */
+		wLab->setAttr(wattr);
+		lab = std::move(wLab);
+	}
+	lab->setAddedMax(maximal);
+	return lab;
+}
+
+void ExecutionGraph::serialize(BinaryWriter &w) const
+{
+	w.writeSize(getNumThreads());
+	w.write(recoveryTID);
+	w.write(timestamp);
+	w.write(getInitLabel()->getStamp());
+
+	/* Labels (po order; INIT is created by the constructor) */
+	for (auto i = 0U; i < getNumThreads(); i++) {
+		w.writeSize(getThreadSize(i) - (i == 0));
+		for (const auto &lab : po(i))
+			if (!llvm::isa<InitLabel>(&lab))
+				serializeLabel(w, lab);
+	}
+	writeLinks(w, labels());
+
+	/* Coherence and reads from INIT, per location */
+	w.writeSize(coherence.size());
+	for (const auto &[addr, stores] : coherence) {
+		w.write(addr);
+		writeLinks(w, stores);
+		writeLinks(w, getInitLabel()->rfs(addr));
+	}
+
+	/* Links between labels */
+	for (auto i = 0U; i < getNumThreads(); i++) {
+		for (const auto &lab : po(i)) {
+			if (const auto *rLab = llvm::dyn_cast<ReadLabel>(&lab))
+				writeLink(w, rLab->getRf());
+			if (const auto *wLab = llvm::dyn_cast<WriteLabel>(&lab))
+				writeLinks(w, wLab->readers());
+			if (const auto *mLab = llvm::dyn_cast<MemAccessLabel>(&lab))
+				writeLink(w, mLab->getAlloc());
+			if (const auto *aLab = llvm::dyn_cast<MallocLabel>(&lab)) {
+				writeLink(w, aLab->getFree());
+				writeLinks(w, aLab->accesses());
+			}
+			if (const auto *dLab = llvm::dyn_cast<FreeLabel>(&lab))
+				writeLink(w, dLab->getAlloc());
+			if (const auto *tsLab = llvm::dyn_cast<ThreadStartLabel>(&lab))
+				writeLink(w, tsLab->getCreate());
+			if (const auto *eLab = llvm::dyn_cast<ThreadFinishLabel>(&lab))
+				writeLink(w, eLab->getParentJoin());
+			if (const auto *mbLab = llvm::dyn_cast<MethodBeginLabel>(&lab))
+				writeLinks(w, mbLab->lin_preds());
+			if (const auto *meLab = llvm::dyn_cast<MethodEndLabel>(&lab))
+				writeLinks(w, meLab->lin_succs());
+		}
+	}
+}
+
+void ExecutionGraph::deserialize(BinaryReader &r)
+{
+	BUG_ON(getNumThreads() != 1 || getThreadSize(0) != 1);
+
+	auto numThreads = r.readSize(sizeof(uint64_t));
+	recoveryTID = r.read<int>();
+	auto stamp = r.read<Stamp>();
+	getInitLabel()->setStamp(r.read<Stamp>());
+
+	events.resize(numThreads);
+	poLists.resize(numThreads);
+	for (auto i = 0U; i < numThreads; i++) {
+		for (auto n = r.readSize(); n > 0; --n)
+			addLabelToGraph(deserializeLabel(r));
+	}
+	resetStamp(stamp);
+
+	insertionOrder.clear();
+	for (auto &e : r.readVector<Event>())
+		insertionOrder.push_back(*getEventLabel(e));
+
+	auto readLink = [&]() -> EventLabel * {
+		auto e = r.read<Event>();
+		return e.isBottom() ? nullptr : getEventLabel(e);
+	};
+
+	for (auto n = r.readSize(); n > 0; --n) {
+		auto addr = r.read<SAddr>();
+		trackCoherenceAtLoc(addr);
+		for (auto &e : r.readVector<Event>())
+			coherence[addr].push_back(*getWriteLabel(e));
+		for (auto &e : r.readVector<Event>())
+			addInitRfToLoc(getReadLabel(e));
+	}
+
+	for (auto i = 0U; i < getNumThreads(); i++) {
+		for (auto &lab : po(i)) {
+			if (auto *rLab = llvm::dyn_cast<ReadLabel>(&lab))
+				rLab->setRfNoCascade(readLink());
+			if (auto *wLab = llvm::dyn_cast<WriteLabel>(&lab)) {
+				for (auto &e : r.readVector<Event>())
+					wLab->addReader(getReadLabel(e));
+			}
+			if (auto *mLab = llvm::dyn_cast<MemAccessLabel>(&lab))
+				mLab->setAlloc(llvm::dyn_cast_or_null<MallocLabel>(readLink()));
+			if (auto *aLab = llvm::dyn_cast<MallocLabel>(&lab)) {
+				aLab->setFree(llvm::dyn_cast_or_null<FreeLabel>(readLink()));
+				for (auto &e : r.readVector<Event>())
+					aLab->addAccess(llvm::dyn_cast<MemAccessLabel>(getEventLabel(e)));
+			}
+			if (auto *dLab = llvm::dyn_cast<FreeLabel>(&lab))
+				dLab->setAlloc(llvm::dyn_cast_or_null<MallocLabel>(readLink()));
+			if (auto *tsLab = llvm::dyn_cast<ThreadStartLabel>(&lab))
+				tsLab->setCreate(llvm::dyn_cast_or_null<ThreadCreateLabel>(readLink()));
+			if (auto *eLab = llvm::dyn_cast<ThreadFinishLabel>(&lab))
+				eLab->setParentJoin(llvm::dyn_cast_or_null<ThreadJoinLabel>(readLink()));
+			if (auto *mbLab = llvm::dyn_cast<MethodBeginLabel>(&lab)) {
+				for (auto &e : r.readVector<Event>())
+					mbLab->addPredNoCascade(
+						llvm::dyn_cast<MethodEndLabel>(getEventLabel(e)));
+			}
+			if (auto *meLab = llvm::dyn_cast<MethodEndLabel>(&lab)) {
+				for (auto &e : r.readVector<Event>())
+					meLab->addSuccNoCascade(
+						llvm::dyn_cast<MethodBeginLabel>(getEventLabel(e)));
+			}
+		}
+	}
+	recalcFingerprint();
+	recalcLocReads();
+	recalcStampBounds();
+}
@@ -0,0 +1,196 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#include "Runtime/Bytecode.hpp"
+#include "Runtime/Interpreter.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/InstIterator.h>
+
+using namespace llvm;
+
+FunctionBytecode::FunctionBytecode(Function &F, const FunctionSlots &slots)
+{
+	code.resize(slots.size());
+	for (auto &I : instructions(F)) {
+		auto &inst = code[slots.getSlot(&I)];
+		inst.inst = &I;
+		if (!I.isTerminator())
+			inst.next = slots.getSlot(I.getNextNode());
+		if (!lower(I, slots, inst))
+			inst.op = Fallback;
+	}
+}
+
+bool FunctionBytecode::lowerOperand(Value *V, const FunctionSlots &slots, Operand &op)
+{
+	if (isa<Argument>(V) || isa<Instruction>(V)) {
+		op = slots.getSlot(V);
+		return true;
+	}
+
+	GenericValue val;
+	if (auto *CI = dyn_cast<ConstantInt>(V))
+		val.IntVal = CI->getValue();
+	else if (isa<ConstantPointerNull>(V))
+		val.PointerVal = nullptr;
+	else
+		return false;
+
+	op = ~static_cast<Operand>(constants.size());
+	constants.push_back(val);
+	return true;
+}
+
+bool FunctionBytecode::lowerEdge(BasicBlock *from, BasicBlock *to, const FunctionSlots &slots,
+				 unsigned &edge)
+{
+	Edge e;
+	e.dest = to;
+	e.first = to->getFirstNonPHI()->getIterator();
+	e.firstSlot = slots.getSlot(&*e.first);
+	e.movesBegin = moves.size();
+	for (auto &phi : to->phis()) {
+		Move m;
+		m.dst = slots.getSlot(&phi);
+		if (!lowerOperand(phi.getIncomingValueForBlock(from), slots, m.src)) {
+			moves.resize(e.movesBegin);
+			return false;
+		}
+		moves.push_back(m);
+	}
+	e.movesEnd = moves.size();
+
+	edge = edges.size();
+	edges.push_back(e);
+	return true;
+}
+
+static auto isScalarInt(const Value *V) -> bool { return V->getType()->isIntegerTy(); }
+
+bool FunctionBytecode::lower(Instruction &I, const FunctionSlots &slots, Inst &inst)
+{
+	if (auto *BI = dyn_cast<BranchInst>(&I)) {
+		if (BI->isUnconditional()) {
+			inst.op = Br;
+			return lowerEdge(I.getParent(), BI->getSuccessor(0), slots, inst.succ[0]);
+		}
+		inst.op = CondBr;
+		return isScalarInt(BI->getCondition()) &&
+		       lowerOperand(BI->getCondition(), slots, inst.ops[0]) &&
+		       lowerEdge(I.getParent(), BI->getSuccessor(0), slots, inst.succ[0]) &&
+		       lowerEdge(I.getParent(), BI->getSuccessor(1), slots, inst.succ[1]);
+	}
+
+	if (auto *SI = dyn_cast<SelectInst>(&I)) {
+		inst.op = Select;
+		return isScalarInt(SI->getCondition()) && !SI->getType()->isVectorTy() &&
+		       lowerOperand(SI->getCondition(), slots, inst.ops[0]) &&
+		       lowerOperand(SI->getTrueValue(), slots, inst.ops[1]) &&
+		       lowerOperand(SI->getFalseValue(), slots, inst.ops[2]);
+	}
+
+	/* The remaining instructions only take and produce scalar integers */
+	if (!isScalarInt(&I) || llvm::any_of(I.operand_values(), [](auto *op) {
+		    return !isScalarInt(op);
+	    }))
+		return false;
+
+	if (auto *BO = dyn_cast<BinaryOperator>(&I)) {
+		switch (BO->getOpcode()) {
+		case Instruction::Add:
+			inst.op = Add;
+			break;
+		case Instruction::Sub:
+			inst.op = Sub;
+			break;
+		case Instruction::Mul:
+			inst.op = Mul;
+			break;
+		case Instruction::And:
+			inst.op = And;
+			break;
+		case Instruction::Or:
+			inst.op = Or;
+			break;
+		case Instruction::Xor:
+			inst.op = Xor;
+			break;
+		case Instruction::Shl:
+			inst.op = Shl;
+			break;
+		case Instruction::LShr:
+			inst.op = LShr;
+			break;
+		case Instruction::AShr:
+			inst.op = AShr;
+			break;
+		default:
+			/* Divisions are left to the visitor */
+			return false;
+		}
+		return lowerOperand(BO->getOperand(0), slots, inst.ops[0]) &&
+		       lowerOperand(BO->getOperand(1), slots, inst.ops[1]);
+	}
+
+	if (auto *CI = dyn_cast<ICmpInst>(&I)) {
+		switch (CI->getPredicate()) {
+		case ICmpInst::ICMP_EQ:
+			inst.op = ICmpEQ;
+			break;
+		case ICmpInst::ICMP_NE:
+			inst.op = ICmpNE;
+			break;
+		case ICmpInst::ICMP_ULT:
+			inst.op = ICmpULT;
+			break;
+		case ICmpInst::ICMP_SLT:
+			inst.op = ICmpSLT;
+			break;
+		case ICmpInst::ICMP_UGT:
+			inst.op = ICmpUGT;
+			break;
+		case ICmpInst::ICMP_SGT:
+			inst.op = ICmpSGT;
+			break;
+		case ICmpInst::ICMP_ULE:
+			inst.op = ICmpULE;
+			break;
+		case ICmpInst::ICMP_SLE:
+			inst.op = ICmpSLE;
+			break;
+		case ICmpInst::ICMP_UGE:
+			inst.op = ICmpUGE;
+			break;
+		case ICmpInst::ICMP_SGE:
+			inst.op = ICmpSGE;
+			break;
+		default:
+			return false;
+		}
+		return lowerOperand(CI->getOperand(0), slots, inst.ops[0]) &&
+		       lowerOperand(CI->getOperand(1), slots, inst.ops[1]);
+	}
+
+	if (isa<TruncInst>(I) || isa<ZExtInst>(I) || isa<SExtInst>(I)) {
+		inst.op = isa<TruncInst>(I) ? Trunc : isa<ZExtInst>(I) ? ZExt : SExt;
+		inst.width = I.getType()->getIntegerBitWidth();
+		return lowerOperand(I.getOperand(0), slots, inst.ops[0]);
+	}
+	return false;
+}
@@ -0,0 +1,127 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#ifndef GENMC_BYTECODE_HPP
+#define GENMC_BYTECODE_HPP
+
+#include <llvm/ExecutionEngine/GenericValue.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace llvm {
+
+class FunctionSlots;
+
+/*
+ * A register-based encoding of the instructions of a function that the
+ * interpreter can execute without going through InstVisitor. Instructions are
+ * indexed by their slot (see FunctionSlots), and their operands are either
+ * frame slots or entries of a constant pool, so executing one needs neither a
+ * type switch nor an operand lookup.
+ *
+ * Only local integer instructions and branches are compiled; everything else
+ * (memory accesses, calls, floating point, vectors, ...) is encoded as
+ * Fallback and executed by the visitor. Results have the same GenericValue
+ * representation the visitor would produce.
+ */
+class FunctionBytecode {
+
+public:
+	enum Opcode : uint8_t {
+		Fallback,
+		Add,
+		Sub,
+		Mul,
+		And,
+		Or,
+		Xor,
+		Shl,
+		LShr,
+		AShr,
+		ICmpEQ,
+		ICmpNE,
+		ICmpULT,
+		ICmpSLT,
+		ICmpUGT,
+		ICmpSGT,
+		ICmpULE,
+		ICmpSLE,
+		ICmpUGE,
+		ICmpSGE,
+		Trunc,
+		ZExt,
+		SExt,
+		Select,
+		Br,
+		CondBr,
+		NumOpcodes,
+	};
+
+	/* An operand: a frame slot if non-negative, ~index into the constant pool otherwise */
+	using Operand = int32_t;
+
+	struct Inst {
+		Opcode op = Fallback;
+		unsigned width{};   /* Result width (casts) */
+		Operand ops[3]{};   /* Operands (the condition comes first for CondBr) */
+		unsigned next{};    /* Slot of the next instruction (non-terminators) */
+		unsigned succ[2]{}; /* Edges taken (branches; the false one second) */
+		Instruction *inst{};
+	};
+
+	/* A branch destination along with the PHI nodes it assigns */
+	struct Edge {
+		BasicBlock *dest{};
+		BasicBlock::iterator first; /* First non-PHI instruction of DEST */
+		unsigned firstSlot{};
+		unsigned movesBegin{};
+		unsigned movesEnd{};
+	};
+
+	/* A PHI assignment on an edge */
+	struct Move {
+		unsigned dst{};
+		Operand src{};
+	};
+
+	FunctionBytecode() = default;
+	FunctionBytecode(Function &F, const FunctionSlots &slots);
+
+	const Inst &getInst(unsigned slot) const { return code[slot]; }
+	const Edge &getEdge(unsigned i) const { return edges[i]; }
+	const Move &getMove(unsigned i) const { return moves[i]; }
+	const GenericValue &getConstant(Operand op) const { return constants[~op]; }
+
+private:
+	bool lowerOperand(Value *V, const FunctionSlots &slots, Operand &op);
+	bool lowerEdge(BasicBlock *from, BasicBlock *to, const FunctionSlots &slots,
+		       unsigned &edge);
+	bool lower(Instruction &I, const FunctionSlots &slots, Inst &inst);
+
+	std::vector<Inst> code;
+	std::vector<Edge> edges;
+	std::vector<Move> moves;
+	std::vector<GenericValue> constants;
+};
+
+} // namespace llvm
+
+#endif /* GENMC_BYTECODE_HPP */
@@ -21,10 +21,14 @@
 #ifndef GENMC_DEP_TRACKER_HPP
 #define GENMC_DEP_TRACKER_HPP
 
+#include "ADT/EpochVector.hpp"
 #include "ExecutionGraph/DepInfo.hpp"
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/IR/Instruction.h>
+#include <llvm/IR/Module.h>
 
-#include <unordered_map>
+#include <memory>
+#include <vector>
 
 /*******************************************************************************
  **                            DepTracker Class
@@ -33,59 +37,128 @@
 /*
  * A class to be used from the Interpreter to track dependencies between
  * instructions.
+ *
+ * The arguments and instructions of the program are numbered once, and the
+ * data dependencies of each thread are stored in an array indexed by these
+ * numbers. Values that are not numbered (e.g., constants) have no dependencies.
  */
 class DepTracker {
 
 public:
+	explicit DepTracker(const llvm::Module &M)
+	{
+		auto num = std::make_shared<NumberingT>();
+		for (auto &F : M) {
+			for (auto &arg : F.args())
+				num->try_emplace(&arg, num->size());
+			for (auto &BB : F)
+				for (auto &I : BB)
+					num->try_emplace(&I, num->size());
+		}
+		numbering = std::move(num);
+	}
+
 	/* Returns data dependencies for instruction i in thread tid */
-	const DepInfo *getDataDeps(unsigned int tid, llvm::Value *i) { return &dataDeps[tid][i]; };
+	const DepInfo *getDataDeps(unsigned int tid, const llvm::Value *i)
+	{
+		auto idx = getIndex(i);
+		return idx != noIndex ? &getThreadDeps(tid).data[idx] : &noDeps;
+	};
 
 	/* Returns the address dependencies collected so far for tid */
-	const DepInfo *getAddrPoDeps(unsigned int tid) { return &addrPoDeps[tid]; };
+	const DepInfo *getAddrPoDeps(unsigned int tid) { return &getThreadDeps(tid).addrPo; };
 
 	/* Returns the control dependencies collected so far for tid */
-	const DepInfo *getCtrlDeps(unsigned int tid) { return &ctrlDeps[tid]; };
+	const DepInfo *getCtrlDeps(unsigned int tid) { return &getThreadDeps(tid).ctrl; };
 
 	/* Updates data dependencies of dst, as it is dependent on src */
-	void updateDataDeps(unsigned int tid, llvm::Value *dst, llvm::Value *src)
+	void updateDataDeps(unsigned int tid, const llvm::Value *dst, const llvm::Value *src)
 	{
-		dataDeps[tid][dst].update(dataDeps[tid][src]);
+		auto srcIdx = getIndex(src);
+		if (srcIdx == noIndex)
+			return;
+		auto dstIdx = getOrAddIndex(dst);
+		auto &deps = getThreadDeps(tid).data;
+		deps[dstIdx].update(deps[srcIdx]);
 	};
-	void updateDataDeps(unsigned int tid, llvm::Value *dst, DepInfo e)
+	/* E is copied: callers may pass the dependencies of another value of TID,
+	 * which are reallocated if DST gets numbered now */
+	void updateDataDeps(unsigned int tid, const llvm::Value *dst, DepInfo e)
 	{
-		dataDeps[tid][dst].update(e);
+		auto dstIdx = getOrAddIndex(dst);
+		getThreadDeps(tid).data[dstIdx].update(e);
 	};
 
 	/* Adds the dependencies from src to the address dependencies */
-	void updateAddrPoDeps(unsigned int tid, llvm::Value *src)
+	void updateAddrPoDeps(unsigned int tid, const llvm::Value *src)
 	{
-		addrPoDeps[tid].update(dataDeps[tid][src]);
+		auto &td = getThreadDeps(tid);
+		td.addrPo.update(*getDataDeps(tid, src));
 	};
 
 	/* Adds the dependencies from src to the control dependencies */
-	void updateCtrlDeps(unsigned int tid, llvm::Value *src)
+	void updateCtrlDeps(unsigned int tid, const llvm::Value *src)
 	{
-		ctrlDeps[tid].update(dataDeps[tid][src]);
+		auto &td = getThreadDeps(tid);
+		td.ctrl.update(*getDataDeps(tid, src));
 	};
-	void updateCtrlDeps(unsigned int tid, Event e) { ctrlDeps[tid].update(DepInfo(e)); };
+	void updateCtrlDeps(unsigned int tid, Event e) { getThreadDeps(tid).ctrl.update(DepInfo(e)); };
 
-	/* Clears the dependencies calculated for thread TID */
+	/* Clears the dependencies calculated for thread TID (in constant time) */
 	void clearDeps(unsigned int tid)
 	{
-		dataDeps[tid].clear();
-		addrPoDeps[tid].clear();
-		ctrlDeps[tid].clear();
+		auto &td = getThreadDeps(tid);
+		td.data.clear();
+		td.addrPo.clear();
+		td.ctrl.clear();
 	};
 
 private:
-	/* The data dependencies of each instruction are
-	 * stored in a map (per thread) */
-	std::unordered_map<unsigned int, std::unordered_map<llvm::Value *, DepInfo>> dataDeps;
-
-	/* Since {addr, ctrl} are forwards-closed under po, we just
-	 * keep a DepInfo item for these */
-	std::unordered_map<unsigned int, DepInfo> addrPoDeps;
-	std::unordered_map<unsigned int, DepInfo> ctrlDeps;
+	using NumberingT = llvm::DenseMap<const llvm::Value *, unsigned int>;
+
+	static constexpr unsigned int noIndex = ~0U;
+
+	/* The dependencies of a thread */
+	struct ThreadDeps {
+		/* The data dependencies of each value (indexed by value number) */
+		EpochVector<DepInfo> data;
+
+		/* Since {addr, ctrl} are forwards-closed under po, we just
+		 * keep a DepInfo item for these */
+		DepInfo addrPo;
+		DepInfo ctrl;
+	};
+
+	unsigned int getIndex(const llvm::Value *v) const
+	{
+		auto it = numbering->find(v);
+		return it != numbering->end() ? it->second : noIndex;
+	}
+	/* Instructions created during the exploration (e.g., when lowering intrinsics)
+	 * are numbered when they first get dependencies */
+	unsigned int getOrAddIndex(const llvm::Value *v)
+	{
+		return numbering->try_emplace(v, numbering->size()).first->second;
+	}
+
+	ThreadDeps &getThreadDeps(unsigned int tid)
+	{
+		if (tid >= threads.size())
+			threads.resize(tid + 1);
+		auto &td = threads[tid];
+		if (td.data.size() != numbering->size())
+			td.data.resize(numbering->size());
+		return td;
+	}
+
+	/* The numbering of the program's values (shared among copies) */
+	std::shared_ptr<NumberingT> numbering;
+
+	/* The dependencies of each thread (indexed by thread id) */
+	std::vector<ThreadDeps> threads;
+
+	/* The dependencies of values that are not numbered */
+	static inline const DepInfo noDeps{};
 };
 
 struct DepTrackerCloner {
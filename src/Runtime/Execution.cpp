@@ -107,7 +107,10 @@ using namespace llvm;
 		__result;                                                                          \
 	})
 
-static void SetValue(Value *V, GenericValue Val, ExecutionContext &SF) { SF.Values[V] = Val; }
+static void SetValue(Value *V, GenericValue Val, ExecutionContext &SF)
+{
+	SF.setValue(V, std::move(Val));
+}
 
 bool Interpreter::isStaticallyAllocated(SAddr addr) const
 {
@@ -182,16 +185,16 @@ std::unique_ptr<SExpr<unsigned int>> Interpreter::getCurrentAnnotConcretized()
 		return nullptr;
 
 	using Concretizer = SExprConcretizer<AnnotID>;
-	auto &stackVals = ECStack().back().Values;
+	auto &SF = ECStack().back();
 	Concretizer::ReplaceMap vMap;
 
-	for (auto &kv : stackVals) {
-		/* (1) Check against NULL due to possibly empty thread parameter list
-		 * (2) Ensure that the load itself will not be concretized */
-		if (kv.first && kv.first != l) {
-			vMap.insert({(MI->idInfo.VID.at(kv.first)),
-				     std::make_pair(GV_TO_SVAL(kv.second, kv.first->getType()),
-						    ASize(getTypeSize(kv.first->getType()) * 8))});
+	for (auto slot : SF.Defined.set_bits()) {
+		/* Ensure that the load itself will not be concretized */
+		auto *v = SF.Slots->getValue(slot);
+		if (v != l) {
+			vMap.insert({(MI->idInfo.VID.at(v)),
+				     std::make_pair(GV_TO_SVAL(SF.Values[slot], v->getType()),
+						    ASize(getTypeSize(v->getType()) * 8))});
 		}
 	}
 	return Concretizer().concretize(annot, vMap);
@@ -1513,9 +1516,14 @@ void Interpreter::SwitchToNewBasicBlock(BasicBlock *Dest, ExecutionContext &SF)
 		return; // Nothing fancy to do
 
 	// Loop over all of the PHI nodes in the current block, reading their inputs.
-	std::vector<GenericValue> ResultValues;
+	SmallVector<GenericValue, 4> ResultValues;
+	unsigned firstSlot = 0;
 
 	for (; PHINode *PN = dyn_cast<PHINode>(SF.CurInst); ++SF.CurInst) {
+		SF.enter(PN);
+		if (ResultValues.empty())
+			firstSlot = SF.CurSlot;
+
 		// Search for the value corresponding to this previous bb...
 		int i = PN->getBasicBlockIndex(PrevBB);
 		assert(i != -1 && "PHINode doesn't contain entry for predecessor??");
@@ -1528,9 +1536,11 @@ void Interpreter::SwitchToNewBasicBlock(BasicBlock *Dest, ExecutionContext &SF)
 
 	// Now loop over all of the PHI nodes setting their values...
 	SF.CurInst = SF.CurBB->begin();
+	SF.CurSlot = firstSlot - 1; /* Hint at the first PHI again */
 	for (unsigned i = 0; isa<PHINode>(SF.CurInst); ++SF.CurInst, ++i) {
 		PHINode *PN = cast<PHINode>(SF.CurInst);
-		SetValue(PN, ResultValues[i], SF);
+		SF.enter(PN);
+		SetValue(PN, std::move(ResultValues[i]), SF);
 	}
 }
 
@@ -1929,6 +1939,8 @@ void Interpreter::visitCallInstWrapper(CallInstWrapper CS)
 			if (!atBegin)
 				--me;
 			IL->LowerIntrinsicCall(cast<CallInst>(&CS));
+			functionSlots.find(SF.CurFunction)
+				->second->addMissingSlots(*SF.CurFunction);
 
 			// Restore the CurInst pointer to the first instruction newly inserted, if
 			// any.
@@ -2979,7 +2991,7 @@ GenericValue Interpreter::getOperandValue(Value *V, ExecutionContext &SF)
 	} else if (GlobalValue *GV = dyn_cast<GlobalValue>(V)) {
 		return PTOGV(getPointerToGlobal(GV));
 	} else {
-		return SF.Values[V];
+		return SF.getValue(V);
 	}
 }
 
@@ -3256,11 +3268,9 @@ void Interpreter::callThreadCreate(Function *F, const std::vector<GenericValue>
 
 	/* First, set up the stack frame for the new function.
 	 * Calling function needs to take only one argument ... */
-	SF.CurFunction = calledFun;
-	SF.CurBB = &calledFun->front();
-	SF.CurInst = SF.CurBB->begin();
-
-	SetValue(&*calledFun->arg_begin(), ArgVals[2], SF);
+	initFrame(SF, calledFun);
+	if (!calledFun->arg_empty())
+		SetValue(&*calledFun->arg_begin(), ArgVals[2], SF);
 
 	/* Then, inform the driver about the thread creation */
 	auto deps = makeEventDeps(nullptr, nullptr, getCtrlDeps(getCurThr().id),
@@ -3740,9 +3750,8 @@ void Interpreter::callFunction(Function *F, const std::vector<GenericValue> &Arg
 		return;
 	}
 
-	// Get pointers to first LLVM BB & Instruction in function.
-	StackFrame.CurBB = &F->front();
-	StackFrame.CurInst = StackFrame.CurBB->begin();
+	// Get pointers to first LLVM BB & Instruction in function, and make room for its values.
+	initFrame(StackFrame, F);
 
 	// Run through the function arguments and initialize their values...
 	assert((ArgVals.size() == F->arg_size() ||
@@ -3802,6 +3811,7 @@ void Interpreter::replayExecutionBefore(const VectorClock &before)
 			int snap = getCurThr().globalInstructions;
 			ExecutionContext &SF = ECStack().back();
 			Instruction &I = *SF.CurInst++;
+			SF.enter(&I);
 			visit(I);
 
 			/* Collect metadata only for global instructions */
@@ -3842,6 +3852,7 @@ void Interpreter::runAtExitHandlers()
 				continue;
 			llvm::ExecutionContext &SF = ECStack().back();
 			llvm::Instruction &I = *SF.CurInst++;
+			SF.enter(&I);
 			visit(I);
 		}
 		// run();
@@ -3849,14 +3860,178 @@ void Interpreter::runAtExitHandlers()
 	setProgramState(oldState);
 }
 
+/* Returns true if executing I cannot add events to the graph
+ * (or otherwise interact with the driver) */
+static bool isLocalInstruction(const Instruction &I)
+{
+	return isa<BinaryOperator>(I) || isa<UnaryOperator>(I) || isa<CmpInst>(I) ||
+	       isa<CastInst>(I) || isa<GetElementPtrInst>(I) || isa<SelectInst>(I) ||
+	       isa<BranchInst>(I) || isa<SwitchInst>(I) || isa<ExtractValueInst>(I) ||
+	       isa<InsertValueInst>(I) || isa<ExtractElementInst>(I) ||
+	       isa<InsertElementInst>(I) || isa<ShuffleVectorInst>(I);
+}
+
+/*
+ * Executes compiled instructions from SF's next instruction onwards, jumping
+ * from each straight to the handler of the next (threaded dispatch), and stops
+ * before the first instruction that has to go through the visitor. All compiled
+ * instructions are local, so this never crosses an event. Returns false if the
+ * next instruction is not compiled.
+ */
+bool Interpreter::runBytecode(ExecutionContext &SF)
+{
+	using BC = FunctionBytecode;
+
+	const auto &bc = SF.Slots->getBytecode();
+	auto slot = SF.nextSlot();
+	const auto *in = &bc.getInst(slot);
+	if (in->op == BC::Fallback)
+		return false;
+
+	/* Frames set up before their function got new slots (see addMissingSlots()) */
+	if (SF.Values.size() < SF.Slots->size()) {
+		SF.Values.resize(SF.Slots->size());
+		SF.Defined.resize(SF.Slots->size());
+	}
+
+	static const void *const dispatch[] = {
+		&&fallback, &&add,    &&sub,	 &&mul,	    &&and_,    &&or_,	  &&xor_,
+		&&shl,	    &&lshr,   &&ashr,	 &&icmpEQ,  &&icmpNE,  &&icmpULT, &&icmpSLT,
+		&&icmpUGT,  &&icmpSGT, &&icmpULE, &&icmpSLE, &&icmpUGE, &&icmpSGE, &&trunc,
+		&&zext,	    &&sext,   &&select,	 &&br,	    &&condBr,
+	};
+	static_assert(std::size(dispatch) == BC::NumOpcodes, "missing bytecode handlers");
+
+	auto *vals = SF.Values.data();
+	auto get = [&](BC::Operand op) -> const GenericValue & {
+		return op >= 0 ? vals[op] : bc.getConstant(op);
+	};
+	auto edge = 0U;
+
+#define DISPATCH() goto *dispatch[in->op]
+#define NEXT()                                                                                     \
+	do {                                                                                       \
+		SF.Defined.set(slot);                                                              \
+		slot = in->next;                                                                   \
+		in = &bc.getInst(slot);                                                            \
+		DISPATCH();                                                                        \
+	} while (0)
+#define BINARY(EXPR)                                                                               \
+	do {                                                                                       \
+		const auto &a = get(in->ops[0]).IntVal;                                            \
+		const auto &b = get(in->ops[1]).IntVal;                                            \
+		vals[slot].IntVal = (EXPR);                                                        \
+		NEXT();                                                                            \
+	} while (0)
+
+	DISPATCH();
+add:
+	BINARY(a + b);
+sub:
+	BINARY(a - b);
+mul:
+	BINARY(a * b);
+and_:
+	BINARY(a & b);
+or_:
+	BINARY(a | b);
+xor_:
+	BINARY(a ^ b);
+shl:
+	BINARY(a.shl(getShiftAmount(b.getZExtValue(), a)));
+lshr:
+	BINARY(a.lshr(getShiftAmount(b.getZExtValue(), a)));
+ashr:
+	BINARY(a.ashr(getShiftAmount(b.getZExtValue(), a)));
+icmpEQ:
+	BINARY(APInt(1, a.eq(b)));
+icmpNE:
+	BINARY(APInt(1, a.ne(b)));
+icmpULT:
+	BINARY(APInt(1, a.ult(b)));
+icmpSLT:
+	BINARY(APInt(1, a.slt(b)));
+icmpUGT:
+	BINARY(APInt(1, a.ugt(b)));
+icmpSGT:
+	BINARY(APInt(1, a.sgt(b)));
+icmpULE:
+	BINARY(APInt(1, a.ule(b)));
+icmpSLE:
+	BINARY(APInt(1, a.sle(b)));
+icmpUGE:
+	BINARY(APInt(1, a.uge(b)));
+icmpSGE:
+	BINARY(APInt(1, a.sge(b)));
+trunc:
+	vals[slot].IntVal = get(in->ops[0]).IntVal.trunc(in->width);
+	NEXT();
+zext:
+	vals[slot].IntVal = get(in->ops[0]).IntVal.zext(in->width);
+	NEXT();
+sext:
+	vals[slot].IntVal = get(in->ops[0]).IntVal.sext(in->width);
+	NEXT();
+select:
+	vals[slot] = get(in->ops[0]).IntVal == 0 ? get(in->ops[2]) : get(in->ops[1]);
+	NEXT();
+br:
+	edge = in->succ[0];
+	goto jump;
+condBr:
+	edge = in->succ[get(in->ops[0]).IntVal == 0 ? 1 : 0];
+	goto jump;
+jump: {
+	/* PHI nodes read all their inputs before any of them is assigned */
+	const auto &e = bc.getEdge(edge);
+	SmallVector<GenericValue, 4> phiVals;
+	for (auto i = e.movesBegin; i < e.movesEnd; i++)
+		phiVals.push_back(get(bc.getMove(i).src));
+	for (auto i = e.movesBegin; i < e.movesEnd; i++) {
+		auto dst = bc.getMove(i).dst;
+		vals[dst] = std::move(phiVals[i - e.movesBegin]);
+		SF.Defined.set(dst);
+	}
+	SF.CurBB = e.dest;
+	slot = e.firstSlot;
+	in = &bc.getInst(slot);
+	/* Loops may consist of local instructions only */
+	if (driver->isHalting())
+		goto fallback;
+	DISPATCH();
+}
+fallback:
+	SF.CurInst = in->inst->getIterator();
+	SF.CurSlot = slot - 1; /* Hint at the next instruction (see enter()) */
+	return true;
+
+#undef BINARY
+#undef NEXT
+#undef DISPATCH
+}
+
 void Interpreter::run()
 {
+	/* Whether a thread runs until its next event-adding instruction once scheduled */
+	auto eventScheduling = driver->isEventScheduling();
+	auto bytecode = eventScheduling && useBytecode;
+
 	while (driver->scheduleNext()) {
 		if (driver->tryOptimizeScheduling(currPos()))
 			continue;
-		llvm::ExecutionContext &SF = ECStack().back();
-		llvm::Instruction &I = *SF.CurInst++;
-		visit(I);
+		auto local = false;
+		do {
+			llvm::ExecutionContext &SF = ECStack().back();
+			if (bytecode && runBytecode(SF)) {
+				local = true;
+				continue;
+			}
+			auto *I = &*SF.CurInst++;
+			SF.enter(I);
+			visit(*I);
+			local = isLocalInstruction(*I);
+		} while (eventScheduling && local && isLocalInstruction(*ECStack().back().CurInst) &&
+			 !driver->isHalting());
 	}
 	return;
 }
@@ -88,6 +88,48 @@ std::unique_ptr<InterpreterState> Interpreter::saveState()
 
 void Interpreter::restoreState(std::unique_ptr<InterpreterState> s) { dynState = std::move(*s); }
 
+std::optional<ThreadSnapshot> Interpreter::takeThreadSnapshot() const
+{
+	/* Dependencies and file-system state are not per-thread */
+	if (getDepTracker() || MI->fsInfo.fileTyp)
+		return std::nullopt;
+
+	auto &thr = getCurThr();
+	if (thr.ECStack.empty() || thr.globalInstructions == 0)
+		return std::nullopt;
+
+	auto &SF = thr.ECStack.back();
+	if (SF.CurInst == SF.CurBB->begin())
+		return std::nullopt;
+	auto &I = *std::prev(SF.CurInst);
+	if (!isa<LoadInst>(I) && !isa<AtomicCmpXchgInst>(I) && !isa<AtomicRMWInst>(I))
+		return std::nullopt;
+
+	/* Rewind the thread to the beginning of I */
+	ThreadSnapshot s{.threadFun = thr.threadFun,
+			 .threadArg = thr.threadArg,
+			 .ECStack = thr.ECStack,
+			 .tls = thr.tls,
+			 .globalInstructions = thr.globalInstructions - 1,
+			 .rng = thr.rng};
+	--s.ECStack.back().CurInst;
+	if (thr.isMain())
+		s.AtExitHandlers = dynState.AtExitHandlers;
+	return {std::move(s)};
+}
+
+void Interpreter::restoreThreadSnapshot(int tid, const ThreadSnapshot &s)
+{
+	auto &thr = getThrById(tid);
+	BUG_ON(thr.threadFun != s.threadFun || thr.isBlocked());
+	thr.ECStack = s.ECStack;
+	thr.tls = s.tls;
+	thr.globalInstructions = s.globalInstructions;
+	thr.rng = s.rng;
+	if (thr.isMain())
+		dynState.AtExitHandlers = s.AtExitHandlers;
+}
+
 void Interpreter::resetThread(unsigned int id)
 {
 	auto &thr = getThrById(id);
@@ -154,6 +196,19 @@ Thread &Interpreter::createAddMainThread()
 	return addNewThread(std::move(main));
 }
 
+void Interpreter::initFrame(ExecutionContext &SF, Function *F)
+{
+	SF.CurFunction = F;
+	SF.CurBB = &F->front();
+	SF.CurInst = SF.CurBB->begin();
+	auto it = functionSlots.find(F);
+	BUG_ON(it == functionSlots.end());
+	SF.Slots = it->second.get();
+	SF.CurSlot = 0;
+	SF.Values.resize(SF.Slots->size());
+	SF.Defined.resize(SF.Slots->size());
+}
+
 /* Creates an entry for another thread */
 Thread &Interpreter::createAddNewThread(llvm::Function *F, SVal arg, int tid, int pid,
 					const llvm::ExecutionContext &SF)
@@ -359,9 +414,18 @@ Interpreter::Interpreter(std::unique_ptr<Module> M, std::unique_ptr<ModuleInfo>
 
 	auto mod = Modules.back().get();
 
+	/* Number the values of each function, so that stack frames can store them densely */
+	for (auto &F : *mod) {
+		if (!F.isDeclaration())
+			functionSlots[&F] = std::make_unique<FunctionSlots>(F);
+	}
+
 	/* Set up a dependency tracker if the model requires it */
 	if (userConf->isDepTrackingModel)
-		dynState.depTracker = std::make_unique<DepTracker>();
+		dynState.depTracker = std::make_unique<DepTracker>(*mod);
+
+	/* Compiled instructions do not track dependencies */
+	useBytecode = userConf->bytecode && !userConf->isDepTrackingModel;
 
 	collectStaticAddresses(alloctor);
 
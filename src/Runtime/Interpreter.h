@@ -42,6 +42,7 @@
 #include "ADT/View.hpp"
 #include "ADT/value_ptr.hpp"
 #include "Config/Config.hpp"
+#include "Runtime/Bytecode.hpp"
 #include "Runtime/DepTracker.hpp"
 #include "Runtime/InterpreterEnumAPI.hpp"
 #include "Static/LLVMUtils.hpp"
@@ -53,11 +54,15 @@
 #include "Support/ThreadInfo.hpp"
 #include "Verification/VerificationError.hpp"
 
+#include <llvm/ADT/BitVector.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/GenericValue.h>
 #include <llvm/IR/DataLayout.h>
 #include <llvm/IR/DebugInfo.h>
 #include <llvm/IR/Function.h>
+#include <llvm/IR/InstIterator.h>
 #include <llvm/IR/InstVisitor.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/Support/DataTypes.h>
@@ -130,20 +135,184 @@ public:
 	const Allocas &get() const { return allocas; }
 };
 
+// FunctionSlots - Dense numbering of the arguments and instructions of a
+// function, computed once before the exploration. Stack frames store the
+// values of their function in a plane indexed by these slots, so that SSA
+// reads and writes need neither tree lookups nor allocations. The slots of
+// each instruction's local operands are resolved along with the numbering,
+// so that executing an instruction needs at most one hash lookup.
+//
+class FunctionSlots {
+public:
+	/* A local operand (argument or instruction) of an instruction and its slot */
+	using OperandSlot = std::pair<const Value *, unsigned>;
+
+	explicit FunctionSlots(Function &F)
+	{
+		for (auto &arg : F.args())
+			addSlot(&arg);
+		for (auto &I : instructions(F))
+			addSlot(&I);
+		resolveOperands(F);
+		bytecode = FunctionBytecode(F, *this);
+	}
+
+	unsigned size() const { return values.size(); }
+
+	unsigned getSlot(const Value *V) const
+	{
+		auto it = slots.find(V);
+		BUG_ON(it == slots.end());
+		return it->second;
+	}
+
+	Value *getValue(unsigned slot) const { return values[slot]; }
+
+	/* Returns the compiled instructions of the function (indexed by slot) */
+	const FunctionBytecode &getBytecode() const { return bytecode; }
+
+	/* Returns the local operands of the instruction numbered SLOT */
+	ArrayRef<OperandSlot> getOperandSlots(unsigned slot) const
+	{
+		auto begin = opBegin[slot];
+		return ArrayRef<OperandSlot>(operands).slice(begin, opBegin[slot + 1] - begin);
+	}
+
+	/* Numbers the instructions of F added after the numbering (e.g., by
+	 * lowering intrinsics); existing slots remain valid */
+	void addMissingSlots(Function &F)
+	{
+		/* Forget erased instructions first, as new ones may reuse their addresses */
+		llvm::DenseSet<const Value *> live;
+		for (auto &I : instructions(F))
+			live.insert(&I);
+		for (auto i = F.arg_size(); i < values.size(); i++) {
+			if (values[i] && !live.count(values[i])) {
+				slots.erase(values[i]);
+				values[i] = nullptr;
+			}
+		}
+
+		for (auto &I : instructions(F))
+			if (!slots.count(&I))
+				addSlot(&I);
+		/* Lowering also rewrites the operands of the users of the lowered call */
+		resolveOperands(F);
+		bytecode = FunctionBytecode(F, *this);
+	}
+
+private:
+	void addSlot(Value *V)
+	{
+		slots[V] = values.size();
+		values.push_back(V);
+	}
+
+	/* (Re)computes the operand slots of all the instructions of F; slots of
+	 * arguments and erased instructions get no operands */
+	void resolveOperands(Function &F)
+	{
+		std::vector<std::vector<OperandSlot>> ops(values.size());
+		for (auto &I : instructions(F)) {
+			auto &iOps = ops[getSlot(&I)];
+			for (auto *op : I.operand_values()) {
+				if (!isa<Argument>(op) && !isa<Instruction>(op))
+					continue;
+				if (llvm::none_of(iOps, [&](auto &o) { return o.first == op; }))
+					iOps.emplace_back(op, getSlot(op));
+			}
+		}
+
+		operands.clear();
+		opBegin.clear();
+		for (auto &iOps : ops) {
+			opBegin.push_back(operands.size());
+			operands.insert(operands.end(), iOps.begin(), iOps.end());
+		}
+		opBegin.push_back(operands.size());
+	}
+
+	llvm::DenseMap<const Value *, unsigned> slots;
+	std::vector<Value *> values;
+
+	/* Local operands of all slots, stored contiguously; those of slot S
+	 * are in [opBegin[S], opBegin[S + 1]) */
+	std::vector<OperandSlot> operands;
+	std::vector<unsigned> opBegin;
+
+	FunctionBytecode bytecode;
+};
+
 // ExecutionContext struct - This struct represents one stack frame currently
 // executing.
 //
 struct ExecutionContext {
-	Function *CurFunction;			// The currently executing function
-	BasicBlock *CurBB;			// The currently executing BB
-	BasicBlock::iterator CurInst;		// The next instruction to execute
-	CallInstWrapper Caller;			// Holds the call that called subframes.
-						// NULL if main func or debugger invoked fn
-	std::map<Value *, GenericValue> Values; // LLVM values used in this invocation
-	std::vector<GenericValue> VarArgs;	// Values passed through an ellipsis
-	AllocaHolder Allocas;			// Track memory allocated by alloca
-
-	ExecutionContext() : CurFunction(nullptr), CurBB(nullptr), CurInst(nullptr) {}
+	Function *CurFunction;		    // The currently executing function
+	BasicBlock *CurBB;		    // The currently executing BB
+	BasicBlock::iterator CurInst;	    // The next instruction to execute
+	CallInstWrapper Caller;		    // Holds the call that called subframes.
+					    // NULL if main func or debugger invoked fn
+	const FunctionSlots *Slots;	    // Slot numbering of CurFunction
+	unsigned CurSlot;		    // Slot of the instruction being executed
+	ValuePlaneTy Values;		    // LLVM values used in this invocation (by slot)
+	llvm::BitVector Defined;	    // Slots assigned in this invocation
+	std::vector<GenericValue> VarArgs;  // Values passed through an ellipsis
+	AllocaHolder Allocas;		    // Track memory allocated by alloca
+
+	ExecutionContext()
+		: CurFunction(nullptr), CurBB(nullptr), CurInst(nullptr), Slots(nullptr),
+		  CurSlot(0)
+	{}
+
+	/* Records that I is about to be executed. Instructions within a block
+	 * have consecutive slots, so the lookup is usually avoided */
+	void enter(const Instruction *I)
+	{
+		auto next = CurSlot + 1;
+		CurSlot = (next < Slots->size() && Slots->getValue(next) == I) ? next
+									       : Slots->getSlot(I);
+	}
+
+	/* Returns the slot of the instruction to be executed next (CurInst) */
+	unsigned nextSlot() const
+	{
+		auto next = CurSlot + 1;
+		return (next < Slots->size() && Slots->getValue(next) == &*CurInst)
+			       ? next
+			       : Slots->getSlot(&*CurInst);
+	}
+
+	/* Returns the value of V (an argument or instruction of CurFunction) */
+	GenericValue &getValue(const Value *V) { return Values[getFrameSlot(V)]; }
+
+	/* Sets the value of V (an argument or instruction of CurFunction) */
+	void setValue(const Value *V, GenericValue Val)
+	{
+		auto slot = getFrameSlot(V);
+		Values[slot] = std::move(Val);
+		Defined.set(slot);
+	}
+
+private:
+	/* Returns V's slot, growing the frame if V was numbered after the frame was set up.
+	 * V is usually the current instruction or one of its operands, whose slots are
+	 * already resolved; CurSlot is only a hint, so a stale one costs a lookup */
+	unsigned getFrameSlot(const Value *V)
+	{
+		auto slot = [&] {
+			if (Slots->getValue(CurSlot) == V)
+				return CurSlot;
+			for (auto &[op, opSlot] : Slots->getOperandSlots(CurSlot))
+				if (op == V)
+					return opSlot;
+			return Slots->getSlot(V);
+		}();
+		if (slot >= Values.size()) {
+			Values.resize(Slots->size());
+			Defined.resize(Slots->size());
+		}
+		return slot;
+	}
 };
 
 /* The different reasons a thread might block */
@@ -224,6 +393,19 @@ protected:
 
 llvm::raw_ostream &operator<<(llvm::raw_ostream &s, const Thread &thr);
 
+/* Opt: The part of a thread's state that changes as the thread runs, captured
+ * right before one of its instructions. Restoring a snapshot resumes the thread
+ * without re-executing the instructions that precede it */
+struct ThreadSnapshot {
+	llvm::Function *threadFun;
+	SVal threadArg;
+	std::vector<llvm::ExecutionContext> ECStack;
+	std::unordered_map<const void *, llvm::GenericValue> tls;
+	unsigned int globalInstructions;
+	Thread::MyRNG rng;
+	std::vector<Function *> AtExitHandlers; /* Only used for the main thread */
+};
+
 /* Pers: The state of the program -- i.e., part of the program being interpreted */
 enum class ProgramState { Ctors, Main, Dtors, Recovery };
 
@@ -307,6 +489,12 @@ protected:
 
 	IntrinsicLowering *IL;
 
+	/* Slot numbering of all defined functions */
+	llvm::DenseMap<const Function *, std::unique_ptr<FunctionSlots>> functionSlots;
+
+	/* Whether local instructions run as bytecode (see FunctionBytecode) */
+	bool useBytecode = false;
+
 	/*** Dynamic components (change during verification) ***/
 
 	DynamicComponents dynState;
@@ -319,6 +507,15 @@ public:
 	std::unique_ptr<InterpreterState> saveState();
 	void restoreState(std::unique_ptr<InterpreterState>);
 
+	/* Opt: Takes a snapshot of the current thread, as it was right before the
+	 * instruction it is executing. Only loads, CASes, and RMWs are supported,
+	 * as their first event is a read (and snapshots are only meant for reads).
+	 * Returns nullopt if the thread's state cannot be captured that way */
+	std::optional<ThreadSnapshot> takeThreadSnapshot() const;
+
+	/* Opt: Resumes thread TID from snapshot S */
+	void restoreThreadSnapshot(int tid, const ThreadSnapshot &s);
+
 	Thread &constructAddThreadFromInfo(const ThreadInfo &ti)
 	{
 		auto *calledFun =
@@ -326,11 +523,9 @@ public:
 		BUG_ON(!calledFun);
 		ExecutionContext SF;
 
-		SF.CurFunction = calledFun;
-		SF.CurBB = &calledFun->front();
-		SF.CurInst = SF.CurBB->begin();
-
-		SF.Values[&*calledFun->arg_begin()] = PTR_TO_GV(ti.arg.get());
+		initFrame(SF, calledFun);
+		if (!calledFun->arg_empty())
+			SF.setValue(&*calledFun->arg_begin(), PTR_TO_GV(ti.arg.get()));
 		return createAddNewThread(calledFun, ti.arg, ti.id, ti.parentId, SF);
 	}
 	void setExecutionContext(const std::vector<ThreadInfo> &tis)
@@ -399,6 +594,9 @@ public:
 	/* Pers: Does cleanups after the recovery routine has run */
 	void cleanupRecoveryRoutine(int tid);
 
+	/* Prepares SF for executing F from its entry */
+	void initFrame(ExecutionContext &SF, Function *F);
+
 	/* Creates a new thread and adds it to the thread list */
 	Thread &createAddNewThread(llvm::Function *F, SVal arg, int tid, int pid,
 				   const llvm::ExecutionContext &SF);
@@ -627,6 +825,9 @@ private: // Helper functions
 	//
 	void SwitchToNewBasicBlock(BasicBlock *Dest, ExecutionContext &SF);
 
+	/* Runs compiled instructions of SF up to the first one needing the visitor */
+	bool runBytecode(ExecutionContext &SF);
+
 	void *getPointerToFunction(Function *F) { return (void *)F; }
 	void *getPointerToBasicBlock(BasicBlock *BB) { return (void *)BB; }
 
@@ -45,6 +45,26 @@
 #include "Support/Error.hpp"
 #include "Support/SExprVisitor.hpp"
 
+#ifdef HAVE_LIBCLANG_CPP
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/DiagnosticOptions.h>
+#include <clang/CodeGen/CodeGenAction.h>
+#include <clang/Driver/Compilation.h>
+#include <clang/Driver/Driver.h>
+#include <clang/Driver/Job.h>
+#include <clang/Driver/Tool.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/CompilerInvocation.h>
+#include <clang/Frontend/TextDiagnosticPrinter.h>
+#if LLVM_VERSION_MAJOR < 17
+#include <llvm/Support/Host.h>
+#else
+#include <llvm/TargetParser/Host.h>
+#endif
+#if LLVM_VERSION_MAJOR >= 20
+#include <llvm/Support/VirtualFileSystem.h>
+#endif
+#endif
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/IRPrintingPasses.h>
@@ -78,6 +98,55 @@ auto parseLLVMModule(const std::string &filename, const std::unique_ptr<llvm::LL
 	return std::move(mod);
 }
 
+#ifdef HAVE_LIBCLANG_CPP
+auto compileLLVMModule(const std::vector<std::string> &args,
+		       const std::unique_ptr<llvm::LLVMContext> &ctx) -> std::unique_ptr<llvm::Module>
+{
+	llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> diagOpts(new clang::DiagnosticOptions());
+	llvm::IntrusiveRefCntPtr<clang::DiagnosticIDs> diagIDs(new clang::DiagnosticIDs());
+	clang::DiagnosticsEngine diags(diagIDs, &*diagOpts,
+				       new clang::TextDiagnosticPrinter(llvm::errs(), &*diagOpts));
+
+	/* Have the driver translate ARGS into a frontend invocation, exactly as if we
+	 * were CLANGPATH (so that e.g., clang's resource directory is found) */
+	std::vector<const char *> argv = {CLANGPATH};
+	for (const auto &arg : args)
+		argv.push_back(arg.c_str());
+
+	clang::driver::Driver driver(CLANGPATH, llvm::sys::getDefaultTargetTriple(), diags);
+	std::unique_ptr<clang::driver::Compilation> comp(driver.BuildCompilation(argv));
+	if (!comp || comp->containsError())
+		return nullptr;
+
+	/* With -S -emit-llvm, there is a single job: a frontend (-cc1) invocation */
+	const auto &jobs = comp->getJobs();
+	ERROR_ON(jobs.size() != 1 ||
+			 llvm::StringRef(jobs.begin()->getCreator().getName()) != "clang",
+		 "Unexpected compilation jobs for in-process compilation!\n");
+	llvm::ArrayRef<const char *> ccArgs(jobs.begin()->getArguments());
+	BUG_ON(ccArgs.empty() || llvm::StringRef(ccArgs.front()) != "-cc1");
+
+	/* Run the frontend, keeping the generated module instead of printing it */
+	clang::CompilerInstance ci;
+	if (!clang::CompilerInvocation::CreateFromArgs(ci.getInvocation(), ccArgs.drop_front(),
+						       diags))
+		return nullptr;
+	/* The driver passes -disable-free, as the process would exit right after;
+	 * we may go on to compile more inputs (see -batch) */
+	ci.getFrontendOpts().DisableFree = false;
+#if LLVM_VERSION_MAJOR < 20
+	ci.createDiagnostics();
+#else
+	ci.createDiagnostics(*llvm::vfs::getRealFileSystem());
+#endif
+
+	clang::EmitLLVMOnlyAction action(ctx.get());
+	if (!ci.ExecuteAction(action))
+		return nullptr;
+	return action.takeModule();
+}
+#endif
+
 auto cloneModule(const std::unique_ptr<llvm::Module> &mod,
 		 const std::unique_ptr<llvm::LLVMContext> &ctx) -> std::unique_ptr<llvm::Module>
 {
@@ -25,6 +25,8 @@
 
 #include <llvm/IR/Module.h>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace LLVMModule {
 
@@ -32,6 +34,13 @@ namespace LLVMModule {
 std::unique_ptr<llvm::Module> parseLLVMModule(const std::string &filename,
 					      const std::unique_ptr<llvm::LLVMContext> &ctx);
 
+#ifdef HAVE_LIBCLANG_CPP
+/** Compiles a C/C++ input into CTX, as clang would with the (driver) arguments ARGS.
+ * Returns nullptr if compilation fails (errors are reported to the user) */
+std::unique_ptr<llvm::Module> compileLLVMModule(const std::vector<std::string> &args,
+						const std::unique_ptr<llvm::LLVMContext> &ctx);
+#endif
+
 /** Clones MOD into CTX */
 std::unique_ptr<llvm::Module> cloneModule(const std::unique_ptr<llvm::Module> &mod,
 					  const std::unique_ptr<llvm::LLVMContext> &ctx);
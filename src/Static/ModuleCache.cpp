@@ -0,0 +1,263 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#include "ModuleCache.hpp"
+#include "Support/BinaryIO.hpp"
+#include "Support/Error.hpp"
+#include "config.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/SHA1.h>
+
+#include <cctype>
+
+namespace fs = llvm::sys::fs;
+
+/*
+ * An entry consists of the magic number and its key, followed by the input's
+ * dependencies (path and digest), the module's bitcode, and the module's info.
+ * Bump the version whenever the format (or ModuleInfo's serialization) changes.
+ */
+static constexpr uint32_t cacheMagic = 0x434d4347; /* "GCMC" */
+static constexpr uint32_t cacheVersion = 1;
+
+/** Returns a (hex) digest of DATA */
+static auto digest(llvm::StringRef data) -> std::string
+{
+	return llvm::toHex(llvm::SHA1::hash(llvm::arrayRefFromStringRef(data)), true);
+}
+
+static auto readFile(const std::string &path) -> std::unique_ptr<llvm::MemoryBuffer>
+{
+	auto bufOrErr = llvm::MemoryBuffer::getFile(path);
+	return bufOrErr ? std::move(*bufOrErr) : nullptr;
+}
+
+/** Identifies this GenMC build: a digest of the running executable, so that
+ * any rebuild (even of an uncommitted tree) invalidates all entries.
+ * Returns an empty string if the executable cannot be read */
+static auto getBuildId() -> std::string
+{
+	static int anchor;
+	auto exe = fs::getMainExecutable(PACKAGE_NAME, &anchor);
+	auto buf = exe.empty() ? nullptr : readFile(exe);
+	return buf ? digest(buf->getBuffer()) : "";
+}
+
+ModuleCache::ModuleCache(const std::shared_ptr<const Config> &conf, const std::string &command)
+	: dir(*conf->moduleCacheDir)
+{
+	auto input = readFile(conf->inputFile);
+	auto buildId = getBuildId();
+	if (!input || buildId.empty())
+		return;
+
+	std::string material;
+	llvm::raw_string_ostream ms(material);
+	ms << PACKAGE_VERSION << '\0' << buildId << '\0' << LLVM_VERSION << '\0' << cacheVersion
+	   << '\0';
+	ms << (conf->inputFromBitcodeFile ? "bitcode" : command) << '\0';
+	ms << (conf->compileInProcess ? "in-process" : "external") << '\0';
+	ms << conf->inputFile << '\0';
+
+	/* Everything that affects the transformation passes */
+	ms << (conf->unroll.has_value() ? std::to_string(*conf->unroll) : "-") << '\0';
+	for (const auto &fun : conf->noUnrollFuns)
+		ms << fun << ',';
+	ms << '\0';
+	for (auto opt : {conf->castElimination, conf->inlineFunctions, conf->loopJumpThreading,
+			 conf->spinAssume, conf->codeCondenser, conf->loadAnnot,
+			 conf->assumePropagation, conf->confirmAnnot, conf->mmDetector,
+			 conf->checkLiveness})
+		ms << (opt ? '1' : '0');
+	ms << '\0' << input->getBuffer();
+	key = digest(ms.str());
+
+	if (!conf->inputFromBitcodeFile) {
+		llvm::SmallString<128> path;
+		if (!fs::createTemporaryFile("__genmc", "d", path))
+			depFile = std::string(path.str());
+	}
+}
+
+auto ModuleCache::getEntryFile() const -> std::string
+{
+	llvm::SmallString<128> path(dir);
+	llvm::sys::path::append(path, key + ".gmc");
+	return std::string(path.str());
+}
+
+auto ModuleCache::lookup(const std::unique_ptr<llvm::LLVMContext> &ctx,
+			 std::unique_ptr<llvm::Module> &mod, std::unique_ptr<ModuleInfo> &MI)
+	-> bool
+{
+	if (key.empty())
+		return false;
+
+	auto buf = readFile(getEntryFile());
+	if (!buf)
+		return false;
+
+	BinaryReader r(buf->getBufferStart(), buf->getBufferEnd());
+	if (r.read<uint32_t>() != cacheMagic || r.readString() != key)
+		return false;
+
+	/* The entry is stale if any of the included headers changed */
+	for (auto n = r.readSize(); n > 0; --n) {
+		auto path = r.readString();
+		auto hash = r.readString();
+		auto dep = readFile(path);
+		if (!dep || digest(dep->getBuffer()) != hash)
+			return false;
+	}
+
+	auto bitcode = r.readString();
+	auto modOrErr =
+		llvm::parseBitcodeFile(llvm::MemoryBufferRef(bitcode, getEntryFile()), *ctx);
+	if (!modOrErr) {
+		llvm::consumeError(modOrErr.takeError());
+		return false;
+	}
+
+	/* IDs are assigned deterministically, so the info can be restored as is */
+	mod = std::move(*modOrErr);
+	MI = std::make_unique<ModuleInfo>(*mod);
+	deserialize(r, *MI);
+	ERROR_ON(!r.atEnd(), "Module cache entry " + getEntryFile() + " is corrupted!\n");
+	return true;
+}
+
+auto ModuleCache::readDependencies() const -> std::optional<std::vector<std::string>>
+{
+	std::vector<std::string> deps;
+	if (depFile.empty())
+		return deps;
+
+	auto buf = readFile(depFile);
+	if (!buf)
+		return std::nullopt;
+
+	/* A make rule: "target: dep1 dep2 \<newline> dep3 ..." */
+	auto rule = buf->getBuffer();
+	auto pos = rule.find(": ");
+	if (pos == llvm::StringRef::npos)
+		return std::nullopt;
+
+	std::string cur;
+	for (auto i = pos + 2; i < rule.size(); i++) {
+		auto c = rule[i];
+		if (c == '\\' && i + 1 < rule.size()) {
+			if (rule[i + 1] == '\n') {
+				++i;
+				continue;
+			}
+			if (rule[i + 1] == ' ' || rule[i + 1] == '#' || rule[i + 1] == '\\') {
+				cur += rule[++i];
+				continue;
+			}
+		}
+		if (c == '$' && i + 1 < rule.size() && rule[i + 1] == '$') {
+			cur += rule[++i];
+			continue;
+		}
+		if (std::isspace(static_cast<unsigned char>(c))) {
+			if (!cur.empty())
+				deps.push_back(std::move(cur));
+			cur.clear();
+			continue;
+		}
+		cur += c;
+	}
+	if (!cur.empty())
+		deps.push_back(std::move(cur));
+	return deps;
+}
+
+void ModuleCache::store(const llvm::Module &mod, const ModuleInfo &MI)
+{
+	if (key.empty())
+		return;
+
+	/* Caching is best-effort: a failure to store an entry only costs a recompilation */
+	auto deps = readDependencies();
+	if (!deps.has_value()) {
+		WARN("Could not determine the dependencies of the input; not caching it.\n");
+		return;
+	}
+	std::vector<std::pair<std::string, std::string>> hashes;
+	for (auto &path : *deps) {
+		auto dep = readFile(path);
+		if (!dep) {
+			WARN("Could not read dependency " + path + "; not caching the input.\n");
+			return;
+		}
+		hashes.emplace_back(std::move(path), digest(dep->getBuffer()));
+	}
+
+	auto file = getEntryFile();
+	int fd = -1;
+	llvm::SmallString<128> tmpFile;
+	if (fs::create_directories(dir) ||
+	    fs::createUniqueFile(file + ".tmp-%%%%%%", fd, tmpFile)) {
+		WARN("Could not create a module cache entry in " + dir + "\n");
+		return;
+	}
+
+	/* Write to a temporary file first, so that concurrent runs never see a partial entry */
+	{
+		llvm::raw_fd_ostream os(fd, /* shouldClose */ true);
+		BinaryWriter w(os);
+		w.write(cacheMagic);
+		w.writeString(key);
+		w.writeSize(hashes.size());
+		for (const auto &[path, hash] : hashes) {
+			w.writeString(path);
+			w.writeString(hash);
+		}
+
+		std::string bitcode;
+		llvm::raw_string_ostream bs(bitcode);
+		llvm::WriteBitcodeToFile(mod, bs);
+		w.writeString(bs.str());
+
+		serialize(w, MI);
+		os.close();
+		if (os.has_error()) {
+			os.clear_error();
+			fs::remove(tmpFile);
+			WARN("Could not write module cache entry " + file + "\n");
+			return;
+		}
+	}
+	if (fs::rename(tmpFile, file)) {
+		fs::remove(tmpFile);
+		WARN("Could not write module cache entry " + file + "\n");
+	}
+}
+
+ModuleCache::~ModuleCache()
+{
+	if (!depFile.empty())
+		fs::remove(depFile);
+}
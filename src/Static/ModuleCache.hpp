@@ -0,0 +1,88 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#ifndef GENMC_MODULE_CACHE_HPP
+#define GENMC_MODULE_CACHE_HPP
+
+#include "Config/Config.hpp"
+#include "Static/ModuleInfo.hpp"
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * A persistent, content-addressed cache of compiled and transformed inputs,
+ * so that repeated runs on the same program skip both compilation and the
+ * transformation passes.
+ *
+ * Entries are keyed on the contents of the input file, the compilation command
+ * and mode, the transformation options, the GenMC build, and the LLVM version.
+ * Each entry also records the headers the input included (as reported by the
+ * compiler) along with digests of their contents, and is only reused if these
+ * are unchanged.
+ */
+class ModuleCache {
+
+public:
+	/*** Constructors ***/
+
+	/** Creates a cache for CONF's input, compiled with COMMAND */
+	ModuleCache(const std::shared_ptr<const Config> &conf, const std::string &command);
+	ModuleCache(const ModuleCache &) = delete;
+	auto operator=(const ModuleCache &) -> ModuleCache & = delete;
+
+	/*** Operations ***/
+
+	/** Returns the file the compiler should list the input's dependencies in */
+	auto getDepFile() const -> const std::string & { return depFile; }
+
+	/** Loads the cached module (and its info) into CTX; returns false on a miss */
+	auto lookup(const std::unique_ptr<llvm::LLVMContext> &ctx,
+		    std::unique_ptr<llvm::Module> &mod, std::unique_ptr<ModuleInfo> &MI) -> bool;
+
+	/** Caches the (transformed) module MOD along with its info MI */
+	void store(const llvm::Module &mod, const ModuleInfo &MI);
+
+	/*** Destructor ***/
+
+	~ModuleCache();
+
+private:
+	/** Returns the path of the entry for the input */
+	auto getEntryFile() const -> std::string;
+
+	/** Reads the dependencies the compiler listed in the dependency file
+	 * (nullopt if the compiler was supposed to list them but did not) */
+	auto readDependencies() const -> std::optional<std::vector<std::string>>;
+
+	/** The directory entries are stored in */
+	std::string dir;
+
+	/** The key of the input's entry (empty if the input or GenMC cannot be read) */
+	std::string key;
+
+	/** The dependency file the compiler writes (if compiling from source) */
+	std::string depFile;
+};
+
+#endif /* GENMC_MODULE_CACHE_HPP */
@@ -20,6 +20,7 @@
 
 #include "ModuleInfo.hpp"
 #include "Static/LLVMUtils.hpp"
+#include "Support/BinaryIO.hpp"
 #include "Support/SExpr.hpp"
 #include <llvm/IR/InstIterator.h>
 #include <llvm/IR/Module.h>
@@ -115,3 +116,74 @@ std::unique_ptr<ModuleInfo> ModuleInfo::clone(const llvm::Module &mod) const
 
 	return info;
 }
+
+template <typename Map> static void serializeNameMap(BinaryWriter &w, const Map &m)
+{
+	w.writeSize(m.size());
+	for (const auto &[k, info] : m) {
+		if constexpr (std::is_same_v<typename Map::key_type, std::string>)
+			w.writeString(k);
+		else
+			w.write(k);
+		serialize(w, *info);
+	}
+}
+
+template <typename Map> static void deserializeNameMap(BinaryReader &r, Map &m)
+{
+	m.clear();
+	for (auto n = r.readSize(); n > 0; --n) {
+		typename Map::key_type k;
+		if constexpr (std::is_same_v<typename Map::key_type, std::string>)
+			k = r.readString();
+		else
+			k = r.read<typename Map::key_type>();
+		auto info = std::make_shared<NameInfo>();
+		deserialize(r, *info);
+		m[k] = std::move(info);
+	}
+}
+
+void serialize(BinaryWriter &w, const ModuleInfo &MI)
+{
+	serializeNameMap(w, MI.varInfo.globalInfo);
+	serializeNameMap(w, MI.varInfo.localInfo);
+	serializeNameMap(w, MI.varInfo.internalInfo);
+
+	w.writeSize(MI.annotInfo.annotMap.size());
+	for (const auto &[id, annot] : MI.annotInfo.annotMap) {
+		w.write(id);
+		serialize(w, *annot);
+	}
+
+	w.writeSize(MI.fsInfo.filenames.size());
+	for (const auto &name : MI.fsInfo.filenames)
+		w.writeString(name);
+
+	w.write(MI.determinedMM.has_value());
+	if (MI.determinedMM.has_value())
+		w.write(*MI.determinedMM);
+}
+
+void deserialize(BinaryReader &r, ModuleInfo &MI)
+{
+	deserializeNameMap(r, MI.varInfo.globalInfo);
+	deserializeNameMap(r, MI.varInfo.localInfo);
+	deserializeNameMap(r, MI.varInfo.internalInfo);
+
+	MI.annotInfo.annotMap.clear();
+	for (auto n = r.readSize(); n > 0; --n) {
+		auto id = r.read<ModuleID::ID>();
+		std::unique_ptr<SExpr<ModuleID::ID>> annot;
+		deserialize(r, annot);
+		MI.annotInfo.annotMap[id] = std::move(annot);
+	}
+
+	MI.fsInfo.filenames.clear();
+	for (auto n = r.readSize(); n > 0; --n)
+		MI.fsInfo.filenames.insert(r.readString());
+
+	MI.determinedMM.reset();
+	if (r.read<bool>())
+		MI.determinedMM = r.read<ModelType>();
+}
@@ -43,6 +43,9 @@ namespace llvm {
 class Value;
 };
 
+class BinaryWriter;
+class BinaryReader;
+
 /*
  * Information kept about the module under test by the interpreter.
  */
@@ -160,4 +163,9 @@ private:
 	const llvm::Module &mod;
 };
 
+/** Serializes the information collected during the transformation of a module
+ * (i.e., everything but its IDs, which are recomputed when the module is loaded) */
+void serialize(BinaryWriter &w, const ModuleInfo &MI);
+void deserialize(BinaryReader &r, ModuleInfo &MI);
+
 #endif /* GENMC_MODULE_INFO_HPP */
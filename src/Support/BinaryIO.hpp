@@ -0,0 +1,135 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#ifndef GENMC_BINARY_IO_HPP
+#define GENMC_BINARY_IO_HPP
+
+#include "Support/Error.hpp"
+#include <llvm/Support/raw_ostream.h>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * A minimal binary serializer. Values are written in host byte order,
+ * so the output is only meant to be read back on the same platform
+ * (e.g., to checkpoint and resume an exploration).
+ */
+class BinaryWriter {
+
+public:
+	explicit BinaryWriter(llvm::raw_ostream &os) : os(os) {}
+
+	template <typename T> void write(const T &val)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		auto bytes = std::bit_cast<std::array<char, sizeof(T)>>(val);
+		os.write(bytes.data(), bytes.size());
+	}
+
+	/** Sizes (of containers etc) are always written as 64-bit values */
+	void writeSize(std::size_t n) { write<uint64_t>(n); }
+
+	void writeString(const std::string &s)
+	{
+		writeSize(s.size());
+		os.write(s.data(), s.size());
+	}
+
+	/** Writes a size-prefixed sequence of trivially copyable values */
+	template <typename Range> void writeRange(const Range &r)
+	{
+		writeSize(std::size(r));
+		for (const auto &x : r)
+			write(x);
+	}
+
+private:
+	llvm::raw_ostream &os;
+};
+
+/**
+ * Reads back what a BinaryWriter wrote. The reader does not own
+ * the underlying buffer; reading past its end is a user error
+ * (i.e., a truncated or corrupted file).
+ */
+class BinaryReader {
+
+public:
+	BinaryReader(const char *begin, const char *end) : cur(begin), end(end) {}
+
+	template <typename T> auto read() -> T
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		std::array<char, sizeof(T)> bytes;
+		std::memcpy(bytes.data(), take(sizeof(T)), sizeof(T));
+		return std::bit_cast<T>(bytes);
+	}
+
+	auto readSize() -> std::size_t { return read<uint64_t>(); }
+
+	/** Reads the size of a sequence whose elements take at least ELEMBYTES
+	 * bytes each, and checks that the input can hold that many. Sizes used
+	 * for allocations should be read this way, so that a corrupted size
+	 * is reported instead of exhausting the memory */
+	auto readSize(std::size_t elemBytes) -> std::size_t
+	{
+		auto n = readSize();
+		ERROR_ON(elemBytes > 0 && n > static_cast<std::size_t>(end - cur) / elemBytes,
+			 "Unexpected end of binary input! Is the file corrupted?\n");
+		return n;
+	}
+
+	auto readString() -> std::string
+	{
+		auto n = readSize();
+		const auto *s = take(n);
+		return {s, n};
+	}
+
+	template <typename T> auto readVector() -> std::vector<T>
+	{
+		std::vector<T> v;
+		auto n = readSize(sizeof(T));
+		v.reserve(n);
+		for (auto i = 0U; i < n; i++)
+			v.push_back(read<T>());
+		return v;
+	}
+
+	auto atEnd() const -> bool { return cur == end; }
+
+private:
+	auto take(std::size_t n) -> const char *
+	{
+		ERROR_ON(static_cast<std::size_t>(end - cur) < n,
+			 "Unexpected end of binary input! Is the file corrupted?\n");
+		const auto *p = cur;
+		cur += n;
+		return p;
+	}
+
+	const char *cur;
+	const char *end;
+};
+
+#endif /* GENMC_BINARY_IO_HPP */
@@ -21,6 +21,7 @@
 #ifndef GENMC_HASH_HPP
 #define GENMC_HASH_HPP
 
+#include <cstdint>
 #include <functional>
 
 template <class T> inline void hash_combine(std::size_t &seed, const T &v)
@@ -28,4 +29,16 @@ template <class T> inline void hash_combine(std::size_t &seed, const T &v)
 	seed ^= std::hash<T>()(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
 
+/** Scrambles the bits of X (the finalizer of splitmix64). Unlike std::hash
+ * for integers, the result can be XOR-ed with other hashes safely */
+inline auto hash_mix(uint64_t x) -> uint64_t
+{
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+	return x;
+}
+
 #endif /* GENMC_HASH_HPP */
@@ -19,6 +19,7 @@
  */
 
 #include "NameInfo.hpp"
+#include "BinaryIO.hpp"
 
 /* Mark name at offset O as N */
 void NameInfo::addOffsetInfo(unsigned int o, std::string n)
@@ -53,3 +54,21 @@ llvm::raw_ostream &operator<<(llvm::raw_ostream &rhs, const NameInfo &info)
 		rhs << "" << kv.first << ": " << kv.second << "\n";
 	return rhs;
 }
+
+void serialize(BinaryWriter &w, const NameInfo &info)
+{
+	w.writeSize(info.info.size());
+	for (const auto &[offset, name] : info.info) {
+		w.write(offset);
+		w.writeString(name);
+	}
+}
+
+void deserialize(BinaryReader &r, NameInfo &info)
+{
+	info.info.clear();
+	for (auto n = r.readSize(); n > 0; --n) {
+		auto offset = r.read<unsigned>();
+		info.info.emplace_back(offset, r.readString());
+	}
+}
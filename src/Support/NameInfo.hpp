@@ -26,6 +26,9 @@
 
 #include <string>
 
+class BinaryWriter;
+class BinaryReader;
+
 /**
  * Represents naming information for a specific type/allocation
  */
@@ -48,6 +51,9 @@ public:
 
 	friend llvm::raw_ostream &operator<<(llvm::raw_ostream &rhs, const NameInfo &info);
 
+	friend void serialize(BinaryWriter &w, const NameInfo &info);
+	friend void deserialize(BinaryReader &r, NameInfo &info);
+
 private:
 	/*
 	 * We keep a map (Values -> (offset, name_at_offset)), and after
@@ -0,0 +1,508 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#include "ProcessPool.hpp"
+#include "Support/BinaryIO.hpp"
+#include "Support/Error.hpp"
+#include <llvm/Support/Endian.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ **                           Helpers
+ ******************************************************************************/
+
+/** Returns the encoding of whatever F writes */
+template <typename F> static auto encode(F &&f) -> std::string
+{
+	std::string buf;
+	llvm::raw_string_ostream os(buf);
+	BinaryWriter w(os);
+	f(w);
+	os.flush();
+	return buf;
+}
+
+/** Opens a TCP socket listening at (or connected to) ADDR.
+ * The host part may be omitted when listening, in which case
+ * only connections from the local machine are accepted */
+static auto openTCPSocket(const std::string &addr, bool listen) -> int
+{
+	auto colon = addr.rfind(':');
+	ERROR_ON(!listen && colon == std::string::npos, "Invalid address (host:port): " + addr + "\n");
+	auto host = colon == std::string::npos ? std::string("127.0.0.1") : addr.substr(0, colon);
+	auto port = colon == std::string::npos ? addr : addr.substr(colon + 1);
+
+	struct addrinfo hints {};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = listen ? AI_PASSIVE : 0;
+	struct addrinfo *res = nullptr;
+	if (auto err = getaddrinfo(host.c_str(), port.c_str(), &hints, &res))
+		ERROR("Could not resolve " + addr + ": " + gai_strerror(err) + "\n");
+
+	auto fd = -1;
+	for (auto *ai = res; ai && fd < 0; ai = ai->ai_next) {
+		fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+		if (fd < 0)
+			continue;
+
+		auto one = 1;
+		if (listen) {
+			setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+			if (bind(fd, ai->ai_addr, ai->ai_addrlen) == 0 && ::listen(fd, 64) == 0)
+				break;
+		} else if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+			setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+			break;
+		}
+		::close(fd);
+		fd = -1;
+	}
+	freeaddrinfo(res);
+	ERROR_ON(fd < 0, (listen ? "Could not listen at " : "Could not connect to ") + addr + ": " +
+				 std::strerror(errno) + "\n");
+	return fd;
+}
+
+/*******************************************************************************
+ **                           MessageChannel Class
+ ******************************************************************************/
+
+/* The header is a 32-bit kind and a 64-bit payload size, both little-endian */
+static constexpr size_t headerSize = 12;
+
+/* Payloads are never this large; a larger size indicates a corrupted stream */
+static constexpr uint64_t maxPayloadSize = 1ULL << 30;
+
+auto MessageChannel::send(MessageKind kind, const std::string &payload /* = "" */) -> bool
+{
+	auto sendAll = [&](const char *data, size_t len) {
+		while (len > 0) {
+			auto n = ::send(fd, data, len, MSG_NOSIGNAL);
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n <= 0)
+				return false;
+			data += n;
+			len -= n;
+		}
+		return true;
+	};
+
+	BUG_ON(payload.size() > maxPayloadSize);
+	std::array<char, headerSize> header;
+	llvm::support::endian::write32le(&header[0], static_cast<uint32_t>(kind));
+	llvm::support::endian::write64le(&header[4], payload.size());
+	return fd >= 0 && sendAll(header.data(), header.size()) &&
+	       sendAll(payload.data(), payload.size());
+}
+
+auto MessageChannel::receive(MessageKind &kind, std::string &payload) -> bool
+{
+	auto recvAll = [&](char *data, size_t len) {
+		while (len > 0) {
+			auto n = ::recv(fd, data, len, 0);
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n <= 0)
+				return false;
+			data += n;
+			len -= n;
+		}
+		return true;
+	};
+
+	std::array<char, headerSize> header;
+	if (fd < 0 || !recvAll(header.data(), header.size()))
+		return false;
+
+	auto rawKind = llvm::support::endian::read32le(&header[0]);
+	auto size = llvm::support::endian::read64le(&header[4]);
+	if (rawKind > static_cast<uint32_t>(MessageKind::Result) || size > maxPayloadSize)
+		return false;
+	kind = static_cast<MessageKind>(rawKind);
+	payload.resize(size);
+	return recvAll(payload.data(), payload.size());
+}
+
+void MessageChannel::close()
+{
+	if (fd >= 0)
+		::close(fd);
+	fd = -1;
+}
+
+/*******************************************************************************
+ **                           RemoteWorker Class
+ ******************************************************************************/
+
+RemoteWorker::RemoteWorker(int fd) : channel(fd)
+{
+	receiver = std::thread([this]() { receiveLoop(); });
+}
+
+RemoteWorker::~RemoteWorker()
+{
+	/* The coordinator hangs up once it has our results */
+	if (receiver.joinable())
+		receiver.join();
+}
+
+auto RemoteWorker::connect(const std::string &addr) -> int
+{
+	return openTCPSocket(addr, false);
+}
+
+void RemoteWorker::receiveLoop()
+{
+	MessageKind kind;
+	std::string payload;
+	while (channel.receive(kind, payload)) {
+		if (kind == MessageKind::Status) {
+			BinaryReader r(payload.data(), payload.data() + payload.size());
+			numWorkers.store(r.read<uint32_t>(), std::memory_order_relaxed);
+			remainingTasks.store(r.read<uint32_t>(), std::memory_order_relaxed);
+			idleWorkers.store(r.read<uint32_t>(), std::memory_order_relaxed);
+			continue;
+		}
+		if (kind == MessageKind::Stop)
+			halting.store(true);
+
+		std::lock_guard<std::mutex> lock(cmdMtx);
+		commands.push_back({kind, std::move(payload)});
+		cmdCV.notify_one();
+	}
+
+	std::lock_guard<std::mutex> lock(cmdMtx);
+	disconnected = true;
+	halting.store(true);
+	cmdCV.notify_one();
+}
+
+auto RemoteWorker::waitCommand() -> Command
+{
+	std::unique_lock<std::mutex> lock(cmdMtx);
+	cmdCV.wait(lock, [this]() { return !commands.empty() || disconnected; });
+	ERROR_ON(commands.empty(), "Lost connection to the coordinator!\n");
+
+	auto cmd = std::move(commands.front());
+	commands.pop_front();
+	return cmd;
+}
+
+void RemoteWorker::submit(std::unique_ptr<GenMCDriver::Execution> t)
+{
+	if (shouldHalt())
+		return;
+
+	/* Account for the task until the coordinator reports back */
+	channel.send(MessageKind::Task, encode([&](auto &w) { serialize(w, *t); }));
+	remainingTasks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RemoteWorker::halt()
+{
+	if (!halting.exchange(true))
+		channel.send(MessageKind::Halt);
+}
+
+void RemoteWorker::serve(std::shared_ptr<const Config> conf, std::unique_ptr<llvm::Module> mod,
+			 std::unique_ptr<ModuleInfo> MI, int fd)
+{
+	RemoteWorker rw(fd);
+
+	auto fingerprint = GenMCDriver::computeFingerprint(*mod, *conf);
+	auto driver = GenMCDriver::create(conf, std::move(mod), std::move(MI));
+	driver->setRemoteWorker(&rw);
+	rw.channel.send(MessageKind::Hello, encode([&](auto &w) { w.write(fingerprint); }));
+
+	while (true) {
+		auto cmd = rw.waitCommand();
+		if (cmd.kind == MessageKind::Stop)
+			break;
+
+		if (cmd.kind == MessageKind::Task) {
+			BinaryReader r(cmd.payload.data(), cmd.payload.data() + cmd.payload.size());
+			driver->initFromState(driver->deserializeExecution(r));
+		} else {
+			ERROR_ON(cmd.kind != MessageKind::Start,
+				 "Unexpected message from the coordinator!\n");
+		}
+		driver->run();
+
+		/* If halting, the coordinator is no longer interested in our load */
+		if (!rw.shouldHalt())
+			rw.channel.send(MessageKind::Idle);
+	}
+	rw.channel.send(MessageKind::Result,
+			encode([&](auto &w) { serialize(w, driver->getResult()); }));
+}
+
+/*******************************************************************************
+ **                            ProcessPool Class
+ ******************************************************************************/
+
+ProcessPool::ProcessPool(std::shared_ptr<const Config> conf, std::unique_ptr<llvm::Module> mod,
+			 std::unique_ptr<ModuleInfo> MI)
+	: conf(std::move(conf))
+{
+	fingerprint = GenMCDriver::computeFingerprint(*mod, *this->conf);
+	if (this->conf->listenAddr)
+		listenFD = openTCPSocket(*this->conf->listenAddr, true);
+	for (auto i = 0U; i < this->conf->processes; i++)
+		forkWorker(mod, MI);
+}
+
+ProcessPool::~ProcessPool()
+{
+	workers.clear();
+	if (listenFD >= 0)
+		::close(listenFD);
+	for (auto pid : children)
+		waitpid(pid, nullptr, 0);
+}
+
+void ProcessPool::forkWorker(std::unique_ptr<llvm::Module> &mod, std::unique_ptr<ModuleInfo> &MI)
+{
+	int sv[2];
+	ERROR_ON(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0,
+		 std::string("Could not create socket: ") + std::strerror(errno) + "\n");
+
+	/* Do not let the child inherit (and print) buffered output */
+	llvm::outs().flush();
+	llvm::errs().flush();
+	std::fflush(nullptr);
+
+	auto pid = fork();
+	ERROR_ON(pid < 0, std::string("Could not fork worker: ") + std::strerror(errno) + "\n");
+	if (pid == 0) {
+		::close(sv[0]);
+		for (auto &w : workers)
+			w->channel.close();
+		if (listenFD >= 0)
+			::close(listenFD);
+
+		RemoteWorker::serve(conf, std::move(mod), std::move(MI), sv[1]);
+		llvm::outs().flush();
+		llvm::errs().flush();
+		_exit(0);
+	}
+
+	::close(sv[1]);
+	children.push_back(pid);
+	workers.push_back(std::make_unique<Worker>(sv[0], "worker process " + std::to_string(pid)));
+}
+
+/* Peers have this long to say hello before they are dropped */
+static constexpr time_t helloTimeoutSec = 10;
+
+void ProcessPool::acceptWorker()
+{
+	sockaddr_storage addr{};
+	socklen_t len = sizeof(addr);
+	auto fd = accept(listenFD, reinterpret_cast<sockaddr *>(&addr), &len);
+	if (fd < 0)
+		return;
+
+	char host[NI_MAXHOST] = "?";
+	char port[NI_MAXSERV] = "?";
+	getnameinfo(reinterpret_cast<sockaddr *>(&addr), len, host, sizeof(host), port,
+		    sizeof(port), NI_NUMERICHOST | NI_NUMERICSERV);
+
+	auto one = 1;
+	timeval timeout{helloTimeoutSec, 0};
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	workers.push_back(std::make_unique<Worker>(
+		fd, std::string("worker at ") + host + ":" + port));
+}
+
+auto ProcessPool::receiveFrom(Worker &w, MessageKind &kind, std::string &payload) -> bool
+{
+	auto ok = w.channel.receive(kind, payload);
+	if (w.registered) {
+		ERROR_ON(!ok, "Lost connection to " + w.name +
+				      "! The results it collected cannot be recovered.\n");
+		return true;
+	}
+	if (!ok || kind != MessageKind::Hello) {
+		w.channel.close();
+		return false;
+	}
+	return true;
+}
+
+auto ProcessPool::countWorkers(bool onlyIdle /* = false */) const -> unsigned
+{
+	return std::count_if(workers.begin(), workers.end(), [&](auto &w) {
+		return w->registered && (!onlyIdle || w->idle);
+	});
+}
+
+void ProcessPool::dispatchTasks()
+{
+	for (auto &w : workers) {
+		if (!w->registered || !w->idle)
+			continue;
+		if (!started) {
+			w->channel.send(MessageKind::Start);
+			started = true;
+		} else if (!queue.empty()) {
+			w->channel.send(MessageKind::Task, queue.back());
+			queue.pop_back();
+		} else {
+			break;
+		}
+		w->idle = false;
+	}
+}
+
+void ProcessPool::broadcastStatus()
+{
+	auto size = countWorkers();
+	auto idle = countWorkers(true);
+	auto status = std::make_tuple(size, unsigned(queue.size()) + size - idle, idle);
+	if (status == lastStatus)
+		return;
+
+	lastStatus = status;
+	auto payload = encode([&](auto &w) {
+		w.write(uint32_t(std::get<0>(status)));
+		w.write(uint32_t(std::get<1>(status)));
+		w.write(uint32_t(std::get<2>(status)));
+	});
+	for (auto &w : workers) {
+		if (w->registered)
+			w->channel.send(MessageKind::Status, payload);
+	}
+}
+
+auto ProcessPool::handleMessage(Worker &w, MessageKind kind, std::string &payload) -> bool
+{
+	switch (kind) {
+	case MessageKind::Hello: {
+		BinaryReader r(payload.data(), payload.data() + payload.size());
+		if (r.read<uint64_t>() != fingerprint) {
+			WARN("Rejecting worker: it verifies a different program "
+			     "or uses different options.\n");
+			w.channel.close();
+			break;
+		}
+		w.registered = true;
+
+		/* From now on, the worker may take arbitrarily long between messages */
+		timeval noTimeout{0, 0};
+		setsockopt(w.channel.getFD(), SOL_SOCKET, SO_RCVTIMEO, &noTimeout,
+			   sizeof(noTimeout));
+		break;
+	}
+	case MessageKind::Task:
+		queue.push_back(std::move(payload));
+		break;
+	case MessageKind::Idle:
+		w.idle = true;
+		break;
+	case MessageKind::Halt:
+		return false;
+	default:
+		ERROR("Unexpected message from a worker!\n");
+	}
+	return true;
+}
+
+auto ProcessPool::run() -> GenMCDriver::Result
+{
+	while (true) {
+		dispatchTasks();
+		if (started && queue.empty() && countWorkers(true) == countWorkers())
+			break;
+		broadcastStatus();
+
+		std::vector<pollfd> fds;
+		for (auto &w : workers)
+			fds.push_back({w->channel.getFD(), POLLIN, 0});
+		if (listenFD >= 0)
+			fds.push_back({listenFD, POLLIN, 0});
+		if (poll(fds.data(), fds.size(), -1) < 0) {
+			ERROR_ON(errno != EINTR, std::string("poll: ") + std::strerror(errno) + "\n");
+			continue;
+		}
+
+		auto keepGoing = true;
+		for (auto i = 0U; i < workers.size(); i++) {
+			if (!fds[i].revents)
+				continue;
+
+			MessageKind kind;
+			std::string payload;
+			if (receiveFrom(*workers[i], kind, payload))
+				keepGoing &= handleMessage(*workers[i], kind, payload);
+		}
+		if (listenFD >= 0 && (fds.back().revents & POLLIN))
+			acceptWorker();
+
+		/* Forget about dropped and rejected peers */
+		workers.erase(std::remove_if(workers.begin(), workers.end(),
+					     [](auto &w) { return w->channel.getFD() < 0; }),
+			      workers.end());
+		if (!keepGoing)
+			break;
+	}
+	return collectResults();
+}
+
+auto ProcessPool::collectResults() -> GenMCDriver::Result
+{
+	for (auto &w : workers) {
+		if (w->registered)
+			w->channel.send(MessageKind::Stop);
+	}
+
+	/* Tasks and load updates still in flight are simply dropped */
+	GenMCDriver::Result res;
+	for (auto &w : workers) {
+		if (!w->registered)
+			continue;
+
+		MessageKind kind;
+		std::string payload;
+		do {
+			receiveFrom(*w, kind, payload);
+		} while (kind != MessageKind::Result);
+
+		BinaryReader r(payload.data(), payload.data() + payload.size());
+		GenMCDriver::Result wres;
+		deserialize(r, wres);
+		res += std::move(wres);
+		w->channel.close();
+	}
+	return res;
+}
@@ -0,0 +1,278 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#ifndef GENMC_PROCESS_POOL_HPP
+#define GENMC_PROCESS_POOL_HPP
+
+#include "Static/ModuleInfo.hpp"
+#include "Verification/GenMCDriver.hpp"
+#include <llvm/IR/Module.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*******************************************************************************
+ **                           MessageChannel Class
+ ******************************************************************************/
+
+/** The messages exchanged between the coordinator and its workers */
+enum class MessageKind : uint32_t {
+	Hello,	/**< worker -> coord: the worker's program and options fingerprint */
+	Start,	/**< coord -> worker: explore from the initial state */
+	Task,	/**< both ways: a serialized execution to explore */
+	Idle,	/**< worker -> coord: the worker finished its task */
+	Halt,	/**< worker -> coord: an error was found */
+	Status, /**< coord -> worker: pool load (workers, pending tasks, idle workers) */
+	Stop,	/**< coord -> worker: stop and report the results */
+	Result, /**< worker -> coord: the worker's serialized results */
+};
+
+/** A bidirectional, message-based connection over a stream socket.
+ * Each message is a kind and a size-prefixed payload. The header has a fixed
+ * little-endian layout, but payloads are in host byte order: workers on
+ * a different platform are rejected via the fingerprint in Hello.
+ * Peers are trusted: apart from a cap on their size, payloads are not
+ * validated, so the pool should only be reachable by trusted hosts */
+class MessageChannel {
+
+public:
+	/*** Constructors ***/
+
+	explicit MessageChannel(int fd) : fd(fd) {}
+	MessageChannel(const MessageChannel &) = delete;
+	auto operator=(const MessageChannel &) -> MessageChannel & = delete;
+
+	/*** Getters ***/
+
+	auto getFD() const -> int { return fd; }
+
+	/*** Communication ***/
+
+	/** Sends a message; returns false if the connection is lost */
+	auto send(MessageKind kind, const std::string &payload = std::string()) -> bool;
+
+	/** Blocks until a message is received; returns false if the connection is lost */
+	auto receive(MessageKind &kind, std::string &payload) -> bool;
+
+	/** Closes the connection */
+	void close();
+
+	/*** Destructor ***/
+
+	~MessageChannel() { close(); }
+
+private:
+	int fd;
+};
+
+/*******************************************************************************
+ **                           RemoteWorker Class
+ ******************************************************************************/
+
+/**
+ * The worker side of a distributed exploration. A worker process loads the
+ * program once and then repeatedly explores tasks sent by the coordinator,
+ * shipping off tasks of its own when the pool is starving (see
+ * GenMCDriver::shouldSplitRevisit()).
+ *
+ * A helper thread receives the coordinator's messages, so that the pool load
+ * and halting requests are available to the driver without any system calls.
+ */
+class RemoteWorker {
+
+public:
+	/*** Constructors ***/
+
+	explicit RemoteWorker(int fd);
+	RemoteWorker(const RemoteWorker &) = delete;
+	auto operator=(const RemoteWorker &) -> RemoteWorker & = delete;
+
+	/** Connects to the coordinator listening at ADDR (host:port) */
+	static auto connect(const std::string &addr) -> int;
+
+	/** Serves the coordinator connected at FD until it asks the worker to stop */
+	static void serve(std::shared_ptr<const Config> conf, std::unique_ptr<llvm::Module> mod,
+			  std::unique_ptr<ModuleInfo> MI, int fd);
+
+	/*** Pool load (as last reported by the coordinator) ***/
+
+	/** Returns the number of workers in the pool */
+	auto size() const -> unsigned { return numWorkers.load(std::memory_order_relaxed); }
+
+	/** Returns the number of tasks either pending or being explored */
+	auto getRemainingTasks() const -> unsigned
+	{
+		return remainingTasks.load(std::memory_order_relaxed);
+	}
+
+	/** Returns the number of workers waiting for a task */
+	auto getIdleWorkers() const -> unsigned
+	{
+		return idleWorkers.load(std::memory_order_relaxed);
+	}
+
+	/*** Tasks-related ***/
+
+	/** Ships task T to the coordinator */
+	void submit(std::unique_ptr<GenMCDriver::Execution> t);
+
+	/** Notifies the coordinator that an error was found */
+	void halt();
+
+	/** Returns true if the exploration is being stopped */
+	auto shouldHalt() const -> bool { return halting.load(std::memory_order_relaxed); }
+
+	/*** Destructor ***/
+
+	~RemoteWorker();
+
+private:
+	/** A command for the worker's main loop */
+	struct Command {
+		MessageKind kind;
+		std::string payload;
+	};
+
+	/** Receives messages until the connection is closed */
+	void receiveLoop();
+
+	/** Blocks until the next command (Start, Task, or Stop) arrives */
+	auto waitCommand() -> Command;
+
+	/** The connection to the coordinator */
+	MessageChannel channel;
+
+	/** Pool load */
+	std::atomic<unsigned> numWorkers{1};
+	std::atomic<unsigned> remainingTasks{0};
+	std::atomic<unsigned> idleWorkers{0};
+
+	/** Whether the exploration is being stopped */
+	std::atomic<bool> halting{false};
+
+	/** Commands received but not yet processed, and whether the connection is lost */
+	std::deque<Command> commands;
+	bool disconnected = false;
+	std::mutex cmdMtx;
+	std::condition_variable cmdCV;
+
+	/** The thread receiving the coordinator's messages */
+	std::thread receiver;
+};
+
+/*******************************************************************************
+ **                            ProcessPool Class
+ ******************************************************************************/
+
+/**
+ * The coordinator of a distributed exploration. Worker processes are either
+ * forked locally (connected through Unix-domain sockets), or connect over
+ * TCP, possibly from other machines (see -listen and -connect).
+ *
+ * The coordinator does not explore anything itself: it forwards tasks from
+ * busy workers to idle ones, keeps everyone informed of the pool's load,
+ * and propagates halting requests. Once all tasks are complete, the results
+ * of all workers are collected and merged.
+ */
+class ProcessPool {
+
+public:
+	/*** Constructors ***/
+
+	ProcessPool(std::shared_ptr<const Config> conf, std::unique_ptr<llvm::Module> mod,
+		    std::unique_ptr<ModuleInfo> MI);
+	ProcessPool(const ProcessPool &) = delete;
+	auto operator=(const ProcessPool &) -> ProcessPool & = delete;
+
+	/** Coordinates the exploration, and returns the merged results */
+	auto run() -> GenMCDriver::Result;
+
+	/*** Destructor ***/
+
+	~ProcessPool();
+
+private:
+	/** The coordinator's view of a worker */
+	struct Worker {
+		Worker(int fd, std::string name) : channel(fd), name(std::move(name)) {}
+
+		MessageChannel channel;
+		std::string name;	 /**< For diagnostics (PID or address) */
+		bool registered = false; /**< Whether the worker said hello */
+		bool idle = true;	 /**< Whether the worker waits for a task */
+	};
+
+	/** Forks a local worker process */
+	void forkWorker(std::unique_ptr<llvm::Module> &mod, std::unique_ptr<ModuleInfo> &MI);
+
+	/** Accepts a peer connecting at the listening socket */
+	void acceptWorker();
+
+	/** Receives a message from worker W. Unregistered peers that hang up
+	 * (or do not say hello) are dropped; losing a registered worker is
+	 * fatal, as its results cannot be recovered */
+	auto receiveFrom(Worker &w, MessageKind &kind, std::string &payload) -> bool;
+
+	/** Handles a message from worker W; returns false if the exploration should halt */
+	auto handleMessage(Worker &w, MessageKind kind, std::string &payload) -> bool;
+
+	/** Hands out pending tasks to idle workers */
+	void dispatchTasks();
+
+	/** Informs all workers of the pool's load (if it changed) */
+	void broadcastStatus();
+
+	/** Returns the number of registered workers (and how many of them are idle) */
+	auto countWorkers(bool onlyIdle = false) const -> unsigned;
+
+	/** Stops all workers and merges their results */
+	auto collectResults() -> GenMCDriver::Result;
+
+	std::shared_ptr<const Config> conf;
+
+	/** The fingerprint every worker must agree on. It covers the exploration
+	 * options, as workers started with -connect use their own command line */
+	uint64_t fingerprint;
+
+	/** The workers of the pool */
+	std::vector<std::unique_ptr<Worker>> workers;
+
+	/** The PIDs of the local workers */
+	std::vector<int> children;
+
+	/** The socket TCP workers connect to (if any) */
+	int listenFD = -1;
+
+	/** Tasks that wait for an idle worker */
+	std::vector<std::string> queue;
+
+	/** Whether some worker has been told to explore the initial state */
+	bool started = false;
+
+	/** The last load broadcast to the workers */
+	std::tuple<unsigned, unsigned, unsigned> lastStatus{};
+};
+
+#endif /* GENMC_PROCESS_POOL_HPP */
@@ -20,6 +20,7 @@
 
 #include "Support/SAddrAllocator.hpp"
 #include "ADT/VectorClock.hpp"
+#include "Support/BinaryIO.hpp"
 
 void SAddrAllocator::restrict(const VectorClock &view)
 {
@@ -38,3 +39,31 @@ auto operator<<(llvm::raw_ostream &rhs, const SAddrAllocator &alloctor) -> llvm:
 		rhs << "(" << tid << ", " << idx << ") ";
 	return rhs << "\n";
 }
+
+void serialize(BinaryWriter &w, const SAddrAllocator &alloctor)
+{
+	w.writeSize(alloctor.staticPool_.size());
+	for (const auto &[tid, idx] : alloctor.staticPool_) {
+		w.write<unsigned>(tid);
+		w.write<SAddr::Width>(idx);
+	}
+	w.writeSize(alloctor.dynamicPool_.size());
+	for (const auto &[tid, idx] : alloctor.dynamicPool_) {
+		w.write<unsigned>(tid);
+		w.write<SAddr::Width>(idx);
+	}
+}
+
+void deserialize(BinaryReader &r, SAddrAllocator &alloctor)
+{
+	alloctor.staticPool_.clear();
+	for (auto n = r.readSize(); n > 0; --n) {
+		auto tid = r.read<unsigned>();
+		alloctor.staticPool_[tid] = r.read<SAddr::Width>();
+	}
+	alloctor.dynamicPool_.clear();
+	for (auto n = r.readSize(); n > 0; --n) {
+		auto tid = r.read<unsigned>();
+		alloctor.dynamicPool_[tid] = r.read<SAddr::Width>();
+	}
+}
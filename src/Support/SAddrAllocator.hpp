@@ -28,6 +28,8 @@
 #include <unordered_map>
 
 class VectorClock;
+class BinaryWriter;
+class BinaryReader;
 
 /*******************************************************************************
  **                         SAddrAllocator Class
@@ -80,6 +82,9 @@ public:
 	friend auto operator<<(llvm::raw_ostream &rhs, const SAddrAllocator &alloctor)
 		-> llvm::raw_ostream &;
 
+	friend void serialize(BinaryWriter &w, const SAddrAllocator &alloctor);
+	friend void deserialize(BinaryReader &r, SAddrAllocator &alloctor);
+
 private:
 	/** Helper class to avoid allocating null for heap addresses */
 	class WidthProxy {
@@ -677,6 +677,16 @@ COMPARISON_EXPR_CLASS(Sgt)
 
 COMPARISON_EXPR_CLASS(Sge)
 
+/*******************************************************************************
+ **                           Binary serialization
+ ******************************************************************************/
+
+class BinaryWriter;
+class BinaryReader;
+
+template <typename T> void serialize(BinaryWriter &w, const SExpr<T> &e);
+template <typename T> void deserialize(BinaryReader &r, std::unique_ptr<SExpr<T>> &e);
+
 #include "SExpr.tcc"
 
 #endif /* GENMC_S_EXPR_HPP */
@@ -19,7 +19,96 @@
  */
 
 #include "SExpr.hpp"
+#include "BinaryIO.hpp"
 #include "Error.hpp"
 
 template<typename T>
 unsigned RegisterExpr<T>::regCount = 0;
+
+template <typename T> void serialize(BinaryWriter &w, const SExpr<T> &e)
+{
+	w.write(e.getKind());
+	w.write(e.getWidth());
+	if (auto *ce = llvm::dyn_cast<ConcreteExpr<T>>(&e))
+		w.write(ce->getValue());
+	else if (auto *re = llvm::dyn_cast<RegisterExpr<T>>(&e)) {
+		w.write(re->getRegister());
+		w.writeString(re->getName());
+	}
+	w.writeSize(e.getNumKids());
+	for (auto i = 0U; i < e.getNumKids(); i++)
+		serialize(w, *e.getKid(i));
+}
+
+template <typename T> void deserialize(BinaryReader &r, std::unique_ptr<SExpr<T>> &e)
+{
+	using Kind = typename SExpr<T>::Kind;
+
+	auto kind = r.read<Kind>();
+	auto width = r.read<typename SExpr<T>::Width>();
+	if (kind == Kind::Concrete) {
+		e = ConcreteExpr<T>::create(width, r.read<SVal>());
+		r.readSize();
+		return;
+	}
+	if (kind == Kind::Register) {
+		auto reg = r.read<T>();
+		e = RegisterExpr<T>::create(width, reg, r.readString());
+		r.readSize();
+		return;
+	}
+
+	std::vector<std::unique_ptr<SExpr<T>>> kids(
+		r.readSize(sizeof(Kind) + sizeof(typename SExpr<T>::Width)));
+	for (auto &k : kids)
+		deserialize(r, k);
+
+#define HANDLE_KIND(_kind, ...)                                                                    \
+	case Kind::_kind:                                                                          \
+		e = _kind##Expr<T>::create(__VA_ARGS__);                                           \
+		return;
+#define HANDLE_UNARY(_kind) HANDLE_KIND(_kind, width, std::move(kids[0]))
+#define HANDLE_BINARY(_kind) HANDLE_KIND(_kind, width, std::move(kids[0]), std::move(kids[1]))
+#define HANDLE_CMP(_kind) HANDLE_KIND(_kind, std::move(kids[0]), std::move(kids[1]))
+
+	switch (kind) {
+		HANDLE_KIND(Select, width, std::move(kids[0]), std::move(kids[1]),
+			    std::move(kids[2]))
+		HANDLE_KIND(Conjunction, std::move(kids))
+		HANDLE_KIND(Disjunction, std::move(kids))
+		HANDLE_KIND(Not, std::move(kids[0]))
+		HANDLE_UNARY(ZExt)
+		HANDLE_UNARY(SExt)
+		HANDLE_UNARY(Trunc)
+		HANDLE_BINARY(Add)
+		HANDLE_BINARY(Sub)
+		HANDLE_BINARY(Mul)
+		HANDLE_BINARY(UDiv)
+		HANDLE_BINARY(SDiv)
+		HANDLE_BINARY(URem)
+		HANDLE_BINARY(SRem)
+		HANDLE_BINARY(And)
+		HANDLE_BINARY(Or)
+		HANDLE_BINARY(Xor)
+		HANDLE_BINARY(Shl)
+		HANDLE_BINARY(LShr)
+		HANDLE_BINARY(AShr)
+		HANDLE_CMP(Eq)
+		HANDLE_CMP(Ne)
+		HANDLE_CMP(Ult)
+		HANDLE_CMP(Ule)
+		HANDLE_CMP(Ugt)
+		HANDLE_CMP(Uge)
+		HANDLE_CMP(Slt)
+		HANDLE_CMP(Sle)
+		HANDLE_CMP(Sgt)
+		HANDLE_CMP(Sge)
+	default:
+		ERROR("Unsupported expression kind in binary input!\n");
+	}
+
+#undef HANDLE_CMP
+#undef HANDLE_BINARY
+#undef HANDLE_UNARY
+#undef HANDLE_KIND
+}
@@ -19,35 +19,59 @@
  */
 
 #include "ThreadPool.hpp"
+#include "Support/Logger.hpp"
+#include <llvm/Support/Format.h>
 
-void ThreadPool::addWorker(unsigned int i, std::unique_ptr<GenMCDriver> d)
+thread_local unsigned int ThreadPool::index_ = std::numeric_limits<unsigned int>::max();
+thread_local std::minstd_rand ThreadPool::stealRng_;
+
+void ThreadPool::addWorker(unsigned int i, std::unique_ptr<GenMCDriver> d, bool resumed)
 {
 	using ThreadT = std::packaged_task<GenMCDriver::Result(
 		unsigned int, std::unique_ptr<GenMCDriver> driver)>;
 
-	ThreadT t([this](unsigned int i, std::unique_ptr<GenMCDriver> driver) {
+	ThreadT t([this, resumed](unsigned int i, std::unique_ptr<GenMCDriver> driver) {
+		setIndex(i);
+		stealRng_.seed(i + 1);
+		auto resuming = resumed;
 		while (true) {
-			auto taskUP = popTask();
+			/* A restored exploration is already in place */
+			auto &res = driver->getResult();
+			auto execsBefore = res.explored + res.exploredBlocked;
+			if (!std::exchange(resuming, false)) {
+				auto taskUP = popTask();
 
-			/* If the state is empty, nothing left to do */
-			if (!taskUP)
-				break;
+				/* If the state is empty, nothing left to do */
+				if (!taskUP)
+					break;
+
+				/* Prepare the driver */
+				driver->initFromState(std::move(taskUP));
+			}
 
-			/* Prepare the driver and start the exploration */
-			driver->initFromState(std::move(taskUP));
+			/* Start the exploration */
 			driver->run();
 
+			auto &stats = stats_[i];
+			auto execs = res.explored + res.exploredBlocked - execsBefore;
+			++stats.executed;
+			stats.taskExecs += execs;
+			stats.maxTaskExecs = std::max<uint64_t>(stats.maxTaskExecs, execs);
+
 			/* If that was the last task, notify everyone */
 			std::lock_guard<std::mutex> lock(stateMtx_);
 			if (decRemainingTasks() == 0) {
 				stateCV_.notify_all();
+				doneCV_.notify_all();
 				break;
 			}
 		}
+		stats_[i].labelAllocs = SlabAllocator::local().getStats();
 		return std::move(driver->getResult());
 	});
 
 	results_.push_back(std::move(t.get_future()));
+	drivers_.push_back(d.get());
 
 	workers_.emplace_back(std::move(t), i, std::move(d));
 	pinner_.pin(workers_.back(), i);
@@ -55,40 +79,226 @@ void ThreadPool::addWorker(unsigned int i, std::unique_ptr<GenMCDriver> d)
 
 void ThreadPool::submit(ThreadPool::TaskT t)
 {
-	std::lock_guard<std::mutex> lock(stateMtx_);
 	incRemainingTasks();
-	queue_.push(std::move(t));
-	stateCV_.notify_one();
+	if (!isWorkerThread()) {
+		std::lock_guard<std::mutex> lock(stateMtx_);
+		queue_.push(std::move(t));
+		stateCV_.notify_one();
+		return;
+	}
+
+	auto &q = *localQueues_[getIndex()];
+	auto &stats = stats_[getIndex()];
+	++stats.submitted;
+	stats.submittedEvents += t->getGraph().getNumEvents();
+	q.push(std::move(t));
+	stats.maxQueueDepth = std::max(stats.maxQueueDepth, q.size());
+
+	/* Pairs with the fence in popTask(): either we see the idle worker,
+	 * or the idle worker sees the new task before going to sleep */
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (getIdleWorkers() > 0) {
+		std::lock_guard<std::mutex> lock(stateMtx_);
+		stateCV_.notify_one();
+	}
+}
+
+ThreadPool::TaskT ThreadPool::tryPopLocalQueue()
+{
+	return isWorkerThread() ? localQueues_[getIndex()]->pop() : nullptr;
 }
 
 ThreadPool::TaskT ThreadPool::tryPopPoolQueue() { return queue_.tryPop(); }
 
 ThreadPool::TaskT ThreadPool::tryStealOtherQueue()
 {
-	/* TODO: Implement work-stealing */
+	auto n = localQueues_.size();
+	if (n <= 1)
+		return nullptr;
+
+	/* Start from a random victim, and go around once.
+	 * Victims we lost a race on are retried, as they likely have more tasks */
+	auto self = getIndex();
+	auto start = std::uniform_int_distribution<unsigned>(0, n - 1)(stealRng_);
+	for (auto j = 0u; j < n; j++) {
+		auto victim = (start + j) % n;
+		if (victim == self)
+			continue;
+
+		TaskT task;
+		LocalQueueT::StealStatus status;
+		while ((status = localQueues_[victim]->steal(task)) ==
+		       LocalQueueT::StealStatus::Abort)
+			;
+		if (status == LocalQueueT::StealStatus::Success) {
+			++stats_[self].steals;
+			return task;
+		}
+	}
+	++stats_[self].failedSteals;
 	return nullptr;
 }
 
+bool ThreadPool::hasAvailableTask() const
+{
+	return std::any_of(localQueues_.begin(), localQueues_.end(),
+			   [](auto &q) { return !q->empty(); }) ||
+	       !queue_.empty();
+}
+
 ThreadPool::TaskT ThreadPool::popTask()
 {
+	if (auto t = tryPopLocalQueue())
+		return t;
+
+	auto idleStart = std::chrono::steady_clock::now();
+	auto accountIdle = [&]() {
+		stats_[getIndex()].idle += std::chrono::steady_clock::now() - idleStart;
+	};
 	while (true) {
-		if (auto t = tryPopPoolQueue())
+		if (auto t = tryPopPoolQueue()) {
+			accountIdle();
 			return t;
-		if (auto t = tryStealOtherQueue())
+		}
+		if (auto t = tryStealOtherQueue()) {
+			accountIdle();
 			return t;
+		}
 
 		std::unique_lock<std::mutex> lock(stateMtx_);
-		if (shouldHalt() || getRemainingTasks() == 0)
+		if (checkpointPending_.load()) {
+			stopForCheckpoint(lock, nullptr);
+			continue;
+		}
+		if (shouldHalt() || getRemainingTasks() == 0) {
+			accountIdle();
 			return nullptr;
-		stateCV_.wait(lock);
+		}
+
+		/* Announce we are going to sleep, and re-check for tasks
+		 * submitted in the meantime (see submit()) */
+		++idleWorkers_;
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (!hasAvailableTask())
+			stateCV_.wait(lock);
+		--idleWorkers_;
 	}
 	return nullptr;
 }
 
+bool ThreadPool::isCheckpointDue() const
+{
+	auto stopAfter = conf_->checkpointStopAfter;
+	if (stopAfter && explored_.load() >= *stopAfter)
+		return true;
+
+	auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::seconds(conf_->checkpointInterval));
+	auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+	return now - lastCheckpoint_.load() >= interval.count();
+}
+
+void ThreadPool::checkpointIfDue(const GenMCDriver &driver, unsigned explored)
+{
+	explored_ += explored;
+	if (!checkpointPending_.load() && !isCheckpointDue())
+		return;
+
+	/* Wake up idle workers too, so that they stop as well.
+	 * (Re-check, in case a checkpoint was taken in the meantime) */
+	std::unique_lock<std::mutex> lock(stateMtx_);
+	if (!checkpointPending_.load()) {
+		if (!isCheckpointDue())
+			return;
+		checkpointPending_.store(true);
+		stateCV_.notify_all();
+	}
+	stopForCheckpoint(lock, &driver);
+}
+
+void ThreadPool::stopForCheckpoint(std::unique_lock<std::mutex> &lock, const GenMCDriver *driver)
+{
+	if (shouldHalt())
+		return;
+
+	if (driver)
+		stoppedDrivers_.push_back(driver);
+	if (++stoppedWorkers_ < numWorkers_) {
+		auto taken = checkpoints_;
+		checkpointCV_.wait(lock, [&]() { return checkpoints_ != taken || shouldHalt(); });
+		return;
+	}
+
+	/* Everyone has stopped: no task or exploration can change under our feet */
+	writeCheckpoint();
+	stoppedWorkers_ = 0;
+	stoppedDrivers_.clear();
+	checkpointPending_.store(false);
+	lastCheckpoint_.store(std::chrono::steady_clock::now().time_since_epoch().count());
+	++checkpoints_;
+	checkpointCV_.notify_all();
+
+	/* Stopping after a given number of executions makes interruptions reproducible */
+	auto stopAfter = conf_->checkpointStopAfter;
+	if (stopAfter && explored_.load() >= *stopAfter) {
+		PRINT(VerbosityLevel::Error) << "Checkpoint taken after " << explored_.load()
+					     << " complete executions; stopping.\n";
+		drivers_[getIndex()]->getResult().interrupted = true;
+		shouldHalt_.store(true);
+		stateCV_.notify_all();
+		doneCV_.notify_all();
+	}
+}
+
+void ThreadPool::writeCheckpoint()
+{
+	std::vector<const GenMCDriver::Result *> results;
+	for (const auto *d : drivers_)
+		results.push_back(&d->getResult());
+
+	std::vector<const GenMCDriver::Execution *> execs;
+	for (const auto *d : stoppedDrivers_) {
+		for (const auto &exec : d->execStack)
+			execs.push_back(&exec);
+	}
+
+	std::vector<const GenMCDriver::Execution *> tasks;
+	auto addTask = [&](const GenMCDriver::Execution &t) { tasks.push_back(&t); };
+	queue_.forEach(addTask);
+	for (const auto &q : localQueues_)
+		q->forEach(addTask);
+
+	drivers_[getIndex()]->writeCheckpoint(results, execs, tasks);
+}
+
 std::vector<std::future<GenMCDriver::Result>> ThreadPool::waitForTasks()
 {
-	while (!shouldHalt() && getRemainingTasks() > 0)
-		std::this_thread::yield();
+	std::unique_lock<std::mutex> lock(stateMtx_);
+	doneCV_.wait(lock, [this]() { return shouldHalt() || getRemainingTasks() == 0; });
 
 	return std::move(results_);
 }
+
+void ThreadPool::printStats(llvm::raw_ostream &s) const
+{
+	using namespace std::chrono;
+
+	auto avg = [](uint64_t total, unsigned n) { return n ? (double)total / n : 0.0; };
+
+	s << "Thread pool statistics:\n";
+	for (auto i = 0u; i < stats_.size(); i++) {
+		auto &st = stats_[i];
+		s << "  Worker " << i << ": executed " << st.executed << " (avg size "
+		  << llvm::format("%.1f", avg(st.taskExecs, st.executed)) << " execs, max "
+		  << st.maxTaskExecs << "), submitted " << st.submitted << " (avg graph "
+		  << llvm::format("%.1f", avg(st.submittedEvents, st.submitted))
+		  << " events), steals " << st.steals << " (failed " << st.failedSteals
+		  << "), max queue depth " << st.maxQueueDepth << ", idle "
+		  << llvm::format("%.2f", duration_cast<duration<double>>(st.idle).count())
+		  << "s\n";
+		s << "           label allocs " << st.labelAllocs.allocs << " (recycled "
+		  << st.labelAllocs.reused << ", from shared pool " << st.labelAllocs.shared
+		  << ", slabs " << st.labelAllocs.slabs << ", large " << st.labelAllocs.large
+		  << ")\n";
+	}
+}
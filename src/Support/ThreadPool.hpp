@@ -21,6 +21,8 @@
 #ifndef GENMC_THREAD_POOL_HPP
 #define GENMC_THREAD_POOL_HPP
 
+#include "ADT/SlabAllocator.hpp"
+#include "ADT/WorkStealingDeque.hpp"
 #include "ExecutionGraph/ExecutionGraph.hpp"
 #include "Static/LLVMModule.hpp"
 #include "Support/Error.hpp"
@@ -31,15 +33,19 @@
 #include <llvm/Transforms/Utils/Cloning.h>
 
 #include <atomic>
+#include <chrono>
 #include <future>
+#include <limits>
 #include <memory>
+#include <random>
 #include <thread>
 
 /*******************************************************************************
  **                           GlobalWorkQueue Class
  ******************************************************************************/
 
-/** Represents the global workqueue shared among threads. */
+/** Represents the global workqueue shared among threads.
+ * Only used for tasks submitted from outside the pool's workers. */
 class GlobalWorkQueue {
 
 public:
@@ -54,7 +60,7 @@ public:
 	/*** Queue operations ***/
 
 	/** Returns true if the queue is empty */
-	bool empty()
+	bool empty() const
 	{
 		std::lock_guard<std::mutex> lock(qMutex);
 		return queue.empty();
@@ -67,6 +73,14 @@ public:
 		queue.push_back(std::move(item));
 	}
 
+	/** Calls FUN on each item of the queue */
+	template <typename F> void forEach(F &&fun) const
+	{
+		std::lock_guard<std::mutex> lock(qMutex);
+		for (const auto &item : queue)
+			fun(*item);
+	}
+
 	/** Tries to pop an item from the queue */
 	ItemT tryPop()
 	{
@@ -83,7 +97,7 @@ private:
 	QueueT queue;
 
 	/** Protection against unsynchronized accesses */
-	std::mutex qMutex;
+	mutable std::mutex qMutex;
 };
 
 /*******************************************************************************
@@ -122,24 +136,64 @@ private:
  * submitted dynamically to the threads for execution. Each thread will have
  * each own exploration driver so that they will able to execute the submitted
  * (exploration) tasks concurrently.
+ *
+ * Each worker owns a work-stealing deque: tasks submitted by a worker are
+ * pushed to (and popped from) its own deque, while idle workers steal from
+ * randomly chosen victims. Tasks submitted from outside the pool go to a
+ * global queue.
+ *
+ * To take a checkpoint, the pool stops every worker in between executions
+ * (or while waiting for a task), so that the explorations of all of them
+ * as well as all queued tasks can be saved.
  */
 class ThreadPool {
 
 public:
 	using GlobalQueueT = GlobalWorkQueue;
 	using TaskT = GlobalQueueT::ItemT;
+	using LocalQueueT = WorkStealingDeque<GenMCDriver::Execution>;
+
+	/** Scheduling statistics of a single worker */
+	struct WorkerStats {
+		unsigned executed{};	      /**< Number of tasks executed */
+		unsigned submitted{};	      /**< Number of tasks submitted (splits) */
+		uint64_t submittedEvents{};   /**< Total graph size of submitted tasks */
+		uint64_t taskExecs{};	      /**< Executions explored across executed tasks */
+		uint64_t maxTaskExecs{};      /**< Executions explored by the largest task */
+		unsigned steals{};	      /**< Number of successful steals */
+		unsigned failedSteals{};      /**< Number of steal attempts that found no task */
+		int64_t maxQueueDepth{};      /**< Maximum depth of the local queue */
+		std::chrono::steady_clock::duration idle{}; /**< Time spent waiting for tasks */
+		SlabAllocator::Stats labelAllocs{};	    /**< Label (and saved view) allocations */
+	};
 
 	/*** Constructors ***/
 
 	ThreadPool(const std::shared_ptr<const Config> conf,
 		   const std::unique_ptr<llvm::Module> &mod, const std::unique_ptr<ModuleInfo> &MI)
-		: numWorkers_(conf->threads), pinner_(numWorkers_), joiner_(workers_)
+		: conf_(conf), numWorkers_(conf->threads), pinner_(numWorkers_), joiner_(workers_)
 	{
 		numWorkers_ = conf->threads;
 
 		/** Set global variables before spawning the threads */
 		shouldHalt_.store(false);
 		remainingTasks_.store(0);
+		idleWorkers_.store(0);
+		checkpointPending_.store(false);
+		explored_.store(0);
+		lastCheckpoint_.store(std::chrono::steady_clock::now().time_since_epoch().count());
+
+		stats_.resize(numWorkers_);
+		drivers_.reserve(numWorkers_);
+		for (auto i = 0u; i < numWorkers_; i++)
+			localQueues_.push_back(std::make_unique<LocalQueueT>());
+
+		if (conf->collectLinSpec)
+			observations_ = std::make_shared<ObservationStore>(conf->symmetryReduction);
+		auto detectDuplicates = conf->pruneDuplicates;
+		GENMC_DEBUG(detectDuplicates |= conf->countDuplicateExecs;);
+		if (detectDuplicates)
+			visited_ = std::make_shared<VisitedSet>(conf->visitedSetSize);
 
 		for (auto i = 0u; i < numWorkers_; i++) {
 			contexts_.push_back(std::make_unique<llvm::LLVMContext>());
@@ -148,6 +202,17 @@ public:
 
 			auto dw = GenMCDriver::create(conf, std::move(newmod), std::move(newMI),
 						      this);
+			if (i == 0 && conf->resumeFile) {
+				/* The first worker continues the restored exploration,
+				 * while the restored tasks are up for grabs */
+				dw->restoreCheckpoint(*conf->resumeFile);
+				for (auto &t : dw->restoredTasks)
+					submit(std::move(t));
+				dw->restoredTasks.clear();
+				incRemainingTasks();
+				addWorker(i, std::move(dw), true);
+				continue;
+			}
 			if (i == 0)
 				submit(dw->extractState());
 			addWorker(i, std::move(dw));
@@ -166,12 +231,24 @@ public:
 	/** Returnst the number of workers that will be added in the pool */
 	unsigned int getNumWorkers() const { return numWorkers_; }
 
+	/** Returns the observation store shared by all workers (if collecting a spec) */
+	const std::shared_ptr<ObservationStore> &getObservationStore() const
+	{
+		return observations_;
+	}
+
+	/** Returns the visited set shared by all workers (if detecting duplicates) */
+	const std::shared_ptr<VisitedSet> &getVisitedSet() const { return visited_; }
+
 	/** Returns the index of the calling thread */
 	unsigned int getIndex() const { return index_; }
 
 	/** Sets the index of the calling thread */
 	void setIndex(unsigned int i) { index_ = i; }
 
+	/** Returns true if the calling thread is a worker of the pool */
+	bool isWorkerThread() const { return index_ < localQueues_.size(); }
+
 	/*** Tasks-related ***/
 
 	/** Submits a task to be executed by a worker */
@@ -182,6 +259,9 @@ public:
 	unsigned decRemainingTasks() { return --remainingTasks_; }
 	unsigned getRemainingTasks() { return remainingTasks_.load(); }
 
+	/** Returns the number of workers currently waiting for a task */
+	unsigned getIdleWorkers() const { return idleWorkers_.load(); }
+
 	bool shouldHalt() const { return shouldHalt_.load(); }
 
 	/** Stops all threads */
@@ -190,18 +270,42 @@ public:
 		std::lock_guard<std::mutex> lock(stateMtx_);
 		shouldHalt_.store(true);
 		stateCV_.notify_all();
+		doneCV_.notify_all();
+		checkpointCV_.notify_all();
 	}
 
+	/*** Checkpointing ***/
+
+	/** Called by the worker exploring with DRIVER in between executions,
+	 * having explored EXPLORED more complete executions since the last call.
+	 * If a checkpoint is due, waits until all workers have stopped
+	 * (the last one to stop takes the checkpoint) */
+	void checkpointIfDue(const GenMCDriver &driver, unsigned explored);
+
 	/** Waits for all tasks to complete */
 	std::vector<std::future<GenMCDriver::Result>> waitForTasks();
 
+	/*** Statistics ***/
+
+	/** Returns the statistics of each worker.
+	 * Only meaningful after all workers have finished */
+	const std::vector<WorkerStats> &getStats() const { return stats_; }
+
+	/** Prints the per-worker statistics */
+	void printStats(llvm::raw_ostream &s) const;
+
 	/*** Destructor ***/
 
 	~ThreadPool() { halt(); }
 
 private:
-	/** Adds a worker thread to the pool */
-	void addWorker(unsigned int index, std::unique_ptr<GenMCDriver> driver);
+	/** Adds a worker thread to the pool. If RESUMED is set, DRIVER
+	 * starts with the exploration it has restored from a checkpoint */
+	void addWorker(unsigned int index, std::unique_ptr<GenMCDriver> driver,
+		       bool resumed = false);
+
+	/** Tries to pop a task from the calling worker's own queue */
+	TaskT tryPopLocalQueue();
 
 	/** Tries to pop a task from the global queue */
 	TaskT tryPopPoolQueue();
@@ -209,9 +313,30 @@ private:
 	/** Tries to steal a task from another thread */
 	TaskT tryStealOtherQueue();
 
+	/** Returns true if some queue seems to have a task available */
+	bool hasAvailableTask() const;
+
 	/** Pops the next task to be executed by a thread */
 	TaskT popTask();
 
+	/** Returns true if a checkpoint should be taken */
+	bool isCheckpointDue() const;
+
+	/** Stops the calling worker for the pending checkpoint, until the
+	 * checkpoint has been taken. DRIVER is the driver of the worker, if
+	 * it stops in between executions (as opposed to between tasks).
+	 * The last worker to stop takes the checkpoint */
+	void stopForCheckpoint(std::unique_lock<std::mutex> &lock, const GenMCDriver *driver);
+
+	/** Saves the explorations of all (stopped) workers and all queued tasks */
+	void writeCheckpoint();
+
+	/** The user configuration */
+	std::shared_ptr<const Config> conf_;
+
+	/** The driver of each worker (owned by the worker) */
+	std::vector<GenMCDriver *> drivers_;
+
 	std::vector<std::unique_ptr<llvm::LLVMContext>> contexts_;
 
 	/** Result of each thread */
@@ -226,19 +351,59 @@ private:
 	/** The worker threads */
 	std::vector<std::thread> workers_;
 
-	/** A queue where tasks are stored */
+	/** A queue where tasks submitted from outside the pool are stored */
 	GlobalQueueT queue_;
 
+	/** Per-worker work-stealing queues */
+	std::vector<std::unique_ptr<LocalQueueT>> localQueues_;
+
+	/** Per-worker statistics (each entry is only written by its worker) */
+	std::vector<WorkerStats> stats_;
+
+	/** Observations collected by all workers (if collecting a spec) */
+	std::shared_ptr<ObservationStore> observations_;
+
+	/** Fingerprints of the graphs seen by all workers (if detecting duplicates) */
+	std::shared_ptr<VisitedSet> visited_;
+
 	/** Number of tasks that need to be executed across threads */
 	std::atomic<unsigned> remainingTasks_;
 
-	/** The index of a worker thread */
+	/** Number of workers blocked waiting for a task */
+	std::atomic<unsigned> idleWorkers_;
+
+	/** The index of a worker thread (max for non-worker threads) */
 	static thread_local unsigned int index_;
 
+	/** Random-number generator used for choosing steal victims */
+	static thread_local std::minstd_rand stealRng_;
+
 	/** Mutex+CV to determine whether the pool state has changed:
-	 * a new task has been submitted or all tasks have been completed */
+	 * a new task has been submitted or all tasks have been completed.
+	 * Only workers wait on stateCV_, so that a new task's notification
+	 * always wakes up a worker; the coordinator waits on doneCV_ */
 	std::mutex stateMtx_;
 	std::condition_variable stateCV_;
+	std::condition_variable doneCV_;
+
+	/** Ckpt: Whether workers should stop for a checkpoint */
+	std::atomic<bool> checkpointPending_;
+
+	/** Ckpt: Complete executions explored by all workers (as reported) */
+	std::atomic<unsigned> explored_;
+
+	/** Ckpt: When the last checkpoint was written (steady-clock ticks) */
+	std::atomic<std::chrono::steady_clock::rep> lastCheckpoint_;
+
+	/** Ckpt: The workers that have stopped for the pending checkpoint, and the
+	 * drivers of those that stopped in between executions (protected by stateMtx_) */
+	unsigned stoppedWorkers_ = 0;
+	std::vector<const GenMCDriver *> stoppedDrivers_;
+
+	/** Ckpt: Counts the checkpoints taken, so that stopped workers know when
+	 * to resume; they wait on checkpointCV_ (protected by stateMtx_) */
+	unsigned checkpoints_ = 0;
+	std::condition_variable checkpointCV_;
 
 	ThreadPinner pinner_;
 
@@ -19,6 +19,7 @@
  */
 
 #include "Verification/ChoiceMap.hpp"
+#include "Support/BinaryIO.hpp"
 
 #include <algorithm>
 
@@ -63,3 +64,21 @@ void ChoiceMap::cut(const VectorClock &v)
 		++it;
 	}
 }
+
+void serialize(BinaryWriter &w, const ChoiceMap &choices)
+{
+	w.writeSize(choices.cmap_.size());
+	for (const auto &[e, alts] : choices.cmap_) {
+		w.write(e);
+		w.writeRange(alts);
+	}
+}
+
+void deserialize(BinaryReader &r, ChoiceMap &choices)
+{
+	choices.cmap_.clear();
+	for (auto n = r.readSize(); n > 0; --n) {
+		auto e = r.read<Event>();
+		choices.cmap_[e] = r.readVector<Event>();
+	}
+}
@@ -28,6 +28,9 @@
 #include <unordered_map>
 #include <vector>
 
+class BinaryWriter;
+class BinaryReader;
+
 /**
  * ChoiceMap class - Maintains alternative exploration options encountered
  * across an execution.
@@ -54,6 +57,9 @@ public:
 
 	void cut(const VectorClock &v);
 
+	friend void serialize(BinaryWriter &w, const ChoiceMap &choices);
+	friend void deserialize(BinaryReader &r, ChoiceMap &choices);
+
 private:
 	std::unordered_map<Event, VSet<Event>> cmap_;
 };
@@ -29,10 +29,12 @@
 #include "ExecutionGraph/LabelVisitor.hpp"
 #include "Runtime/Interpreter.h"
 #include "Static/LLVMModule.hpp"
+#include "Support/BinaryIO.hpp"
 #include "Support/DotPrint.hpp"
 #include "Support/Error.hpp"
 #include "Support/Logger.hpp"
 #include "Support/Parser.hpp"
+#include "Support/ProcessPool.hpp"
 #include "Support/SExprVisitor.hpp"
 #include "Support/ThreadPool.hpp"
 #include "Verification/DriverHandlerDispatcher.hpp"
@@ -40,10 +42,15 @@
 #include "config.h"
 #include <llvm/IR/Verifier.h>
 #include <llvm/Support/DynamicLibrary.h>
+#include <llvm/Support/Endian.h>
+#include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Format.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SHA1.h>
 #include <llvm/Support/raw_os_ostream.h>
 
 #include <algorithm>
+#include <future>
 #include <csignal>
 
 /************************************************************
@@ -53,14 +60,11 @@
 GenMCDriver::GenMCDriver(std::shared_ptr<const Config> conf, std::unique_ptr<llvm::Module> mod,
 			 std::unique_ptr<ModuleInfo> modInfo, ThreadPool *pool /* = nullptr */,
 			 Mode mode /* = VerificationMode{} */)
-	: mode(mode), pool(pool), userConf(std::move(conf))
+	: mode(mode), pool(pool), userConf(std::move(conf)),
+	  snapshots(userConf->snapshotCacheSize)
 {
 	/* Set up the execution context */
-	auto initValGetter = [this](const auto &access) { return getEE()->getLocInitVal(access); };
-	auto execGraph = userConf->isDepTrackingModel
-				 ? std::make_unique<DepExecutionGraph>(initValGetter)
-				 : std::make_unique<ExecutionGraph>(initValGetter);
-	execStack.emplace_back(std::move(execGraph), std::move(LocalQueueT()),
+	execStack.emplace_back(createExecutionGraph(), std::move(LocalQueueT()),
 			       std::move(ChoiceMap()), std::move(SAddrAllocator()),
 			       Event::getInit());
 
@@ -71,6 +75,12 @@ GenMCDriver::GenMCDriver(std::shared_ptr<const Config> conf, std::unique_ptr<llv
 	if (hasBounder)
 		bounder = BoundDecider::create(getConf()->boundType);
 
+	/* A checkpoint is only valid for the same program under the same options */
+	if (userConf->checkpointFile || userConf->resumeFile) {
+		checkpointFingerprint = computeFingerprint(*mod, *userConf);
+		lastCheckpoint = std::chrono::steady_clock::now();
+	}
+
 	/* Create an interpreter for the program's instructions */
 	std::string buf;
 	EE = llvm::Interpreter::create(std::move(mod), std::move(modInfo), this, getConf(),
@@ -99,23 +109,42 @@ GenMCDriver::GenMCDriver(std::shared_ptr<const Config> conf, std::unique_ptr<llv
 	}
 
 	if (userConf->collectLinSpec)
-		result.specification = std::make_unique<Specification>(userConf->maxExtSize
-#ifdef ENABLE_GENMC_DEBUG
-								       ,
-								       userConf->relincheDebug
-#endif
-		);
+		result.observations =
+			pool ? pool->getObservationStore()
+			     : std::make_shared<ObservationStore>(userConf->symmetryReduction);
+	auto detectDuplicates = userConf->pruneDuplicates;
+	GENMC_DEBUG(detectDuplicates |= userConf->countDuplicateExecs;);
+	if (detectDuplicates)
+		visited = pool ? pool->getVisitedSet()
+			       : std::make_shared<VisitedSet>(userConf->visitedSetSize);
 	if (userConf->checkLinSpec)
-		relinche =
-			LinearizabilityChecker::create(&getConsChecker(), *getConf()->checkLinSpec);
+		relinche = LinearizabilityChecker::create(&getConsChecker(), *getConf()->checkLinSpec,
+							  getConf()->linSpecCacheSize);
 }
 
 GenMCDriver::~GenMCDriver() = default;
 
+auto GenMCDriver::createExecutionGraph() -> std::unique_ptr<ExecutionGraph>
+{
+	auto initValGetter = [this](const auto &access) { return getEE()->getLocInitVal(access); };
+	std::unique_ptr<ExecutionGraph> g;
+	if (userConf->isDepTrackingModel)
+		g = std::make_unique<DepExecutionGraph>(initValGetter);
+	else
+		g = std::make_unique<ExecutionGraph>(initValGetter);
+
+	/* Fingerprints are only needed for detecting duplicates */
+	auto detectDuplicates = userConf->pruneDuplicates;
+	GENMC_DEBUG(detectDuplicates |= userConf->countDuplicateExecs;);
+	if (detectDuplicates)
+		g->enableFingerprints();
+	return g;
+}
+
 GenMCDriver::Execution::Execution(std::unique_ptr<ExecutionGraph> g, LocalQueueT &&w, ChoiceMap &&m,
-				  SAddrAllocator &&alloctor, Event lastAdded)
+				  SAddrAllocator &&alloctor, Event lastAdded, unsigned depth /* = 0 */)
 	: graph(std::move(g)), workqueue(std::move(w)), choices(std::move(m)),
-	  alloctor(std::move(alloctor)), lastAdded(lastAdded)
+	  alloctor(std::move(alloctor)), lastAdded(lastAdded), depth(depth)
 {}
 GenMCDriver::Execution::~Execution() = default;
 
@@ -178,18 +207,57 @@ void GenMCDriver::initFromState(std::unique_ptr<Execution> exec)
 {
 	execStack.clear();
 	execStack.emplace_back(std::move(exec->graph), LocalQueueT(), std::move(exec->choices),
-			       std::move(exec->alloctor), exec->lastAdded);
+			       std::move(exec->alloctor), exec->lastAdded, exec->depth);
 
 	/* We have to also reset the initvalgetter */
 	getExec().getGraph().setInitValGetter(
 		[&](auto &access) { return getEE()->getLocInitVal(access); });
 }
 
+void GenMCDriver::submitTask(std::unique_ptr<Execution> t)
+{
+	if (auto *rw = getRemoteWorker())
+		rw->submit(std::move(t));
+	else
+		getThreadPool()->submit(std::move(t));
+}
+
 std::unique_ptr<GenMCDriver::Execution> GenMCDriver::extractState()
 {
 	return std::make_unique<Execution>(GenMCDriver::Execution(
 		getExec().getGraph().clone(), LocalQueueT(), ChoiceMap(getExec().getChoiceMap()),
-		SAddrAllocator(getExec().getAllocator()), getExec().getLastAdded()));
+		SAddrAllocator(getExec().getAllocator()), getExec().getLastAdded(),
+		getExec().getDepth()));
+}
+
+bool GenMCDriver::shouldSplitRevisit(unsigned removed) const
+{
+	auto *tp = getThreadPool();
+	auto *rw = getRemoteWorker();
+	if (!tp && !rw)
+		return false;
+
+	auto size = tp ? tp->size() : rw->size();
+	auto pending = tp ? tp->getRemainingTasks() : rw->getRemainingTasks();
+	auto idle = tp ? tp->getIdleWorkers() : rw->getIdleWorkers();
+	auto nearRoot = getExec().getDepth() <= getConf()->splitDepth;
+	switch (getConf()->splitPolicy) {
+	case SplitPolicy::fixed:
+		return pending < 8 * size;
+	case SplitPolicy::depth:
+		return nearRoot && pending < 8 * size;
+	case SplitPolicy::adaptive: {
+		/* Only split if some thread is (about to be) starving. Near the root,
+		 * subtrees are typically large; deeper down, only split if the
+		 * events to be re-explored outnumber the ones that will be replayed */
+		if (idle == 0 && pending >= size)
+			return false;
+		return nearRoot || removed >= getExec().getGraph().getNumEvents();
+	}
+	default:
+		BUG();
+	}
+	BUG();
 }
 
 /* Returns a fresh address to be used from the interpreter */
@@ -433,6 +501,102 @@ void GenMCDriver::handleExecutionStart()
 		BUG_ON(!thr.ECStack.empty());
 		thr.ECStack = thr.initEC;
 	}
+
+	/* Opt: Skip as much of the prefix (to be replayed) as possible */
+	restoreThreadSnapshots();
+}
+
+/* Opt: Returns the value the interpreter obtains from LAB (if any).
+ * The behavior of a thread only depends on the values it obtains */
+static auto getObservedValue(const EventLabel *lab) -> std::optional<SVal>
+{
+	if (lab->returnsValue())
+		return lab->getReturnValue();
+	if (auto *mLab = llvm::dyn_cast<MallocLabel>(lab))
+		return SVal(mLab->getAllocAddr().get());
+	if (auto *tcLab = llvm::dyn_cast<ThreadCreateLabel>(lab))
+		return SVal(tcLab->getChildId());
+	return std::nullopt;
+}
+
+void GenMCDriver::cacheThreadSnapshot(const ReadLabel *lab)
+{
+	auto &g = getExec().getGraph();
+	auto *EE = getEE();
+
+	/* Only snapshot the main program, and only if the interpreter is actually
+	 * executing LAB (it is not, e.g., when LAB comes from the instruction cache) */
+	if (snapshots.getCapacity() == 0 || inEstimationMode() ||
+	    EE->getProgramState() != llvm::ProgramState::Main || EE->currPos() != lab->getPos())
+		return;
+
+	auto snap = EE->takeThreadSnapshot();
+	if (!snap)
+		return;
+
+	std::vector<SVal> vals;
+	std::size_t hash = 0;
+	for (auto i = 0; i < lab->getIndex(); i++) {
+		if (auto val = getObservedValue(g.getEventLabel(Event(lab->getThread(), i)))) {
+			vals.push_back(*val);
+			hash_combine(hash, val->get());
+		}
+	}
+	snapshots.insert({lab->getThread(), hash},
+			 {std::move(vals), std::make_unique<llvm::ThreadSnapshot>(std::move(*snap))});
+}
+
+void GenMCDriver::restoreThreadSnapshots()
+{
+	auto &g = getExec().getGraph();
+
+	if (snapshots.size() == 0 || inEstimationMode())
+		return;
+
+	for (auto i = 0u; i < g.getNumThreads(); i++) {
+		if (getEE()->getThrById(i).ECStack.empty() ||
+		    static_cast<int>(i) == g.getRecoveryRoutineId())
+			continue;
+		resumeFromSnapshot(i);
+	}
+}
+
+void GenMCDriver::resumeFromSnapshot(unsigned int tid)
+{
+	auto &g = getExec().getGraph();
+	auto &thr = getEE()->getThrById(tid);
+
+	/* Collect the snapshots taken under the same (hash of) observed values,
+	 * either at one of the thread's reads or right after its last event ... */
+	std::vector<const CachedSnapshot *> candidates;
+	std::vector<SVal> vals;
+	std::size_t hash = 0;
+	auto size = g.getThreadSize(tid);
+	auto canResumeAtEnd = !llvm::isa<BlockLabel>(g.getLastThreadLabel(tid));
+	for (auto j = 0u; j <= size; j++) {
+		auto *lab = j < size ? g.getEventLabel(Event(tid, j)) : nullptr;
+		if (lab ? llvm::isa<ReadLabel>(lab) : canResumeAtEnd) {
+			auto *entry = snapshots.lookup({tid, hash});
+			if (entry && entry->snap->globalInstructions + 1 == j &&
+			    entry->vals.size() == vals.size())
+				candidates.push_back(entry);
+		}
+		if (!lab)
+			break;
+		if (auto val = getObservedValue(lab)) {
+			vals.push_back(*val);
+			hash_combine(hash, val->get());
+		}
+	}
+
+	/* ... and resume from the latest one whose values actually match */
+	auto it = std::find_if(candidates.rbegin(), candidates.rend(), [&](auto *entry) {
+		return entry->snap->threadFun == thr.threadFun &&
+		       entry->snap->threadArg == thr.threadArg &&
+		       std::equal(entry->vals.begin(), entry->vals.end(), vals.begin());
+	});
+	if (it != candidates.rend())
+		getEE()->restoreThreadSnapshot(tid, *(*it)->snap);
 }
 
 std::pair<std::vector<SVal>, std::vector<Event>> GenMCDriver::extractValPrefix(Event pos)
@@ -570,12 +734,50 @@ void GenMCDriver::updateStSpaceEstimation()
 	 * normalize over the max samples to avoid overflows. Instead,
 	 * use Welford's online algorithm to calculate mean and
 	 * variance. */
-	auto prevM = result.estimationMean;
-	auto prevV = result.estimationVariance;
-	result.estimationMean += (sample - prevM) / totalExplored;
-	result.estimationVariance +=
-		(sample - prevM) / totalExplored * (sample - result.estimationMean) -
-		prevV / totalExplored;
+	auto addSample = [&](auto &mean, auto &variance, long double n) {
+		auto prevM = mean;
+		auto prevV = variance;
+		mean += (sample - prevM) / n;
+		variance += (sample - prevM) / n * (sample - mean) - prevV / n;
+	};
+	addSample(result.estimationMean, result.estimationVariance, totalExplored);
+
+	/* Also account for the sample globally, if others are estimating too */
+	if (auto *shared = std::get<EstimationMode>(mode).shared) {
+		std::lock_guard<std::mutex> lock(shared->mutex);
+		++shared->samples;
+		addSample(shared->mean, shared->variance, shared->samples);
+	}
+}
+
+static auto isEstimationPrecise(const Config *conf, unsigned int samples, long double mean,
+				long double variance) -> bool
+{
+	auto sd = std::sqrt(variance);
+	return (samples >= conf->estimationMin) &&
+	       (sd <= mean / conf->sdThreshold || samples > mean);
+}
+
+bool GenMCDriver::shouldStopEstimating()
+{
+	auto &est = std::get<EstimationMode>(mode);
+
+	/* In parallel mode, both the budget and the criterion are global */
+	if (auto *shared = est.shared) {
+		std::lock_guard<std::mutex> lock(shared->mutex);
+		if (!shared->done)
+			shared->done = --shared->budget == 0 ||
+				       isEstimationPrecise(getConf(), shared->samples,
+							   shared->mean, shared->variance);
+		return shared->done;
+	}
+
+	auto remainingBudget = --est.budget;
+	if (remainingBudget == 0)
+		return true;
+
+	return isEstimationPrecise(getConf(), result.explored + result.exploredBlocked,
+				   result.estimationMean, result.estimationVariance);
 }
 
 static const auto maybeTimeRelinche = [](auto &&relinche, auto &&g) {
@@ -629,6 +831,8 @@ void GenMCDriver::handleExecutionEnd()
 	++result.explored;
 	if (fullExecutionExceedsBound())
 		++result.boundExceeding;
+	GENMC_DEBUG(if (getConf()->countDuplicateExecs && !inEstimationMode() &&
+			!visited->insert(getExec().getGraph().getFingerprint())) ++result.duplicates;);
 
 	if (isHalting() || isExecutionBlocked() || isMoot())
 		return;
@@ -638,8 +842,7 @@ void GenMCDriver::handleExecutionEnd()
 
 	/* Relinche: Collect/check abstract behavior */
 	if (getConf()->collectLinSpec)
-		result.specification->add(getExec().getGraph(), &getConsChecker(),
-					  getConf()->symmetryReduction);
+		result.observations->add(getExec().getGraph(), &getConsChecker());
 	if (getConf()->checkLinSpec) {
 		result.relincheResult += maybeTimeRelinche(getRelinche(), getExec().getGraph());
 		if (result.relincheResult.status) {
@@ -705,7 +908,8 @@ void GenMCDriver::run()
 bool GenMCDriver::isHalting() const
 {
 	auto *tp = getThreadPool();
-	return shouldHalt || (tp && tp->shouldHalt());
+	auto *rw = getRemoteWorker();
+	return shouldHalt || (tp && tp->shouldHalt()) || (rw && rw->shouldHalt());
 }
 
 void GenMCDriver::halt(VerificationError status)
@@ -714,30 +918,48 @@ void GenMCDriver::halt(VerificationError status)
 	result.status = status;
 	if (getThreadPool())
 		getThreadPool()->halt();
+	if (getRemoteWorker())
+		getRemoteWorker()->halt();
 }
 
 GenMCDriver::Result GenMCDriver::verify(std::shared_ptr<const Config> conf,
 					std::unique_ptr<llvm::Module> mod,
 					std::unique_ptr<ModuleInfo> modInfo)
 {
+	/* Distribute the exploration across processes, if requested */
+	if (conf->processes > 0 || conf->listenAddr) {
+		ProcessPool pool(conf, std::move(mod), std::move(modInfo));
+		return pool.run();
+	}
+
 	/* Spawn a single or multiple drivers depending on the configuration */
 	if (conf->threads == 1) {
 		auto driver = GenMCDriver::create(conf, std::move(mod), std::move(modInfo));
+		if (conf->resumeFile)
+			driver->restoreCheckpoint(*conf->resumeFile);
 		driver->run();
+
+		/* Nothing is pending anymore */
+		if (conf->checkpointFile && !driver->isHalting())
+			llvm::sys::fs::remove(*conf->checkpointFile);
 		auto res = std::move(driver->getResult());
 		return res;
 	}
 
-	std::vector<std::future<GenMCDriver::Result>> futures;
+	GenMCDriver::Result res;
 	{
-		/* Then, fire up the drivers */
+		/* Then, fire up the drivers (the pool restores any checkpoint) */
 		ThreadPool pool(conf, mod, modInfo);
-		futures = pool.waitForTasks();
-	}
+		auto futures = pool.waitForTasks();
+		for (auto &f : futures) {
+			res += f.get();
+		}
+		if (conf->checkpointFile && !pool.shouldHalt())
+			llvm::sys::fs::remove(*conf->checkpointFile);
 
-	GenMCDriver::Result res;
-	for (auto &f : futures) {
-		res += f.get();
+		/* All workers are done; their statistics are final */
+		if (conf->printPoolStats)
+			pool.printStats(llvm::outs());
 	}
 	return res;
 }
@@ -746,13 +968,39 @@ GenMCDriver::Result GenMCDriver::estimate(std::shared_ptr<const Config> conf,
 					  const std::unique_ptr<llvm::Module> &mod,
 					  const std::unique_ptr<ModuleInfo> &modInfo)
 {
-	auto estCtx = std::make_unique<llvm::LLVMContext>();
-	auto newmod = LLVMModule::cloneModule(mod, estCtx);
-	auto newMI = modInfo->clone(*newmod);
-	auto driver = GenMCDriver::create(conf, std::move(newmod), std::move(newMI), nullptr,
-					  GenMCDriver::EstimationMode{conf->estimationMax});
-	driver->run();
-	return std::move(driver->getResult());
+	if (conf->threads == 1) {
+		auto estCtx = std::make_unique<llvm::LLVMContext>();
+		auto newmod = LLVMModule::cloneModule(mod, estCtx);
+		auto newMI = modInfo->clone(*newmod);
+		auto driver = GenMCDriver::create(conf, std::move(newmod), std::move(newMI),
+						  nullptr,
+						  GenMCDriver::EstimationMode{conf->estimationMax});
+		driver->run();
+		return std::move(driver->getResult());
+	}
+
+	/* Samples are independent, so spawn one driver (with its own context and
+	 * RNG) per thread; the budget and the stopping criterion are shared */
+	SharedEstimation shared(conf->estimationMax);
+	std::vector<std::unique_ptr<llvm::LLVMContext>> contexts;
+	std::vector<std::future<Result>> futures;
+	for (auto i = 0U; i < conf->threads; i++) {
+		contexts.push_back(std::make_unique<llvm::LLVMContext>());
+		auto newmod = LLVMModule::cloneModule(mod, contexts.back());
+		auto newMI = modInfo->clone(*newmod);
+		auto driver = GenMCDriver::create(
+			conf, std::move(newmod), std::move(newMI), nullptr,
+			GenMCDriver::EstimationMode{conf->estimationMax, &shared});
+		futures.push_back(std::async(std::launch::async, [d = std::move(driver)]() {
+			d->run();
+			return std::move(d->getResult());
+		}));
+	}
+
+	GenMCDriver::Result res;
+	for (auto &f : futures)
+		res += f.get();
+	return res;
 }
 
 /************************************************************
@@ -842,6 +1090,17 @@ bool GenMCDriver::rescheduleReads()
 	return false;
 }
 
+bool GenMCDriver::isEventScheduling() const
+{
+	/* Running a local instruction changes neither the graph nor the state of other
+	 * threads. As long as the next instruction is local too (and thus not a load),
+	 * scheduleNext() would make the same choice again. That does not hold for
+	 * randomized policies, as they draw a new number for every choice */
+	auto policy = getConf()->schedulePolicy;
+	return getConf()->eventScheduling && !inEstimationMode() &&
+	       (policy == SchedulePolicy::ltr || policy == SchedulePolicy::wf);
+}
+
 bool GenMCDriver::scheduleNext()
 {
 	if (isMoot() || isHalting())
@@ -869,13 +1128,22 @@ bool GenMCDriver::scheduleNext()
 	return rescheduleReads();
 }
 
-std::vector<ThreadInfo> createExecutionContext(const ExecutionGraph &g)
+/*
+ * Collects the threads of all graphs in the execution stack; the EE
+ * needs to know about every one of them, as graphs lower in the stack
+ * might have threads that the top one lacks. (Normally, the stack only
+ * contains a single graph at this point.)
+ */
+std::vector<ThreadInfo> createExecutionContext(const std::vector<GenMCDriver::Execution> &stack)
 {
 	std::vector<ThreadInfo> tis;
-	for (auto i = 1u; i < g.getNumThreads(); i++) { // skip main
-		auto *bLab = g.getFirstThreadLabel(i);
-		BUG_ON(!bLab);
-		tis.push_back(bLab->getThreadInfo());
+	for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+		const auto &g = it->getGraph();
+		for (auto i = tis.size() + 1; i < g.getNumThreads(); i++) { // skip main
+			auto *bLab = g.getFirstThreadLabel(i);
+			BUG_ON(!bLab);
+			tis.push_back(bLab->getThreadInfo());
+		}
 	}
 	return tis;
 }
@@ -885,14 +1153,17 @@ void GenMCDriver::explore()
 	auto *EE = getEE();
 
 	resetExplorationOptions();
-	EE->setExecutionContext(createExecutionContext(getExec().getGraph()));
+	EE->setExecutionContext(createExecutionContext(execStack));
 	while (!isHalting()) {
 		EE->reset();
 
-		/* Get main program function and run the program */
-		EE->runAsMain(getConf()->programEntryFun);
-		if (getConf()->persevere)
-			EE->runRecovery();
+		/* Get main program function and run the program. (If the exploration
+		 * was just resumed, the current execution has already been explored) */
+		if (!std::exchange(resumed, false)) {
+			EE->runAsMain(getConf()->programEntryFun);
+			if (getConf()->persevere)
+				EE->runRecovery();
+		}
 
 		auto validExecution = false;
 		while (!validExecution) {
@@ -903,17 +1174,306 @@ void GenMCDriver::explore()
 			 */
 			resetExplorationOptions();
 
+			/* No exploration is in progress here: a good time to checkpoint */
+			checkpointIfDue();
+			if (isHalting())
+				return;
+
 			auto item = getExec().getWorkqueue().getNext();
 			if (!item) {
 				if (popExecution())
 					continue;
+				/* Tasks restored from a checkpoint have yet to be run */
+				if (popRestoredTask())
+					break;
 				return;
 			}
 			validExecution = restrictAndRevisit(item) && isRevisitValid(*item);
+			if (validExecution && getConf()->pruneDuplicates && !inEstimationMode() &&
+			    isRevisitDuplicate()) {
+				++result.pruned;
+				validExecution = false;
+			}
 		}
 	}
 }
 
+bool GenMCDriver::isRevisitDuplicate()
+{
+	/* The rest of the exploration depends not only on the graph, but also
+	 * on the labels' insertion order and revisiting status, as well as on
+	 * the event added last (which guides scheduling) */
+	auto &g = getExec().getGraph();
+	std::size_t key = g.getFingerprint();
+	hash_combine(key, g.getOrderFingerprint());
+	hash_combine(key, getExec().getLastAdded());
+
+	/* Mixing once more keeps prefixes apart from complete executions, which are
+	 * keyed by their fingerprint alone (see -count-duplicate-execs) */
+	return !visited->insert(hash_mix(key));
+}
+
+/************************************************************
+ ** Serialization methods
+ ***********************************************************/
+
+/* Prints the options that affect what gets explored (and thus the results) */
+static void printExplorationOptions(llvm::raw_ostream &s, const Config &conf)
+{
+	auto b = [](bool v) { return v ? "1" : "0"; };
+	auto u = [](auto v) { return std::to_string(static_cast<unsigned>(v)); };
+
+	s << "; model " << u(conf.model) << "\n";
+	s << "; bound " << (conf.bound ? std::to_string(*conf.bound) : "none") << " "
+	  << u(conf.boundType) << "\n";
+	s << "; lapor " << b(conf.LAPOR) << " symmetry " << b(conf.symmetryReduction)
+	  << " helper " << b(conf.helper) << " liveness " << b(conf.checkLiveness) << " ipr "
+	  << b(conf.ipr) << " bam " << b(!conf.disableBAM) << "\n";
+	s << "; races " << b(!conf.disableRaceDetection) << " stop-on-system-error "
+	  << b(!conf.disableStopOnSystemError) << "\n";
+	s << "; prune-duplicates " << b(conf.pruneDuplicates) << " " << conf.visitedSetSize
+	  << "\n";
+	s << "; check-lin-spec " << conf.checkLinSpec.value_or("") << " " << conf.maxExtSize
+	  << "\n";
+	s << "; persevere " << b(conf.persevere) << " " << conf.blockSize << " "
+	  << conf.maxFileSize << " " << u(conf.journalData) << " " << b(conf.disableDelalloc)
+	  << "\n";
+	s << "; schedule " << u(conf.schedulePolicy) << " " << b(conf.eventScheduling) << " "
+	  << (conf.schedulePolicy == SchedulePolicy::arbitrary ? conf.randomScheduleSeed : "")
+	  << "\n";
+	s << "; entry " << conf.programEntryFun << "\n";
+}
+
+auto GenMCDriver::computeFingerprint(const llvm::Module &mod, const Config &conf) -> uint64_t
+{
+	std::string ir;
+	llvm::raw_string_ostream irs(ir);
+	mod.print(irs, nullptr);
+	irs.flush();
+
+	/* Skip the module's identifier and source file name, which name the
+	 * (temporary) files the module was compiled from and read from */
+	while (llvm::StringRef(ir).startswith("; ModuleID") ||
+	       llvm::StringRef(ir).startswith("source_filename"))
+		ir.erase(0, ir.find('\n') + 1);
+	printExplorationOptions(irs, conf);
+	irs.flush();
+
+	/* The fingerprint is stored in checkpoints, so it needs to be stable
+	 * across runs and builds (unlike std::hash) */
+	auto digest = llvm::SHA1::hash(llvm::arrayRefFromStringRef(ir));
+	return llvm::support::endian::read64le(digest.data());
+}
+
+void serialize(BinaryWriter &w, const GenMCDriver::Result &res)
+{
+	w.write(res.status);
+	w.writeString(res.message);
+	w.writeRange(res.warnings);
+	w.write(res.explored);
+	w.write(res.exploredBlocked);
+	w.write(res.boundExceeding);
+	w.write(res.pruned);
+	w.write(res.estimationMean);
+	w.write(res.estimationVariance);
+	serialize(w, res.relincheResult);
+#ifdef ENABLE_GENMC_DEBUG
+	w.write(res.exploredMoot);
+	w.write(res.duplicates);
+	w.writeSize(res.exploredBounds.size());
+	for (auto i = 0U; i < res.exploredBounds.size(); i++)
+		w.write(res.exploredBounds[i]);
+#endif
+}
+
+void deserialize(BinaryReader &r, GenMCDriver::Result &res)
+{
+	res.status = r.read<VerificationError>();
+	res.message = r.readString();
+	res.warnings = r.readVector<VerificationError>();
+	res.explored = r.read<unsigned>();
+	res.exploredBlocked = r.read<unsigned>();
+	res.boundExceeding = r.read<unsigned>();
+	res.pruned = r.read<unsigned>();
+	res.estimationMean = r.read<long double>();
+	res.estimationVariance = r.read<long double>();
+	deserialize(r, res.relincheResult);
+#ifdef ENABLE_GENMC_DEBUG
+	res.exploredMoot = r.read<unsigned>();
+	res.duplicates = r.read<unsigned>();
+	auto numBounds = r.readSize(sizeof(int));
+	if (numBounds > 0)
+		res.exploredBounds.grow(numBounds - 1);
+	for (auto i = 0U; i < numBounds; i++)
+		res.exploredBounds[i] = r.read<int>();
+#endif
+}
+
+void serialize(BinaryWriter &w, const GenMCDriver::Execution &exec)
+{
+	exec.getGraph().serialize(w);
+	serialize(w, exec.getWorkqueue());
+	serialize(w, exec.getChoiceMap());
+	serialize(w, exec.getAllocator());
+	w.write(exec.getLastAdded());
+	w.write(exec.getDepth());
+}
+
+std::unique_ptr<GenMCDriver::Execution> GenMCDriver::deserializeExecution(BinaryReader &r)
+{
+	auto g = createExecutionGraph();
+	g->deserialize(r);
+	LocalQueueT workqueue;
+	deserialize(r, workqueue);
+	ChoiceMap choices;
+	deserialize(r, choices);
+	SAddrAllocator alloctor;
+	deserialize(r, alloctor);
+	auto lastAdded = r.read<Event>();
+	auto depth = r.read<unsigned>();
+	return std::make_unique<Execution>(std::move(g), std::move(workqueue), std::move(choices),
+					   std::move(alloctor), lastAdded, depth);
+}
+
+/************************************************************
+ ** Checkpointing methods
+ ***********************************************************/
+
+/*
+ * A checkpoint contains everything that has yet to be explored: the
+ * executions that have been explored but still have pending revisits
+ * (graphs along with their revisits, choices, and allocators), the tasks
+ * that have not been run yet, as well as the results so far. Checkpoints
+ * are only taken in between executions, so no interpreter state needs to
+ * be saved. (The thread pool stops all of its workers at such a point to
+ * take a checkpoint, so that it can save the executions of all of them.)
+ */
+static constexpr uint32_t checkpointMagic = 0x4b43434d; /* "MCCK" */
+static constexpr uint32_t checkpointVersion = 2;
+#ifdef ENABLE_GENMC_DEBUG
+static constexpr bool checkpointDebugCounters = true;
+#else
+static constexpr bool checkpointDebugCounters = false;
+#endif
+
+void GenMCDriver::checkpointIfDue()
+{
+	if (!getConf()->checkpointFile || inEstimationMode())
+		return;
+
+	/* A pool's checkpoint covers all of its workers, so the pool takes it */
+	if (auto *tp = getThreadPool()) {
+		tp->checkpointIfDue(*this, result.explored -
+						   std::exchange(reportedExplored, result.explored));
+		return;
+	}
+
+	/* Stopping after a given number of executions makes interruptions reproducible */
+	auto stop = getConf()->checkpointStopAfter &&
+		    result.explored >= *getConf()->checkpointStopAfter;
+	auto now = std::chrono::steady_clock::now();
+	if (!stop && now - lastCheckpoint < std::chrono::seconds(getConf()->checkpointInterval))
+		return;
+	writeCheckpoint();
+	lastCheckpoint = now;
+
+	if (stop) {
+		PRINT(VerbosityLevel::Error) << "Checkpoint taken after " << result.explored
+					     << " complete executions; stopping.\n";
+		result.interrupted = true;
+		halt(result.status);
+	}
+}
+
+bool GenMCDriver::popRestoredTask()
+{
+	if (restoredTasks.empty())
+		return false;
+	auto task = std::move(restoredTasks.back());
+	restoredTasks.pop_back();
+	initFromState(std::move(task));
+	return true;
+}
+
+void GenMCDriver::writeCheckpoint()
+{
+	std::vector<const Execution *> execs;
+	std::vector<const Execution *> tasks;
+	for (const auto &exec : execStack)
+		execs.push_back(&exec);
+	for (const auto &task : restoredTasks)
+		tasks.push_back(task.get());
+	writeCheckpoint({&result}, execs, tasks);
+}
+
+void GenMCDriver::writeCheckpoint(const std::vector<const Result *> &results,
+				  const std::vector<const Execution *> &execs,
+				  const std::vector<const Execution *> &tasks) const
+{
+	/* Write to a temporary file first, so that a crash never leaves a partial checkpoint */
+	const auto &file = *getConf()->checkpointFile;
+	auto tmpFile = file + ".tmp";
+	{
+		std::error_code ec;
+		llvm::raw_fd_ostream os(tmpFile, ec);
+		handleFSError(ec, "Could not write checkpoint " + tmpFile + "\n");
+
+		BinaryWriter w(os);
+		w.write(checkpointMagic);
+		w.write(checkpointVersion);
+		w.write(checkpointDebugCounters);
+		w.write(checkpointFingerprint);
+
+		w.writeSize(results.size());
+		for (const auto *res : results)
+			serialize(w, *res);
+		w.writeSize(execs.size());
+		for (const auto *exec : execs)
+			serialize(w, *exec);
+		w.writeSize(tasks.size());
+		for (const auto *task : tasks)
+			serialize(w, *task);
+		os.close();
+		handleFSError(os.error(), "Could not write checkpoint " + tmpFile + "\n");
+	}
+	handleFSError(llvm::sys::fs::rename(tmpFile, file),
+		      "Could not write checkpoint " + file + "\n");
+}
+
+void GenMCDriver::restoreCheckpoint(const std::string &file)
+{
+	auto bufOrErr = llvm::MemoryBuffer::getFile(file);
+	if (!bufOrErr)
+		handleFSError(bufOrErr.getError(), "Could not read checkpoint " + file + "\n");
+
+	const auto &buf = *bufOrErr;
+	BinaryReader r(buf->getBufferStart(), buf->getBufferEnd());
+	ERROR_ON(r.read<uint32_t>() != checkpointMagic, file + " is not a checkpoint file!\n");
+	ERROR_ON(r.read<uint32_t>() != checkpointVersion ||
+			 r.read<bool>() != checkpointDebugCounters,
+		 "Checkpoint " + file + " was written by a different version of GenMC!\n");
+	ERROR_ON(r.read<uint64_t>() != checkpointFingerprint,
+		 "Checkpoint " + file + " was taken for a different program or different options!\n");
+
+	/* Results are summed up when a pool's workers finish anyway */
+	for (auto n = r.readSize(); n > 0; --n) {
+		Result res;
+		deserialize(r, res);
+		result += std::move(res);
+	}
+	execStack.clear();
+	for (auto n = r.readSize(); n > 0; --n)
+		execStack.push_back(std::move(*deserializeExecution(r)));
+	restoredTasks.clear();
+	for (auto n = r.readSize(); n > 0; --n)
+		restoredTasks.push_back(deserializeExecution(r));
+	ERROR_ON(!r.atEnd(), "Checkpoint " + file + " is corrupted!\n");
+
+	/* The top execution has already been explored; if there is none, run a task */
+	resumed = !execStack.empty();
+	ERROR_ON(!resumed && !popRestoredTask(), "Checkpoint " + file + " is corrupted!\n");
+}
+
 bool isUninitializedAccess(const SAddr &addr, const Event &pos)
 {
 	return addr.isDynamic() && pos.isInitializer();
@@ -1637,6 +2197,10 @@ int GenMCDriver::handleThreadCreate(std::unique_ptr<ThreadCreateLabel> tcLab)
 							       lab->getChildInfo(), symm));
 	if (symm != -1)
 		g.getFirstThreadLabel(symm)->setSymmSuccTid(cid);
+
+	/* Opt: The new thread might have run before */
+	if (snapshots.size() > 0 && !inEstimationMode())
+		resumeFromSnapshot(cid);
 	return cid;
 }
 
@@ -1864,6 +2428,7 @@ std::optional<SVal> GenMCDriver::handleLoad(std::unique_ptr<ReadLabel> rLab)
 	if (!rLab->getAnnot())
 		rLab->setAnnot(EE->getCurrentAnnotConcretized());
 	auto *lab = llvm::dyn_cast<ReadLabel>(addLabelToGraph(std::move(rLab)));
+	cacheThreadSnapshot(lab);
 
 	if (checkAccessValidity(lab) != VerificationError::VE_OK ||
 	    checkForRaces(lab) != VerificationError::VE_OK ||
@@ -1946,11 +2511,9 @@ static auto getRevisitable(WriteLabel *sLab, const VectorClock &before) -> std::
 		return loads;
 	}
 
-	/* Slowpath: iterate over all same-location reads */
-	for (auto it = ++ExecutionGraph::reverse_label_iterator(sLab);
-	     it != ExecutionGraph::reverse_label_iterator(g.getInitLabel()); ++it) {
-		auto *rLab = llvm::dyn_cast<ReadLabel>(&*it);
-		if (rLab && rLab->getAddr() == sLab->getAddr() && !rLab->isStable() &&
+	/* Slowpath: iterate over all same-location reads added before SLAB */
+	for (auto *rLab : g.loc_reads(sLab->getAddr()) | std::views::reverse) {
+		if (rLab->getStamp() < sLab->getStamp() && !rLab->isStable() &&
 		    !before.contains(rLab->getPos()))
 			loads.push_back(rLab);
 	}
@@ -2890,24 +3453,26 @@ bool GenMCDriver::backwardRevisit(const BackwardRevisit &br)
 				brh ? g.getWriteLabel(brh->getMid()) : nullptr);
 
 	auto og = copyGraph(&br, &*v);
+	auto removed = g.getNumEvents() - og->getNumEvents();
 	auto cmap = ChoiceMap(getExec().getChoiceMap());
 	cmap.cut(*v);
 	auto alloctor = SAddrAllocator(getExec().getAllocator());
 	alloctor.restrict(createAllocView(*og));
 
-	pushExecution(
-		{std::move(og), LocalQueueT(), std::move(cmap), std::move(alloctor), br.getPos()});
+	pushExecution({std::move(og), LocalQueueT(), std::move(cmap), std::move(alloctor),
+		       br.getPos(), getExec().getDepth() + 1});
 
 	repairDanglingReads(getExec().getGraph());
 	auto ok = revisitRead(br);
 	BUG_ON(!ok);
 
-	/* If there are idle workers in the thread pool,
-	 * try submitting the job instead */
-	auto *tp = getThreadPool();
-	if (tp && tp->getRemainingTasks() < 8 * tp->size()) {
+	/* If the split policy deems it worthwhile, submit the job to the
+	 * thread pool (or the coordinator) instead. The new execution is
+	 * fresh, so we can hand it over as is rather than copying it */
+	if (shouldSplitRevisit(removed)) {
 		if (isRevisitValid(br))
-			tp->submit(extractState());
+			submitTask(std::make_unique<Execution>(std::move(getExec())));
+		popExecution();
 		return false;
 	}
 	return true;
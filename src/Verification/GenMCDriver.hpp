@@ -21,10 +21,13 @@
 #ifndef GENMC_GENMC_DRIVER_HPP
 #define GENMC_GENMC_DRIVER_HPP
 
+#include "ADT/LRUCache.hpp"
 #include "ADT/Trie.hpp"
+#include "ADT/VisitedSet.hpp"
 #include "Config/Config.hpp"
 #include "ExecutionGraph/EventLabel.hpp"
 #include "ExecutionGraph/ExecutionGraph.hpp"
+#include "Support/Hash.hpp"
 #include "Support/SAddrAllocator.hpp"
 #include "Verification/ChoiceMap.hpp"
 #include "Verification/Relinche/LinearizabilityChecker.hpp"
@@ -38,15 +41,20 @@
 #include <cstdint>
 #include <ctime>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <utility>
 #include <variant>
 
 namespace llvm {
 class Interpreter;
+struct ThreadSnapshot;
 }
 class ModuleInfo;
 class ThreadPool;
+class RemoteWorker;
+class BinaryWriter;
+class BinaryReader;
 class BoundDecider;
 class ConsistencyChecker;
 class SymmetryChecker;
@@ -60,11 +68,43 @@ protected:
 		unsigned int,
 		Trie<std::vector<SVal>, std::vector<std::unique_ptr<EventLabel>>, SValUCmp>>;
 
+	/** Opt: A thread snapshot, along with the values the thread had read when it was taken */
+	struct CachedSnapshot {
+		std::vector<SVal> vals;
+		std::unique_ptr<llvm::ThreadSnapshot> snap;
+	};
+
+	/** Opt: Snapshots are keyed by thread and a hash of the values the thread has read */
+	using SnapshotKeyT = std::pair<unsigned int, std::size_t>;
+	struct SnapshotKeyHasher {
+		auto operator()(const SnapshotKeyT &k) const -> std::size_t
+		{
+			auto hash = k.second;
+			hash_combine(hash, k.first);
+			return hash;
+		}
+	};
+	using SnapshotCacheT = LRUCache<SnapshotKeyT, CachedSnapshot, SnapshotKeyHasher>;
+
 public:
 	/** The operating mode of the driver */
 	struct VerificationMode {};
+
+	/** Estimation state shared by drivers that estimate in parallel */
+	struct SharedEstimation {
+		explicit SharedEstimation(unsigned int budget) : budget(budget) {}
+
+		std::mutex mutex;
+		unsigned int budget;	      /**< Remaining samples (across all drivers) */
+		unsigned int samples{};	      /**< Samples taken (across all drivers) */
+		long double mean{};	      /**< The mean of all samples */
+		long double variance{};	      /**< The (biased) variance of all samples */
+		bool done{};		      /**< Whether estimation should stop */
+	};
+
 	struct EstimationMode {
 		unsigned int budget;
+		SharedEstimation *shared{}; /**< Non-null when estimating in parallel */
 	};
 	using Mode = std::variant<VerificationMode, EstimationMode>;
 
@@ -75,6 +115,7 @@ public:
 		unsigned explored{};	      /**< Number of complete executions explored */
 		unsigned exploredBlocked{};   /**< Number of blocked executions explored */
 		unsigned boundExceeding{};    /**< Number of bound-exceeding executions explored */
+		unsigned pruned{};	      /**< Number of revisits pruned as duplicates */
 		long double estimationMean{}; /**< The mean of estimations */
 		long double estimationVariance{}; /**< The (biased) variance of the estimations */
 #ifdef ENABLE_GENMC_DEBUG
@@ -83,9 +124,10 @@ public:
 		llvm::IndexedMap<int> exploredBounds{}; /**< Number of complete executions not
 							   exceeding each bound */
 #endif
+		bool interrupted{};				 /**< Stopped at a checkpoint */
 		std::string message{};				 /**< A message to be printed */
 		VSet<VerificationError> warnings{};		 /**< The warnings encountered */
-		std::unique_ptr<Specification> specification;	 /**< Spec collected (if any) */
+		std::shared_ptr<ObservationStore> observations;	 /**< Spec collected (if any) */
 		LinearizabilityChecker::Result relincheResult{}; /**< Spec analysis result */
 
 		Result() = default;
@@ -96,11 +138,24 @@ public:
 			if (other.status != VerificationError::VE_OK)
 				status = other.status;
 			message += other.message;
+
+			/* Combine estimations based on their sample counts (Chan et al.) */
+			auto n1 = (long double)explored + exploredBlocked;
+			auto n2 = (long double)other.explored + other.exploredBlocked;
+			if (n1 + n2 > 0) {
+				auto n = n1 + n2;
+				auto delta = other.estimationMean - estimationMean;
+				estimationVariance =
+					(n1 * estimationVariance + n2 * other.estimationVariance) / n +
+					delta * delta * n1 * n2 / (n * n);
+				estimationMean += delta * n2 / n;
+			}
+
 			explored += other.explored;
 			exploredBlocked += other.exploredBlocked;
 			boundExceeding += other.boundExceeding;
-			estimationMean += other.estimationMean;
-			estimationVariance += other.estimationVariance;
+			pruned += other.pruned;
+			interrupted |= other.interrupted;
 #ifdef ENABLE_GENMC_DEBUG
 			exploredMoot += other.exploredMoot;
 			/* Bound-blocked executions are calculated at the end */
@@ -110,9 +165,11 @@ public:
 			duplicates += other.duplicates;
 #endif
 			warnings.insert(other.warnings);
-			if (other.specification)
-				specification->merge(std::move(
-					*other.specification)); // FIXME other is const lvalue
+			/* Drivers of a thread pool share their store */
+			if (!observations)
+				observations = std::move(other.observations);
+			else if (other.observations && other.observations != observations)
+				observations->merge(std::move(*other.observations));
 			relincheResult += std::move(other.relincheResult);
 			return *this;
 		}
@@ -122,7 +179,7 @@ public:
 	struct Execution {
 		Execution() = delete;
 		Execution(std::unique_ptr<ExecutionGraph> g, LocalQueueT &&w, ChoiceMap &&cm,
-			  SAddrAllocator &&alloctor, Event lastAdded);
+			  SAddrAllocator &&alloctor, Event lastAdded, unsigned depth = 0);
 
 		Execution(const Execution &) = delete;
 		auto operator=(const Execution &) -> Execution & = delete;
@@ -145,6 +202,9 @@ public:
 		auto getLastAdded() const -> const Event & { return lastAdded; }
 		auto getLastAdded() -> Event & { return lastAdded; }
 
+		/** Returns the number of backward revisits leading to this execution */
+		auto getDepth() const -> unsigned { return depth; }
+
 		/** Removes all items with stamp >= STAMP from the execution */
 		void restrict(Stamp stamp);
 
@@ -155,6 +215,7 @@ public:
 		ChoiceMap choices;
 		SAddrAllocator alloctor;
 		Event lastAdded = Event::getInit();
+		unsigned depth = 0;
 	};
 
 	/** Details for an error to be reported */
@@ -186,6 +247,11 @@ public:
 			     const std::unique_ptr<llvm::Module> &mod,
 			     const std::unique_ptr<ModuleInfo> &modInfo) -> Result;
 
+	/** Returns a hash identifying MOD under the exploration options in CONF,
+	 * so that checkpoints and remote workers can ensure they agree on the
+	 * program being verified and on how it is explored */
+	static auto computeFingerprint(const llvm::Module &mod, const Config &conf) -> uint64_t;
+
 	/**** Generic actions ***/
 
 	/** Sets up the next thread to run in the interpreter */
@@ -194,6 +260,14 @@ public:
 	/** Opt: Tries to optimize the scheduling of next instruction by checking the cache */
 	bool tryOptimizeScheduling(Event pos);
 
+	/** Opt: Returns true if, once scheduled, a thread can keep running until its next
+	 * instruction that may add an event, as rescheduling in between would not pick
+	 * another thread */
+	bool isEventScheduling() const;
+
+	/** Returns true if this driver is shutting down */
+	bool isHalting() const;
+
 	/** Things to do when an execution starts/ends */
 	void handleExecutionStart();
 	void handleExecutionEnd();
@@ -273,6 +347,7 @@ public:
 
 protected:
 	friend class ThreadPool;
+	friend class RemoteWorker;
 
 	GenMCDriver(std::shared_ptr<const Config> conf, std::unique_ptr<llvm::Module> mod,
 		    std::unique_ptr<ModuleInfo> MI, ThreadPool *pool = nullptr,
@@ -318,6 +393,13 @@ protected:
 	ThreadPool *getThreadPool() const { return pool; }
 	void setThreadPool(ThreadPool *tp) { pool = tp; }
 
+	/** Gets/sets the coordinator connection of a worker process */
+	RemoteWorker *getRemoteWorker() const { return remote; }
+	void setRemoteWorker(RemoteWorker *rw) { remote = rw; }
+
+	/** Hands over task T to the thread pool or the coordinator */
+	void submitTask(std::unique_ptr<Execution> t);
+
 	/** Initializes the exploration from a given state */
 	void initFromState(std::unique_ptr<Execution> s);
 
@@ -325,6 +407,10 @@ protected:
 	 * The driver is left in an inconsistent form */
 	std::unique_ptr<Execution> extractState();
 
+	/** Returns true if a backward revisit that removed REMOVED events
+	 * from the graph should be shipped to the thread pool */
+	bool shouldSplitRevisit(unsigned removed) const;
+
 	/** Returns all values read leading up to POS */
 	std::pair<std::vector<SVal>, std::vector<Event>> extractValPrefix(Event pos);
 
@@ -341,18 +427,24 @@ protected:
 	bool inEstimationMode() const { return std::holds_alternative<EstimationMode>(mode); }
 
 	/** Est: Returns true if the estimation seems "good enough" */
-	bool shouldStopEstimating()
-	{
-		auto remainingBudget = --std::get<EstimationMode>(mode).budget;
-		if (remainingBudget == 0)
-			return true;
-
-		auto totalExplored = result.explored + result.exploredBlocked;
-		auto sd = std::sqrt(result.estimationVariance);
-		return (totalExplored >= getConf()->estimationMin) &&
-		       (sd <= result.estimationMean / getConf()->sdThreshold ||
-			totalExplored > result.estimationMean);
-	}
+	bool shouldStopEstimating();
+
+	/** Ckpt: Saves the pending exploration (execution stack, restored
+	 * tasks, and partial results) to the checkpoint file */
+	void writeCheckpoint();
+
+	/** Ckpt: Saves the (partial) results RESULTS, the explored executions
+	 * EXECS (which may have pending revisits), and the TASKS that have not
+	 * been run yet to the checkpoint file */
+	void writeCheckpoint(const std::vector<const Result *> &results,
+			     const std::vector<const Execution *> &execs,
+			     const std::vector<const Execution *> &tasks) const;
+
+	/** Ckpt: Replaces the pending exploration with the one saved in FILE */
+	void restoreCheckpoint(const std::string &file);
+
+	/** Reads back an execution written by serialize() */
+	std::unique_ptr<Execution> deserializeExecution(BinaryReader &r);
 
 private:
 	/*** Exploration-related ***/
@@ -365,8 +457,21 @@ private:
 	 * (e.g., consistent, accessing allocated memory, etc) */
 	bool isRevisitValid(const Revisit &revisit);
 
-	/** Returns true if this driver is shutting down */
-	bool isHalting() const;
+	/** Returns true if the graph (as restored by a revisit) has already been
+	 * explored, by this or another driver of the pool (see -prune-duplicates).
+	 * Graphs are only compared by fingerprint, so the check is probabilistic:
+	 * a collision makes an unexplored graph count as explored */
+	bool isRevisitDuplicate();
+
+	/** Returns a fresh graph of the kind the model requires */
+	std::unique_ptr<ExecutionGraph> createExecutionGraph();
+
+	/** Ckpt: Writes a checkpoint if one is due (and enabled) */
+	void checkpointIfDue();
+
+	/** Ckpt: Moves the next task restored from a checkpoint to the
+	 * execution stack. Returns false if there are none left */
+	bool popRestoredTask();
 
 	/** Returns true if this execution is moot */
 	bool isMoot() const { return isMootExecution; }
@@ -461,6 +566,16 @@ private:
 	/** Opt: Caches LAB to optimize scheduling next time */
 	void cacheEventLabel(const EventLabel *lab);
 
+	/** Opt: Remembers the state of the thread that added LAB (a read),
+	 * so that revisits of LAB do not have to re-execute the thread's prefix */
+	void cacheThreadSnapshot(const ReadLabel *lab);
+
+	/** Opt: Resumes each thread from the latest snapshot consistent with its prefix */
+	void restoreThreadSnapshots();
+
+	/** Opt: Resumes thread TID from the latest snapshot consistent with its prefix (if any) */
+	void resumeFromSnapshot(unsigned int tid);
+
 	/** Opt: Checks whether SEQ has been seen before for THREAD and
 	 * if so returns its successors. Returns nullptr otherwise. */
 	std::vector<std::unique_ptr<EventLabel>> *
@@ -719,6 +834,9 @@ private:
 	/** The thread pool this driver may belong to */
 	ThreadPool *pool = nullptr;
 
+	/** The coordinator connection, if this driver runs in a worker process */
+	RemoteWorker *remote = nullptr;
+
 	/** User configuration */
 	std::shared_ptr<const Config> userConf;
 
@@ -737,12 +855,18 @@ private:
 	/** Opt: Cached labels for optimized scheduling */
 	ValuePrefixT seenPrefixes;
 
+	/** Opt: Thread snapshots taken at reads (see cacheThreadSnapshot()) */
+	SnapshotCacheT snapshots;
+
 	/** Decider used to bound the exploration */
 	std::unique_ptr<BoundDecider> bounder;
 
 	/** Linearizability checker */
 	std::unique_ptr<LinearizabilityChecker> relinche;
 
+	/** Fingerprints of the graphs seen so far (if detecting duplicates) */
+	std::shared_ptr<VisitedSet> visited;
+
 	/** Opt: Which thread(s) the scheduler should prioritize
 	 * (empty if none) */
 	std::vector<Event> threadPrios;
@@ -759,9 +883,30 @@ private:
 	/** Whether we are stopping the exploration (e.g., due to an error found) */
 	bool shouldHalt = false;
 
+	/** Ckpt: Identifies the program and the options a checkpoint is valid for */
+	uint64_t checkpointFingerprint = 0;
+
+	/** Ckpt: When the last checkpoint was written */
+	std::chrono::steady_clock::time_point lastCheckpoint;
+
+	/** Ckpt: Whether the pending exploration was restored from a checkpoint,
+	 * in which case the current execution has already been explored */
+	bool resumed = false;
+
+	/** Ckpt: Tasks restored from a checkpoint that have not been run yet */
+	std::vector<std::unique_ptr<Execution>> restoredTasks;
+
+	/** Ckpt: Complete executions already reported to the thread pool */
+	unsigned reportedExplored = 0;
+
 	/** Dbg: Random-number generators for scheduling/estimation randomization */
 	MyRNG rng;
 	MyRNG estRng;
 };
 
+/** Serialization of results and tasks (for checkpoints and remote workers) */
+void serialize(BinaryWriter &w, const GenMCDriver::Result &res);
+void deserialize(BinaryReader &r, GenMCDriver::Result &res);
+void serialize(BinaryWriter &w, const GenMCDriver::Execution &exec);
+
 #endif /* GENMC_GENMC_DRIVER_HPP */
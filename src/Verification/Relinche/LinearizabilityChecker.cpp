@@ -21,8 +21,10 @@
 #include "Verification/Relinche/LinearizabilityChecker.hpp"
 #include "ExecutionGraph/Consistency/ConsistencyChecker.hpp"
 #include "ExecutionGraph/ExecutionGraph.hpp"
+#include "Support/BinaryIO.hpp"
 #include "Verification/Relinche/Observation.hpp"
 
+#include <llvm/ADT/Hashing.h>
 #include <llvm/ADT/SmallString.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
@@ -49,6 +51,18 @@ class LinearizabilityStructureError : public LinearizabilityError {
 	}
 };
 
+/* An error reported by another process */
+class LinearizabilityRemoteError : public LinearizabilityError {
+
+public:
+	explicit LinearizabilityRemoteError(std::string &&message) : message_(std::move(message)) {}
+
+	auto toString() const -> std::string override { return message_; }
+
+private:
+	std::string message_;
+};
+
 class LinearizabilitySyncError : public LinearizabilityError {
 
 public:
@@ -134,9 +148,9 @@ static auto combineHints(const Specification &spec, const Observation &obs) -> s
 
 	/* First, collect the hints of all refining observations */
 	std::vector<std::vector<Hint>> hintsOfRefining;
-	for (const auto &kv : spec.refined_observations(obs)) {
+	for (const auto &kv : spec.getRefinedObservations(obs)) {
 		std::vector<Hint> hs;
-		std::ranges::copy_if(kv.second.hints, std::back_inserter(hs), isNotSymmetricHint);
+		std::ranges::copy_if(kv.second, std::back_inserter(hs), isNotSymmetricHint);
 		hintsOfRefining.emplace_back(std::move(hs));
 	}
 
@@ -171,10 +185,46 @@ static auto combineHints(const Specification &spec, const Observation &obs) -> s
 	return result;
 }
 
+/* Whether the edges of HINT close a cycle with the implementation's hb.
+ * Such extensions are trivially inconsistent, and spotting them only requires
+ * the (already calculated) views of the edges' endpoints */
+static auto closesHbCycle(const ConsistencyChecker *consChecker, const Observation &obs,
+			  const Hint &hint) -> bool
+{
+	/* Edge I leads to edge J if the target of I is hb-before the source of J */
+	auto leadsTo = [&](auto i, auto j) {
+		const auto *begLab = obs.getCall(hint.edges[i].second).beginLab;
+		const auto *endLab = obs.getCall(hint.edges[j].first).endLab;
+		return consChecker->getHbRelincheView(endLab).contains(begLab->getPos());
+	};
+
+	enum class NodeStatus : uint8_t { unseen, entered, left };
+	std::vector<NodeStatus> status(hint.edges.size(), NodeStatus::unseen);
+	auto visit = [&](auto &&visit, auto i) -> bool {
+		status[i] = NodeStatus::entered;
+		for (auto j = 0U; j < hint.edges.size(); j++) {
+			if (!leadsTo(i, j))
+				continue;
+			if (status[j] == NodeStatus::entered ||
+			    (status[j] == NodeStatus::unseen && visit(visit, j)))
+				return true;
+		}
+		status[i] = NodeStatus::left;
+		return false;
+	};
+	for (auto i = 0U; i < hint.edges.size(); i++)
+		if (status[i] == NodeStatus::unseen && visit(visit, i))
+			return true;
+	return false;
+}
+
 static auto checkHint(ExecutionGraph &graph, const ConsistencyChecker *consChecker,
 		      const Observation &obs, const Hint &hint)
 	-> std::unique_ptr<LinearizabilityError>
 {
+	if (closesHbCycle(consChecker, obs, hint))
+		return nullptr;
+
 	// map hint's edges to implementation graph
 	std::vector<ExtEdge> edges;
 	edges.reserve(hint.edges.size());
@@ -199,30 +249,66 @@ static auto checkHint(ExecutionGraph &graph, const ConsistencyChecker *consCheck
 	return nullptr;
 }
 
+LinearizabilityChecker::ObservationKey::ObservationKey(const Observation &obs)
+{
+	ops.reserve(obs.getNumOps());
+	for (const auto &call : obs.ops())
+		ops.emplace_back(call.name, call.argVal, call.retVal, call.thdKC);
+	rfs.assign(obs.rfs().begin(), obs.rfs().end());
+	for (const auto &[from, to] : obs.hb())
+		hb.emplace_back(from.value(), to.value());
+}
+
+auto LinearizabilityChecker::ObservationKeyHasher::operator()(const ObservationKey &k) const
+	-> std::size_t
+{
+	auto hash = llvm::hash_combine(k.ops.size(), k.rfs.size(), k.hb.size());
+	for (const auto &[name, arg, ret, kc] : k.ops)
+		hash = llvm::hash_combine(hash, name, arg, ret, kc.first, kc.second);
+	for (const auto &[from, to] : k.rfs)
+		hash = llvm::hash_combine(hash, from, to);
+	for (const auto &[from, to] : k.hb)
+		hash = llvm::hash_combine(hash, from, to);
+	return hash;
+}
+
 auto LinearizabilityChecker::refinesSpec(ExecutionGraph &graph) -> Result
 {
-	/* Phase 1: Check refinement
-	 * 1.1. Check return values are correct */
 	const Observation implObsGraph(graph, consChecker);
 	Result result;
 
-	if (!specification->containsSameOutput(implObsGraph)) {
-		result.status = std::make_unique<LinearizabilityStructureError>();
-		return result;
-	}
+	/* Executions often share their observation: if this one has been
+	 * seen before, it refines the specification, and its hints are known */
+	ObservationKey key(implObsGraph);
+	std::vector<Hint> freshHints;
+	const auto *hints = hintCache.lookup(key);
+	if (!hints) {
+		/* Only the part of the specification with the same outcome is relevant */
+		auto spec = specification->lookup(implObsGraph);
 
-	/* 1.2 Check synchronization */
-	if (!specification->isRefinedBy(implObsGraph)) {
-		auto missedSyncs = specification->refinementMissingEdges(implObsGraph);
-		result.status = std::make_unique<LinearizabilitySyncError>(std::move(missedSyncs));
-		return result;
-	}
+		/* Phase 1: Check refinement
+		 * 1.1. Check return values are correct */
+		if (!spec.containsSameOutput(implObsGraph)) {
+			result.status = std::make_unique<LinearizabilityStructureError>();
+			return result;
+		}
+
+		/* 1.2 Check synchronization */
+		if (!spec.isRefinedBy(implObsGraph)) {
+			auto missedSyncs = spec.refinementMissingEdges(implObsGraph);
+			result.status =
+				std::make_unique<LinearizabilitySyncError>(std::move(missedSyncs));
+			return result;
+		}
 
-	/* Phase 2: Check extensions */
-	auto hints = combineHints(*specification, implObsGraph);
+		/* Phase 2: Collect extensions */
+		freshHints = combineHints(spec, implObsGraph);
+		hintCache.insert(key, freshHints);
+		hints = &freshHints;
+	}
 
 	/* Check whether adding the hints back to the original creates a violation */
-	for (const Hint &hint : hints) {
+	for (const Hint &hint : *hints) {
 		++result.hintsChecked;
 		result.status = checkHint(graph, consChecker, implObsGraph, hint);
 		if (result.status)
@@ -230,3 +316,22 @@ auto LinearizabilityChecker::refinesSpec(ExecutionGraph &graph) -> Result
 	}
 	return result;
 }
+
+void serialize(BinaryWriter &w, const LinearizabilityChecker::Result &res)
+{
+	w.write<bool>(res.status != nullptr);
+	if (res.status)
+		w.writeString(res.status->toString());
+	w.write(res.hintsChecked);
+	GENMC_DEBUG(w.write<int64_t>(res.analysisTime.count()););
+}
+
+void deserialize(BinaryReader &r, LinearizabilityChecker::Result &res)
+{
+	res.status = r.read<bool>()
+			     ? std::make_unique<LinearizabilityRemoteError>(r.readString())
+			     : nullptr;
+	res.hintsChecked = r.read<uint32_t>();
+	GENMC_DEBUG(res.analysisTime = std::chrono::high_resolution_clock::duration(
+			    r.read<int64_t>()););
+}
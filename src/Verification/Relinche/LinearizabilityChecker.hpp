@@ -21,16 +21,23 @@
 #ifndef GENMC_RELINCHE_HPP
 #define GENMC_RELINCHE_HPP
 
+#include "ADT/LRUCache.hpp"
 #include "ExecutionGraph/EventLabel.hpp"
 #include "Support/Error.hpp"
+#include "Verification/Relinche/MappedSpecification.hpp"
+#include "Verification/Relinche/Observation.hpp"
 #include "Verification/Relinche/Specification.hpp"
 
 #include <chrono>
-#include <fstream>
+#include <memory>
 #include <string>
+#include <tuple>
+#include <vector>
 
 class ExecutionGraph;
 class ConsistencyChecker;
+class BinaryWriter;
+class BinaryReader;
 
 /** Abstract class for linearizability checking errors */
 struct LinearizabilityError {
@@ -60,26 +67,53 @@ public:
 		}
 	};
 
-	/** Create checker by loading specification from specFile */
-	static auto create(const ConsistencyChecker *consChecker, const std::string &specFile)
+	/** Create checker by loading specification from specFile.
+	 * The hints of up to CACHESIZE observations are cached across executions */
+	static auto create(const ConsistencyChecker *consChecker, const std::string &specFile,
+			   unsigned int cacheSize = 0)
 	{
 		return std::unique_ptr<LinearizabilityChecker>(
-			new LinearizabilityChecker(consChecker, specFile));
+			new LinearizabilityChecker(consChecker, specFile, cacheSize));
 	}
 
 	/** Check that an implementation graph satisfies the library specification */
 	auto refinesSpec(ExecutionGraph &graph) -> Result;
 
 private:
-	LinearizabilityChecker(const ConsistencyChecker *consChecker, const std::string &specFile)
-		: consChecker(consChecker)
-	{
-		std::ifstream istream(specFile);
-		specification = std::make_unique<Specification>(deserialize(istream));
-	}
+	/** Opt: The shape of an observation (calls, client rfs, and hb), which fully
+	 * determines whether it refines the specification, and which hints apply to it */
+	struct ObservationKey {
+		explicit ObservationKey(const Observation &obs);
+
+		auto operator==(const ObservationKey &other) const -> bool = default;
+
+		std::vector<std::tuple<std::string, int32_t, int32_t, MethodCall::ThreadKindAndCopyIx>>
+			ops;
+		std::vector<std::pair<int, int>> rfs;
+		std::vector<std::pair<uint64_t, uint64_t>> hb;
+	};
+	struct ObservationKeyHasher {
+		auto operator()(const ObservationKey &k) const -> std::size_t;
+	};
+	using HintCacheT = LRUCache<ObservationKey, std::vector<Hint>, ObservationKeyHasher>;
+
+	LinearizabilityChecker(const ConsistencyChecker *consChecker, const std::string &specFile,
+			       unsigned int cacheSize)
+		: consChecker(consChecker), specification(MappedSpecification::open(specFile)),
+		  hintCache(cacheSize)
+	{}
 
 	const ConsistencyChecker *consChecker{};
-	std::unique_ptr<Specification> specification;
+
+	/** The specification (shared by all checkers of the process) */
+	std::shared_ptr<const MappedSpecification> specification;
+
+	/** Opt: The hints of refining observations seen in previous executions */
+	HintCacheT hintCache;
 };
 
+/* Errors are (de)serialized as their messages */
+void serialize(BinaryWriter &w, const LinearizabilityChecker::Result &res);
+void deserialize(BinaryReader &r, LinearizabilityChecker::Result &res);
+
 #endif /* GENMC_RELINCHE_HPP */
@@ -41,7 +41,7 @@ Linearization::Linearization(std::vector<MethodCall::Id> &&orderedIds) : lin_(st
 	calculateOrder(lin_, order_);
 }
 
-auto Linearization::applyPermutation(const PermutationMap &pMap) -> Linearization
+auto Linearization::applyPermutation(const PermutationMap &pMap) const -> Linearization
 {
 	auto result(*this);
 	BUG_ON(pMap.size() != result.size());
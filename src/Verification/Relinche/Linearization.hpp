@@ -51,7 +51,7 @@ public:
 		return getIndex(id1) < getIndex(id2);
 	}
 
-	auto applyPermutation(const PermutationMap &pMap) -> Linearization;
+	[[nodiscard]] auto applyPermutation(const PermutationMap &pMap) const -> Linearization;
 
 	[[nodiscard]] auto operator<=>(const Linearization &other) const = default;
 
@@ -0,0 +1,289 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#include "Verification/Relinche/MappedSpecification.hpp"
+#include "Support/BinaryIO.hpp"
+#include "Support/Error.hpp"
+
+#include <llvm/Support/FileSystem.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+static constexpr uint32_t specMagic = 0x5053524c; /* "LRSP" */
+
+/* The magic as read on a host with the other byte order */
+static constexpr uint32_t specMagicSwapped = 0x4c525350;
+static constexpr uint32_t specVersion = 2;
+
+/* Header flags */
+static constexpr uint64_t compactFlag = 1;
+
+/* The header consists of the magic, the version, the flags, and the number of buckets */
+static constexpr uint64_t headerSize = 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+
+/* Buckets are located by hashing outcomes, so the hash needs to be stable
+ * across runs (unlike std::hash<Observation>); we use FNV-1a */
+static auto hashOutcome(const Observation &obs) -> uint64_t
+{
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	auto mix = [&](const auto &val) {
+		auto bytes = std::bit_cast<std::array<unsigned char, sizeof(val)>>(val);
+		for (auto b : bytes)
+			hash = (hash ^ b) * 0x100000001b3ULL;
+	};
+
+	for (const auto &call : obs.ops()) {
+		for (auto c : call.name)
+			mix(c);
+		mix(static_cast<uint64_t>(call.name.size()));
+		mix(call.argVal);
+		mix(call.retVal);
+	}
+	for (const auto &[from, to] : obs.rfs()) {
+		mix(from);
+		mix(to);
+	}
+	return hash;
+}
+
+void MappedSpecification::write(llvm::raw_ostream &os, const Specification &spec)
+{
+	/* Records are written in the order of the text format */
+	std::vector<Observation> observations;
+	std::ranges::copy(spec.observations(), std::back_inserter(observations));
+	std::ranges::sort(observations,
+			  [](const Observation &a, const Observation &b) { return a < b; });
+
+	uint64_t numBuckets = std::bit_ceil(std::max<uint64_t>(observations.size(), 1));
+	std::vector<std::vector<uint64_t>> buckets(numBuckets);
+	for (auto i = 0U; i < observations.size(); i++)
+		buckets[hashOutcome(observations[i]) & (numBuckets - 1)].push_back(i);
+
+	/* Serialize the records first, so that their offsets are known */
+	std::string data;
+	std::vector<uint64_t> offsets;
+	{
+		llvm::raw_string_ostream ds(data);
+		BinaryWriter w(ds);
+		auto writeEdge = [&](const auto &edge) {
+			w.write<uint64_t>(edge.first.value());
+			w.write<uint64_t>(edge.second.value());
+		};
+
+		for (const auto &obs : observations) {
+			ds.flush();
+			offsets.push_back(data.size());
+
+			w.writeSize(obs.ops_.size());
+			for (const auto &call : obs.ops_) {
+				w.writeString(call.name);
+				w.write(call.argVal);
+				w.write(call.retVal);
+			}
+			w.writeSize(obs.rfs_.size());
+			for (const auto &[from, to] : obs.rfs_) {
+				w.write<int32_t>(from);
+				w.write<int32_t>(to);
+			}
+			w.writeSize(obs.hb_.size());
+			for (const auto &edge : obs.hb_)
+				writeEdge(edge);
+
+			const auto &hints = spec.lookupSync(obs).hints;
+			w.writeSize(hints.size());
+			for (const auto &hint : hints) {
+				w.writeSize(hint.edges.size());
+				for (const auto &edge : hint.edges)
+					writeEdge(edge);
+			}
+		}
+	}
+
+	BinaryWriter w(os);
+	w.write(specMagic);
+	w.write(specVersion);
+	w.write<uint64_t>(spec.isCompact() ? compactFlag : 0);
+	w.write(numBuckets);
+
+	uint64_t entry = 0;
+	for (const auto &bucket : buckets) {
+		w.write(entry);
+		entry += bucket.size();
+	}
+	w.write(entry);
+
+	auto dataStart = headerSize + (numBuckets + 1 + observations.size()) * sizeof(uint64_t);
+	for (const auto &bucket : buckets)
+		for (auto i : bucket)
+			w.write<uint64_t>(dataStart + offsets[i]);
+	os << data;
+}
+
+MappedSpecification::MappedSpecification(std::unique_ptr<llvm::MemoryBuffer> buf)
+	: buffer(std::move(buf))
+{
+	const auto *name = buffer->getBufferIdentifier().data();
+	BinaryReader r(buffer->getBufferStart(), buffer->getBufferEnd());
+	auto magic = r.read<uint32_t>();
+	ERROR_ON(magic == specMagicSwapped,
+		 std::string(name) +
+			 " was written on a machine with a different byte order! Convert it to "
+			 "the text format there (-convert-lin-spec) and use that instead.\n");
+	ERROR_ON(magic != specMagic, std::string(name) + " is not a binary specification file!\n");
+	ERROR_ON(r.read<uint32_t>() != specVersion,
+		 std::string(name) + " was written by a different version of GenMC!\n");
+	compact = r.read<uint64_t>() & compactFlag;
+	numBuckets = r.read<uint64_t>();
+
+	auto entries = (buffer->getBufferSize() - headerSize) / sizeof(uint64_t);
+	ERROR_ON(!std::has_single_bit(numBuckets) || numBuckets >= entries ||
+			 getNumObservations() > entries - numBuckets - 1,
+		 std::string(name) + " is corrupted!\n");
+}
+
+auto MappedSpecification::open(const std::string &file)
+	-> std::shared_ptr<const MappedSpecification>
+{
+	/* Specifications are immutable, so they are only loaded once per process */
+	static std::mutex mutex;
+	static std::unordered_map<std::string, std::weak_ptr<const MappedSpecification>> loaded;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (auto spec = loaded[file].lock())
+		return spec;
+
+	std::unique_ptr<llvm::MemoryBuffer> buf;
+	if (isBinary(file)) {
+		auto bufOrErr = llvm::MemoryBuffer::getFile(file, /*IsText=*/false,
+							    /*RequiresNullTerminator=*/false);
+		if (!bufOrErr)
+			handleFSError(bufOrErr.getError(),
+				      "Could not read specification " + file + "\n");
+		buf = std::move(*bufOrErr);
+	} else {
+		std::ifstream is(file);
+		ERROR_ON(!is, "Could not read specification " + file + "\n");
+		std::string data;
+		llvm::raw_string_ostream os(data);
+		write(os, deserialize(is));
+		buf = llvm::MemoryBuffer::getMemBufferCopy(os.str(), file);
+	}
+
+	auto spec = std::shared_ptr<const MappedSpecification>(
+		new MappedSpecification(std::move(buf)));
+	loaded[file] = spec;
+	return spec;
+}
+
+auto MappedSpecification::isBinary(const std::string &file) -> bool
+{
+	std::ifstream is(file, std::ios::binary);
+	uint32_t magic = 0;
+	return is.read(reinterpret_cast<char *>(&magic), sizeof(magic)) &&
+	       (magic == specMagic || magic == specMagicSwapped);
+}
+
+auto MappedSpecification::getNumObservations() const -> uint64_t
+{
+	return readAt(headerSize + numBuckets * sizeof(uint64_t));
+}
+
+auto MappedSpecification::readAt(uint64_t offset) const -> uint64_t
+{
+	ERROR_ON(offset > buffer->getBufferSize(), "Specification file is corrupted!\n");
+	BinaryReader r(buffer->getBufferStart() + offset, buffer->getBufferEnd());
+	return r.read<uint64_t>();
+}
+
+void MappedSpecification::readRecord(uint64_t offset, Observation &obs,
+				     std::vector<Hint> &hints) const
+{
+	ERROR_ON(offset > buffer->getBufferSize(), "Specification file is corrupted!\n");
+	BinaryReader r(buffer->getBufferStart() + offset, buffer->getBufferEnd());
+	auto readEdge = [&r]() {
+		auto from = r.read<uint64_t>();
+		return std::make_pair(MethodCall::Id(from), MethodCall::Id(r.read<uint64_t>()));
+	};
+
+	/* Each count is checked against the smallest encoding of its elements */
+	constexpr auto edgeBytes = 2 * sizeof(uint64_t);
+	std::vector<MethodCall> ops(r.readSize(sizeof(uint64_t) + 2 * sizeof(int32_t)));
+	for (auto j = 0U; j < ops.size(); j++) {
+		ops[j].id = MethodCall::Id(j);
+		ops[j].name = r.readString();
+		ops[j].argVal = r.read<int32_t>();
+		ops[j].retVal = r.read<int32_t>();
+	}
+	obs.ops_ = std::move(ops);
+
+	std::vector<std::pair<int, int>> rfs(r.readSize(2 * sizeof(int32_t)));
+	for (auto &[from, to] : rfs) {
+		from = r.read<int32_t>();
+		to = r.read<int32_t>();
+	}
+	obs.rfs_ = std::move(rfs);
+
+	std::vector<Observation::CallEdge> hb(r.readSize(edgeBytes));
+	for (auto &edge : hb)
+		edge = readEdge();
+	obs.hb_ = std::move(hb);
+
+	hints.resize(r.readSize(sizeof(uint64_t)));
+	for (auto &hint : hints) {
+		hint.edges.resize(r.readSize(edgeBytes));
+		for (auto &edge : hint.edges)
+			edge = readEdge();
+	}
+}
+
+void MappedSpecification::readBucket(uint64_t i, Specification &spec,
+				     const Observation *obs) const
+{
+	auto bucketOffset = headerSize + i * sizeof(uint64_t);
+	auto recordsOffset = headerSize + (numBuckets + 1) * sizeof(uint64_t);
+	for (auto e = readAt(bucketOffset), ee = readAt(bucketOffset + sizeof(uint64_t)); e < ee;
+	     ++e) {
+		Observation specObs;
+		std::vector<Hint> hints;
+		readRecord(readAt(recordsOffset + e * sizeof(uint64_t)), specObs, hints);
+		if (!obs || specObs == *obs)
+			spec.addHints(specObs, std::move(hints));
+	}
+}
+
+auto MappedSpecification::lookup(const Observation &obs) const -> Specification
+{
+	Specification result;
+	result.compact_ = compact;
+	readBucket(hashOutcome(obs) & (numBuckets - 1), result, &obs);
+	return result;
+}
+
+auto MappedSpecification::toSpecification() const -> Specification
+{
+	Specification result;
+	result.compact_ = compact;
+	for (auto i = 0U; i < numBuckets; i++)
+		readBucket(i, result, nullptr);
+	return result;
+}
@@ -0,0 +1,88 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+#ifndef GENMC_MAPPED_SPECIFICATION_HPP
+#define GENMC_MAPPED_SPECIFICATION_HPP
+
+#include "Verification/Relinche/Specification.hpp"
+
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * A specification in the binary format, mapped read-only into memory.
+ * Observations are bucketed by their outcome (calls and client rfs), and
+ * are only materialized when an observation with the same outcome is looked
+ * up. Mapped specifications are immutable, and are thus shared by all the
+ * checkers of a process (and, through the page cache, across processes).
+ *
+ * The format is versioned and uses host byte order (see BinaryIO.hpp).
+ * Files written on a host with the other byte order are recognized by their
+ * magic and rejected; the text format is portable. The layout is:
+ *   header:  magic, version, flags (whether the specification is compact),
+ *            number of buckets
+ *   buckets: for each bucket, the index of its first entry in the record table
+ *            (plus a sentinel)
+ *   records: the file offset of each record, ordered by bucket
+ *   data:    the records themselves (outcome, rfs, hb, hints), in the order
+ *            of the text format
+ */
+class MappedSpecification {
+
+public:
+	/** Returns the (shared) mapping of FILE. Text specifications are
+	 * converted to the binary format in memory */
+	static auto open(const std::string &file) -> std::shared_ptr<const MappedSpecification>;
+
+	/** Whether FILE is a binary specification */
+	static auto isBinary(const std::string &file) -> bool;
+
+	/** Writes SPEC in the binary format */
+	static void write(llvm::raw_ostream &os, const Specification &spec);
+
+	/** Returns the observations with the same outcome as OBS */
+	[[nodiscard]] auto lookup(const Observation &obs) const -> Specification;
+
+	/** Materializes the whole specification */
+	[[nodiscard]] auto toSpecification() const -> Specification;
+
+	[[nodiscard]] auto getNumObservations() const -> uint64_t;
+
+private:
+	explicit MappedSpecification(std::unique_ptr<llvm::MemoryBuffer> buf);
+
+	/** Reads the 64-bit value at OFFSET */
+	[[nodiscard]] auto readAt(uint64_t offset) const -> uint64_t;
+
+	/** Reads the record at OFFSET into OBS and HINTS */
+	void readRecord(uint64_t offset, Observation &obs, std::vector<Hint> &hints) const;
+
+	/** Adds the records of the I-th bucket to SPEC (only those with
+	 * the same outcome as OBS, if given) */
+	void readBucket(uint64_t i, Specification &spec, const Observation *obs) const;
+
+	std::unique_ptr<llvm::MemoryBuffer> buffer;
+	uint64_t numBuckets{};
+	bool compact = false;
+};
+
+#endif /* GENMC_MAPPED_SPECIFICATION_HPP */
@@ -143,7 +143,7 @@ public:
 		return hb_.diff(other.hb_);
 	}
 
-	auto applyHbPermutation(const PermutationMap &pMap) -> Observation
+	[[nodiscard]] auto applyHbPermutation(const PermutationMap &pMap) const -> Observation
 	{
 		Observation newObs(*this);
 
@@ -176,6 +176,7 @@ private:
 
 	friend void serialize(llvm::raw_ostream &os, const Specification &spec);
 	friend auto deserialize(std::istream &is) -> Specification;
+	friend class MappedSpecification;
 
 	std::vector<MethodCall> ops_;	// Ordered operation calls
 	VSet<std::pair<int, int>> rfs_; // read-from of the client side
@@ -28,14 +28,23 @@
 #include <llvm/ADT/SmallString.h>
 #include <llvm/ADT/iterator_range.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Format.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/raw_ostream.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <istream>
+#include <mutex>
+#include <numeric>
+#include <optional>
 #include <queue>
 #include <ranges>
+#include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -63,45 +72,6 @@ void Specification::addHints(const Observation &obs, std::vector<Hint> &&newHint
 		hints.emplace_back(std::move(hint));
 }
 
-auto Specification::isRefinedBy(const Observation &obs) const -> bool
-{
-	return std::ranges::any_of(llvm::make_range(data_.equal_range(obs)),
-				   [&](auto &specObs) { return specObs.first.isRefinedBy(obs); });
-}
-
-auto Specification::refinementMissingEdges(const Observation &obs) const
-	-> std::vector<std::vector<Edge>>
-{
-	std::vector<std::vector<Edge>> res;
-	for (const auto &specObs : llvm::make_range(data_.equal_range(obs))) {
-		std::vector<Edge> missedEdges;
-		for (const auto &[op1, op2] : specObs.first.calculateHbDiff((obs)))
-			missedEdges.emplace_back(obs.getCall(op1).beginLab->getPos(),
-						 obs.getCall(op2).endLab->getPos());
-		std::ranges::sort(missedEdges);
-		if (std::ranges::none_of(res, [&](auto &es) {
-			    return std::ranges::includes(missedEdges, es);
-		    })) {
-			std::erase_if(res, [&](auto &es) {
-				return std::ranges::includes(es, missedEdges);
-			});
-			res.emplace_back(std::move(missedEdges));
-		}
-	}
-	std::ranges::sort(res);
-	return res;
-}
-
-void Specification::merge(Specification &&other)
-{
-	for (auto &it : other.data_) {
-		auto &r = lookupSyncOrInsert(it.first);
-		r.lins.insert(it.second.lins);
-		for (auto &hint : it.second.hints)
-			r.hints.emplace_back(std::move(hint));
-	}
-}
-
 /*******************************************************************************
  **                     Observation addition utilities
  ******************************************************************************/
@@ -234,23 +204,542 @@ template <class T> static auto existsPermutation(std::vector<std::vector<T>> &v)
 		v, [](auto &eq) { return std::ranges::next_permutation(eq).found; });
 }
 
-void Specification::add(ExecutionGraph &g, const ConsistencyChecker *consChecker,
-			bool symmReduction)
+/* Calls FUN on each observation symmetric to OBS (including OBS itself),
+ * along with the permutation that maps OBS to it */
+template <typename F> static void forEachSymmetric(const Observation &obs, F &&fun)
+{
+	auto callEqs = calculateSymmetricCalls(obs);
+	auto edgeEqs = calculateDICalls(obs);
+	do {
+		auto perm = generatePermutation(obs.ids(), callEqs, edgeEqs);
+		fun(obs.applyHbPermutation(perm), perm);
+	} while (existsPermutation(callEqs) || existsPermutation(edgeEqs));
+}
+
+/*******************************************************************************
+ **                     Canonical labelling utilities
+ ******************************************************************************/
+
+/* The units permuted by the symmetries of an observation, grouped by class:
+ * either single symmetric calls, or pairs of data-independent calls */
+using SymmetryUnit = std::vector<unsigned>;
+using SymmetryClasses = std::vector<std::vector<SymmetryUnit>>;
+
+static auto calculateSymmetryClasses(const Observation &obs) -> SymmetryClasses
+{
+	SymmetryClasses result;
+	for (const auto &eq : calculateSymmetricCalls(obs)) {
+		auto &cls = result.emplace_back();
+		for (const auto &id : eq)
+			cls.push_back({static_cast<unsigned>(id.value())});
+	}
+	for (const auto &eq : calculateDICalls(obs)) {
+		auto &cls = result.emplace_back();
+		for (const auto &[from, to] : eq)
+			cls.push_back({static_cast<unsigned>(from.value()),
+				       static_cast<unsigned>(to.value())});
+	}
+	return result;
+}
+
+/* Whether swapping units A and B preserves the hb of OBS */
+static auto areInterchangeable(const Observation &obs, const SymmetryUnit &a,
+			       const SymmetryUnit &b) -> bool
+{
+	PermutationMap swap(MethodCall::Id(0));
+	swap.resize(obs.getNumOps());
+	for (auto id : obs.ids())
+		swap[id.value()] = id;
+	for (auto i = 0U; i < a.size(); i++) {
+		swap[a[i]] = MethodCall::Id(b[i]);
+		swap[b[i]] = MethodCall::Id(a[i]);
+	}
+	return obs.applyHbPermutation(swap).hasSameHb(obs);
+}
+
+/* Returns, for each unit, the closest previous unit of its class that it
+ * is interchangeable with (or -1). Since interchangeability is an equivalence,
+ * these chains cover all interchangeable units */
+static auto calculateInterchangeableUnits(const Observation &obs, const SymmetryClasses &classes)
+	-> std::vector<std::vector<int>>
+{
+	std::vector<std::vector<int>> result(classes.size());
+	for (auto k = 0U; k < classes.size(); k++) {
+		result[k].assign(classes[k].size(), -1);
+		for (auto v = 0U; v < classes[k].size(); v++)
+			for (int u = v - 1; u >= 0; u--)
+				if (areInterchangeable(obs, classes[k][u], classes[k][v])) {
+					result[k][v] = u;
+					break;
+				}
+	}
+	return result;
+}
+
+/* Returns the permutation that moves the U-th unit of each class K
+ * to the place of the SLOTS[K][U]-th unit */
+static auto calculateClassPermutation(const Observation &obs, const SymmetryClasses &classes,
+				      const std::vector<std::vector<unsigned>> &slots)
+	-> PermutationMap
+{
+	PermutationMap result(MethodCall::Id(0));
+	result.resize(obs.getNumOps());
+	for (auto id : obs.ids())
+		result[id.value()] = id;
+	for (auto k = 0U; k < classes.size(); k++)
+		for (auto u = 0U; u < classes[k].size(); u++)
+			for (auto r = 0U; r < classes[k][u].size(); r++)
+				result[classes[k][u][r]] =
+					MethodCall::Id(classes[k][slots[k][u]][r]);
+	return result;
+}
+
+/*
+ * Calculates the canonical form of an observation, i.e., a representative
+ * that is the same for all the observations symmetric to it, without
+ * enumerating them. As in graph canonization, the calls are colored
+ * (initially by their symmetry class), and colors are refined based on the
+ * colors of the calls' hb neighbors, until each unit of a class has a
+ * distinct color. Whenever refinement gets stuck, each of the tied units is
+ * tried in turn, skipping units that can be swapped with one already tried
+ * (since this yields the same forms). The canonical form is the least of
+ * the forms found at the leaves of this search; as the search is pruned, it
+ * need not be the least of all the symmetric observations.
+ */
+class CanonicalLabeller {
+
+public:
+	explicit CanonicalLabeller(const Observation &obs)
+		: obs(obs), classes(calculateSymmetryClasses(obs)), succs(obs.getNumOps()),
+		  preds(obs.getNumOps()), partners(obs.getNumOps())
+	{
+		for (const auto &[from, to] : obs.hb()) {
+			succs[from.value()].push_back(to.value());
+			preds[to.value()].push_back(from.value());
+		}
+		for (const auto &cls : classes)
+			for (const auto &unit : cls)
+				for (auto c : unit)
+					partners[c] = unit;
+	}
+
+	/** Returns the permutation mapping the observation to its canonical form */
+	auto calculate() -> PermutationMap
+	{
+		/* Calls outside of classes are fixed, so they are colored by their id */
+		std::vector<std::vector<unsigned>> sigs(obs.getNumOps());
+		for (auto c = 0U; c < sigs.size(); c++)
+			sigs[c] = {0, c};
+		for (auto k = 0U; k < classes.size(); k++)
+			for (const auto &unit : classes[k])
+				for (auto r = 0U; r < unit.size(); r++)
+					sigs[unit[r]] = {1, k, r};
+
+		search(relabel(sigs));
+		return std::move(best->second);
+	}
+
+private:
+	using Colors = std::vector<unsigned>;
+
+	/* Replaces signatures by their rank */
+	static auto relabel(const std::vector<std::vector<unsigned>> &sigs) -> Colors
+	{
+		auto sorted = sigs;
+		std::ranges::sort(sorted);
+		auto [first, last] = std::ranges::unique(sorted);
+		sorted.erase(first, last);
+
+		Colors result(sigs.size());
+		for (auto c = 0U; c < sigs.size(); c++)
+			result[c] = std::ranges::lower_bound(sorted, sigs[c]) - sorted.begin();
+		return result;
+	}
+
+	static auto countColors(const Colors &colors) -> size_t
+	{
+		return colors.empty() ? 0 : *std::ranges::max_element(colors) + 1;
+	}
+
+	/* Refines COLORS until they are stable */
+	void refine(Colors &colors) const
+	{
+		auto numColors = countColors(colors);
+		while (true) {
+			std::vector<std::vector<unsigned>> sigs(colors.size());
+			for (auto c = 0U; c < colors.size(); c++) {
+				auto &sig = sigs[c];
+				sig.push_back(colors[c]);
+				for (auto p : partners[c])
+					sig.push_back(colors[p]);
+				for (const auto *ns : {&succs[c], &preds[c]}) {
+					auto start = sig.size();
+					sig.push_back(UINT_MAX);
+					for (auto n : *ns)
+						sig.push_back(colors[n]);
+					std::sort(sig.begin() + start + 1, sig.end());
+				}
+			}
+			colors = relabel(sigs);
+			auto newNumColors = countColors(colors);
+			if (newNumColors == numColors)
+				return;
+			numColors = newNumColors;
+		}
+	}
+
+	void search(Colors colors)
+	{
+		refine(colors);
+
+		/* Find the first class with tied units (and the least tied color) */
+		for (const auto &cls : classes) {
+			std::vector<unsigned> unitColors;
+			for (const auto &unit : cls)
+				unitColors.push_back(colors[unit[0]]);
+			std::ranges::sort(unitColors);
+			auto tieIt = std::ranges::adjacent_find(unitColors);
+			if (tieIt == unitColors.end())
+				continue;
+
+			/* Individualize each (non-interchangeable) tied unit */
+			auto color = *tieIt;
+			std::vector<const SymmetryUnit *> tried;
+			for (const auto &unit : cls) {
+				if (colors[unit[0]] != color ||
+				    std::ranges::any_of(tried, [&](auto *t) {
+					    return areInterchangeable(obs, *t, unit);
+				    }))
+					continue;
+				tried.push_back(&unit);
+
+				auto newColors = colors;
+				auto fresh = colors.size();
+				for (auto c : unit)
+					newColors[c] = fresh++;
+				search(std::move(newColors));
+			}
+			return;
+		}
+
+		/* All units are distinguished: order them by color */
+		std::vector<std::vector<unsigned>> slots(classes.size());
+		for (auto k = 0U; k < classes.size(); k++) {
+			std::vector<unsigned> byColor(classes[k].size());
+			std::iota(byColor.begin(), byColor.end(), 0);
+			std::ranges::sort(byColor, {}, [&](auto u) { return colors[classes[k][u][0]]; });
+			slots[k].resize(byColor.size());
+			for (auto i = 0U; i < byColor.size(); i++)
+				slots[k][byColor[i]] = i;
+		}
+		auto perm = calculateClassPermutation(obs, classes, slots);
+		auto newObs = obs.applyHbPermutation(perm);
+		if (!best || newObs < best->first)
+			best.emplace(std::move(newObs), std::move(perm));
+	}
+
+	const Observation &obs;
+	SymmetryClasses classes;
+	std::vector<std::vector<unsigned>> succs;
+	std::vector<std::vector<unsigned>> preds;
+	std::vector<SymmetryUnit> partners; /**< The unit of each call (if any) */
+
+	std::optional<std::pair<Observation, PermutationMap>> best;
+};
+
+/*
+ * Calls FUN(perm) for each permutation PERM such that PERM(SPECOBS) is
+ * symmetric to SPECOBS and refined by OBS. Units are assigned to their
+ * places one by one, and assignments that map an hb edge of SPECOBS outside
+ * the hb of OBS are pruned. Interchangeable units are only assigned in order,
+ * so permutations that only differ in such units are reported once.
+ */
+template <typename F>
+static void forEachSymmetricMatch(const Observation &specObs, const Observation &obs, F &&fun)
+{
+	auto n = specObs.getNumOps();
+	std::vector<bool> inHb(n * n);
+	for (const auto &[from, to] : obs.hb())
+		inHb[from.value() * n + to.value()] = true;
+
+	std::vector<bool> inSpecHb(n * n);
+	std::vector<std::vector<unsigned>> adj(n);
+	for (const auto &[from, to] : specObs.hb()) {
+		inSpecHb[from.value() * n + to.value()] = true;
+		adj[from.value()].push_back(to.value());
+		adj[to.value()].push_back(from.value());
+	}
+
+	/* Calls outside of classes are fixed */
+	auto classes = calculateSymmetryClasses(specObs);
+	std::vector<int> mapped(n);
+	std::iota(mapped.begin(), mapped.end(), 0);
+	for (const auto &cls : classes)
+		for (const auto &unit : cls)
+			for (auto c : unit)
+				mapped[c] = -1;
+
+	/* Whether the (mapped) edges between C and its mapped neighbors are in OBS */
+	auto respectsHb = [&](unsigned c) {
+		return std::ranges::all_of(adj[c], [&](auto d) {
+			return mapped[d] == -1 ||
+			       ((!inSpecHb[c * n + d] || inHb[mapped[c] * n + mapped[d]]) &&
+				(!inSpecHb[d * n + c] || inHb[mapped[d] * n + mapped[c]]));
+		});
+	};
+	for (auto c = 0U; c < n; c++)
+		if (mapped[c] != -1 && !respectsHb(c))
+			return;
+
+	auto prevInterch = calculateInterchangeableUnits(specObs, classes);
+
+	std::vector<std::vector<unsigned>> slots(classes.size());
+	std::vector<std::vector<bool>> taken(classes.size());
+	for (auto k = 0U; k < classes.size(); k++) {
+		slots[k].resize(classes[k].size());
+		taken[k].resize(classes[k].size());
+	}
+
+	auto visit = [&](auto &&visit, unsigned k, unsigned u) -> void {
+		if (k == classes.size()) {
+			fun(calculateClassPermutation(specObs, classes, slots));
+			return;
+		}
+		if (u == classes[k].size()) {
+			visit(visit, k + 1, 0);
+			return;
+		}
+
+		const auto &unit = classes[k][u];
+		auto prev = prevInterch[k][u];
+		for (auto s = prev == -1 ? 0U : slots[k][prev] + 1; s < classes[k].size(); s++) {
+			if (taken[k][s])
+				continue;
+			for (auto r = 0U; r < unit.size(); r++)
+				mapped[unit[r]] = classes[k][s][r];
+			if (std::ranges::all_of(unit, respectsHb)) {
+				taken[k][s] = true;
+				slots[k][u] = s;
+				visit(visit, k, u + 1);
+				taken[k][s] = false;
+			}
+		}
+		for (auto c : unit)
+			mapped[c] = -1;
+	};
+	visit(visit, 0, 0);
+}
+
+/* Closes LINS under the automorphisms of OBS, i.e., the symmetries that
+ * leave OBS unchanged. (Expanded specifications get this for free, as each
+ * symmetric observation contributes the linearizations of its images.) */
+static void closeUnderAutomorphisms(const Observation &obs, VSet<Linearization> &lins)
+{
+	/* Aut(OBS) is generated by the matches of OBS against itself,
+	 * along with the swaps of interchangeable units */
+	std::vector<PermutationMap> generators;
+	forEachSymmetricMatch(obs, obs, [&](const PermutationMap &perm) {
+		generators.push_back(perm);
+	});
+
+	auto classes = calculateSymmetryClasses(obs);
+	auto prevInterch = calculateInterchangeableUnits(obs, classes);
+	for (auto k = 0U; k < classes.size(); k++) {
+		for (auto v = 0U; v < classes[k].size(); v++) {
+			if (prevInterch[k][v] == -1)
+				continue;
+			std::vector<std::vector<unsigned>> slots(classes.size());
+			for (auto j = 0U; j < classes.size(); j++) {
+				slots[j].resize(classes[j].size());
+				std::iota(slots[j].begin(), slots[j].end(), 0);
+			}
+			std::swap(slots[k][v], slots[k][prevInterch[k][v]]);
+			generators.push_back(calculateClassPermutation(obs, classes, slots));
+		}
+	}
+
+	std::vector<Linearization> worklist(lins.begin(), lins.end());
+	while (!worklist.empty()) {
+		auto lin = std::move(worklist.back());
+		worklist.pop_back();
+		for (const auto &perm : generators) {
+			auto newLin = lin.applyPermutation(perm);
+			if (lins.insert(newLin).second)
+				worklist.push_back(std::move(newLin));
+		}
+	}
+}
+
+#ifdef ENABLE_GENMC_DEBUG
+/* Checks that all the observations symmetric to OBS have the same canonical form */
+static void checkCanonicalForm(const Observation &obs)
+{
+	auto form = obs.applyHbPermutation(CanonicalLabeller(obs).calculate());
+	forEachSymmetric(obs, [&](Observation &&newObs, const PermutationMap &) {
+		auto newForm = newObs.applyHbPermutation(CanonicalLabeller(newObs).calculate());
+		BUG_ON(newForm != form || !newForm.hasSameHb(form));
+	});
+}
+#endif
+
+static auto applyPermutation(const Hint &hint, const PermutationMap &perm) -> Hint
+{
+	Hint result;
+	result.edges.reserve(hint.edges.size());
+	for (const auto &[from, to] : hint.edges)
+		result.edges.emplace_back(perm[from.value()], perm[to.value()]);
+	return result;
+}
+
+/*******************************************************************************
+ **                     Observation store
+ ******************************************************************************/
+
+void ObservationStore::add(ExecutionGraph &g, const ConsistencyChecker *consChecker)
 {
 	Observation obs(g, consChecker);
 	auto lin = calculateLinearization(g, obs);
+	add(std::move(obs), lin);
+}
+
+void ObservationStore::add(Observation &&obs, const Linearization &lin)
+{
 	if (!symmReduction) {
-		lookupSyncOrInsert(obs).lins.insert(lin);
+		insert(std::move(obs), VSet<Linearization>{lin});
 		return;
 	}
 
-	auto callEqs = calculateSymmetricCalls(obs);
-	auto edgeEqs = calculateDICalls(obs);
-	do {
-		const auto perm = generatePermutation(obs.ids(), callEqs, edgeEqs);
-		const auto newObs = obs.applyHbPermutation(perm);
-		lookupSyncOrInsert(newObs).lins.insert(lin.applyPermutation(perm));
-	} while (existsPermutation(callEqs) || existsPermutation(edgeEqs));
+	auto perm = CanonicalLabeller(obs).calculate();
+	insert(obs.applyHbPermutation(perm), VSet<Linearization>{lin.applyPermutation(perm)});
+}
+
+auto ObservationStore::ObservationHasher::operator()(const Observation &obs) const -> size_t
+{
+	auto hash = std::hash<Observation>()(obs);
+	for (const auto &[from, to] : obs.hb())
+		hash = llvm::hash_combine(hash, from.value(), to.value());
+	return hash;
+}
+
+void ObservationStore::insert(Observation &&obs, VSet<Linearization> &&lins)
+{
+	auto &shard = shards[ObservationHasher()(obs) % numShards];
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	auto [it, inserted] = shard.data.try_emplace(std::move(obs), std::move(lins));
+	if (!inserted)
+		it->second.insert(lins);
+}
+
+void ObservationStore::merge(ObservationStore &&other)
+{
+	for (auto &shard : other.shards) {
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		for (auto &[obs, lins] : shard.data)
+			insert(Observation(obs), std::move(lins));
+		shard.data.clear();
+	}
+}
+
+void ObservationStore::moveTo(Specification &spec)
+{
+	spec.compact_ = symmReduction;
+	for (auto &shard : shards) {
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		for (auto &[obs, lins] : shard.data) {
+			if (symmReduction) {
+				GENMC_DEBUG(if (spec.debug) checkCanonicalForm(obs););
+				closeUnderAutomorphisms(obs, lins);
+			}
+			spec.lookupSyncOrInsert(obs).lins.insert(lins);
+		}
+		shard.data.clear();
+	}
+}
+
+void Specification::expandTo(Specification &spec) const
+{
+	for (const auto &[obs, record] : data_) {
+		if (!isCompact()) {
+			spec.lookupSyncOrInsert(obs).lins.insert(record.lins);
+			continue;
+		}
+		forEachSymmetric(obs, [&](Observation &&newObs, const PermutationMap &perm) {
+			auto &specLins = spec.lookupSyncOrInsert(newObs).lins;
+			for (const auto &lin : record.lins)
+				specLins.insert(lin.applyPermutation(perm));
+		});
+	}
+}
+
+/*******************************************************************************
+ **                     Refinement checking
+ ******************************************************************************/
+
+auto Specification::getRefinedObservations(const Observation &obs) const
+	-> std::vector<std::pair<Observation, std::vector<Hint>>>
+{
+	std::vector<std::pair<Observation, std::vector<Hint>>> result;
+	for (const auto &[specObs, record] : llvm::make_range(data_.equal_range(obs))) {
+		if (!isCompact()) {
+			if (specObs.isRefinedBy(obs))
+				result.emplace_back(specObs, record.hints);
+			continue;
+		}
+		std::set<std::vector<Observation::CallEdge>> seen;
+		forEachSymmetricMatch(specObs, obs, [&](const PermutationMap &perm) {
+			auto image = specObs.applyHbPermutation(perm);
+			if (!seen.emplace(image.hb().begin(), image.hb().end()).second)
+				return;
+
+			std::vector<Hint> hints;
+			hints.reserve(record.hints.size());
+			for (const auto &hint : record.hints)
+				hints.push_back(applyPermutation(hint, perm));
+			result.emplace_back(std::move(image), std::move(hints));
+		});
+	}
+	return result;
+}
+
+auto Specification::isRefinedBy(const Observation &obs) const -> bool
+{
+	if (isCompact())
+		return !getRefinedObservations(obs).empty();
+	return std::ranges::any_of(llvm::make_range(data_.equal_range(obs)),
+				   [&](auto &specObs) { return specObs.first.isRefinedBy(obs); });
+}
+
+auto Specification::refinementMissingEdges(const Observation &obs) const
+	-> std::vector<std::vector<Edge>>
+{
+	std::vector<std::vector<Edge>> res;
+	auto addMissingEdges = [&](const Observation &specObs) {
+		std::vector<Edge> missedEdges;
+		for (const auto &[op1, op2] : specObs.calculateHbDiff((obs)))
+			missedEdges.emplace_back(obs.getCall(op1).beginLab->getPos(),
+						 obs.getCall(op2).endLab->getPos());
+		std::ranges::sort(missedEdges);
+		if (std::ranges::none_of(res, [&](auto &es) {
+			    return std::ranges::includes(missedEdges, es);
+		    })) {
+			std::erase_if(res, [&](auto &es) {
+				return std::ranges::includes(es, missedEdges);
+			});
+			res.emplace_back(std::move(missedEdges));
+		}
+	};
+
+	for (const auto &specObs : llvm::make_range(data_.equal_range(obs))) {
+		if (!isCompact()) {
+			addMissingEdges(specObs.first);
+			continue;
+		}
+		forEachSymmetric(specObs.first, [&](Observation &&newObs, const PermutationMap &) {
+			addMissingEdges(newObs);
+		});
+	}
+	std::ranges::sort(res);
+	return res;
 }
 
 /*******************************************************************************
@@ -295,13 +784,21 @@ public:
 		}
 	};
 
-	explicit Extension(const Observation &obs) : hbext_(obs.getNumOps() * 2)
+	explicit Extension(const Observation &obs)
+		: numEvents_(obs.getNumOps() * 2), rowWords_((numEvents_ + 63) / 64),
+		  hbext_(numEvents_ * rowWords_, 0)
 	{
+		Matrix2D<unsigned int> hb(numEvents_);
 		for (auto id : obs.ids())
-			hbext_.addEdge(toBeginExtEvent(id), toEndExtEvent(id));
+			hb.addEdge(toBeginExtEvent(id), toEndExtEvent(id));
 		for (const auto &edge : obs.hb())
-			hbext_.addEdge(toBeginExtEvent(edge.first), toEndExtEvent(edge.second));
-		hbext_.transClosure();
+			hb.addEdge(toBeginExtEvent(edge.first), toEndExtEvent(edge.second));
+		hb.transClosure();
+
+		for (auto a = 0U; a < numEvents_; a++)
+			for (auto b = 0U; b < numEvents_; b++)
+				if (hb(a, b))
+					setOrdered(a, b);
 	}
 
 	/* Number of added edges */
@@ -315,7 +812,7 @@ public:
 	/* Whether (a, b) \in EXT u HB  */
 	[[nodiscard]] auto areHbOrdered(ExtEvent a, ExtEvent b) const -> bool
 	{
-		return hbext_(a, b);
+		return (hbext_[a * rowWords_ + b / 64] >> (b % 64)) & 1;
 	}
 
 	/* Whether (a, b) \in (EXT u HB)? */
@@ -363,7 +860,14 @@ public:
 	/* Grow extension via one edge */
 	void addEdge(const ExtEdge &edge)
 	{
-		hbext_.addEdgeAndTransitive(edge.src, edge.dst);
+		/* Everything reaching SRC now also reaches DST and its successors */
+		for (auto a = 0U; a < numEvents_; a++) {
+			if (a != edge.src && !areHbOrdered(a, edge.src))
+				continue;
+			setOrdered(a, edge.dst);
+			for (auto w = 0U; w < rowWords_; w++)
+				hbext_[a * rowWords_ + w] |= hbext_[edge.dst * rowWords_ + w];
+		}
 		killedLins_ |= edge.contradictingLins;
 		ext_.push_back(&edge);
 	}
@@ -394,11 +898,19 @@ private:
 		return MethodCall::Id(extEvent / 2);
 	}
 
+	void setOrdered(ExtEvent a, ExtEvent b)
+	{
+		hbext_[a * rowWords_ + b / 64] |= uint64_t(1) << (b % 64);
+	}
+
 	/* Extension edges */
 	llvm::SmallVector<const ExtEdge *, 8> ext_;
 
-	/* transitive closure of extended happens-before: (hb u ext)+ */
-	Matrix2D<unsigned int> hbext_;
+	/* Transitive closure of extended happens-before: (hb u ext)+.
+	 * Stored as one bit-row per event, so that copying an extension is cheap */
+	unsigned numEvents_;
+	unsigned rowWords_;
+	llvm::SmallVector<uint64_t, 16> hbext_;
 
 	/* cached U_{e in edges} e.contradictingLins */
 	llvm::BitVector killedLins_;
@@ -443,8 +955,10 @@ static auto calculateEdgePool(const Observation &obs, const VSet<Linearization>
 	return result;
 }
 
-auto Specification::calculateObservationHints(const Observation &obs) const -> std::vector<Hint>
+auto Specification::calculateObservationHints(const Observation &obs, HintStats &stats) const
+	-> std::vector<Hint>
 {
+	auto start = std::chrono::steady_clock::now();
 	std::queue<Extension> queue;
 
 	queue.emplace(obs);
@@ -452,7 +966,6 @@ auto Specification::calculateObservationHints(const Observation &obs) const -> s
 	auto edgePool = calculateEdgePool(obs, lins, queue.front());
 
 	std::vector<Extension> extensions;
-	size_t extensionsExplored = 0;
 	while (!queue.empty()) {
 		auto ext = std::move(queue.front());
 		queue.pop();
@@ -479,7 +992,7 @@ auto Specification::calculateObservationHints(const Observation &obs) const -> s
 			if (ext.size() + 1 > getMaxExtSize())
 				continue; // hit user-defined threshold
 
-			GENMC_DEBUG(++extensionsExplored;);
+			++stats.extensionsExplored;
 			Extension newExt(ext); // copy
 			newExt.addEdge(newEdge);
 
@@ -505,20 +1018,48 @@ auto Specification::calculateObservationHints(const Observation &obs) const -> s
 	for (const auto &ext : extensions)
 		result.emplace_back(ext.toHint());
 
-	GENMC_DEBUG(if (debug) llvm::dbgs()
-			    << "Stats: #calls: " << obs.getNumOps()
-			    << ", #hb:  " << std::ranges::distance(obs.hb()) << ", #lins: " << lins
-			    << " => #extension: " << extensionsExplored
-			    << ", #hints:  " << result.size() << "\n";);
-	GENMC_DEBUG(extensionsExploredInTotal += extensionsExplored;);
-
+	stats.time = std::chrono::steady_clock::now() - start;
 	return result;
 }
 
-void Specification::calculateHints()
+void Specification::calculateHints(unsigned numThreads)
 {
-	for (const auto &obs : observations())
-		addHints(obs, calculateObservationHints(obs));
+	/* Observations are independent, so workers just grab the next one */
+	std::vector<std::pair<const Observation *, Record *>> work;
+	work.reserve(data_.size());
+	for (auto &[obs, record] : data_)
+		work.emplace_back(&obs, &record);
+
+	std::vector<std::vector<Hint>> hints(work.size());
+	std::vector<HintStats> stats(work.size());
+	std::atomic<size_t> next{0};
+	auto worker = [&] {
+		for (auto i = next++; i < work.size(); i = next++)
+			hints[i] = calculateObservationHints(*work[i].first, stats[i]);
+	};
+
+	std::vector<std::thread> workers;
+	for (auto i = 1U; i < std::min<size_t>(numThreads, work.size()); i++)
+		workers.emplace_back(worker);
+	worker();
+	for (auto &t : workers)
+		t.join();
+
+	for (auto i = 0U; i < work.size(); i++) {
+		const auto &[obs, record] = work[i];
+		GENMC_DEBUG(if (debug) llvm::dbgs()
+				    << "Stats: #calls: " << obs->getNumOps()
+				    << ", #hb:  " << std::ranges::distance(obs->hb())
+				    << ", #lins: " << record->lins
+				    << " => #extension: " << stats[i].extensionsExplored
+				    << ", #hints:  " << hints[i].size() << ", time: "
+				    << llvm::format("%.2fms", std::chrono::duration<double, std::milli>(
+								   stats[i].time)
+								   .count()) << "\n";);
+		GENMC_DEBUG(extensionsExploredInTotal += stats[i].extensionsExplored;);
+		for (auto &hint : hints[i])
+			record->hints.emplace_back(std::move(hint));
+	}
 }
 
 /*******************************************************************************
@@ -551,7 +1092,7 @@ void serialize(llvm::raw_ostream &os, const Specification &spec)
 		os << call.name << " " << call.argVal << " " << call.retVal;
 	};
 
-	os << "# Specification\n";
+	os << (spec.isCompact() ? "# Specification (compact)\n" : "# Specification\n");
 	os << "# Statistics: "
 	   << " Size: " << spec.data_.size() << " "
 	   << " Hints: " << spec.getNumHints() << " "
@@ -612,6 +1153,13 @@ auto deserialize(std::istream &is) -> Specification
 
 	Specification result;
 
+	/* Compact specifications are marked in their header */
+	if (is.peek() == '#') {
+		std::string header;
+		std::getline(is, header);
+		result.compact_ = header.find("(compact)") != std::string::npos;
+	}
+
 	auto i = 0U;
 	while (!is.eof()) {
 		++i;
@@ -638,6 +1186,7 @@ auto deserialize(std::istream &is) -> Specification
 		skipComments(is);
 		readVector(is, hints, [&](auto &hint) { readVector(is, hint.edges, readIdEdge); });
 		result.addHints(obs, std::move(hints));
+		ERROR_ON(is.fail() && !is.eof(), "Malformed specification file!\n");
 
 		/* empty newline between outcomes */
 		is.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -29,8 +29,11 @@
 #include <llvm/ADT/SmallString.h>
 #include <llvm/Support/raw_ostream.h>
 
+#include <array>
+#include <chrono>
 #include <climits>
 #include <istream>
+#include <mutex>
 #include <numeric>
 #include <ranges>
 #include <unordered_map>
@@ -71,12 +74,13 @@ public:
 	/** Iterate over all observations */
 	[[nodiscard]] auto observations() const { return std::views::keys(data_); }
 
-	/** Iterate over <obs', <lins, hints>> pairs where obs' refines obs */
-	[[nodiscard]] auto refined_observations(const Observation &obs) const
-	{
-		return llvm::make_range(data_.equal_range(obs)) |
-		       std::views::filter([&](auto &kv) { return kv.first.isRefinedBy(obs); });
-	}
+	/** Returns the <obs', hints> pairs where obs' refines obs
+	 * (restoring the symmetric observations of compact specifications) */
+	[[nodiscard]] auto getRefinedObservations(const Observation &obs) const
+		-> std::vector<std::pair<Observation, std::vector<Hint>>>;
+
+	/** Whether only one representative of symmetric observations is stored */
+	[[nodiscard]] auto isCompact() const -> bool { return compact_; }
 
 	/** Statistics */
 
@@ -122,9 +126,12 @@ public:
 	[[nodiscard]] auto refinementMissingEdges(const Observation &) const
 		-> std::vector<std::vector<Edge>>;
 
-	void add(ExecutionGraph &g, const ConsistencyChecker *consChecker, bool symmReduction);
-	void merge(Specification &&other);
-	void calculateHints();
+	/** Calculates the hints of all observations, using NUMTHREADS threads */
+	void calculateHints(unsigned numThreads = 1);
+
+	/** Adds all observations (but not their hints) to SPEC, restoring the
+	 * symmetric observations of compact specifications */
+	void expandTo(Specification &spec) const;
 
 private:
 	using storage_t = std::unordered_multimap<Observation, Record>;
@@ -135,22 +142,89 @@ private:
 
 	[[nodiscard]] auto getMaxExtSize() const -> unsigned { return maxExtSize_; }
 
-	[[nodiscard]]
-	auto calculateObservationHints(const Observation &obs) const -> std::vector<Hint>;
+	/** Statistics of the hint calculation for an observation */
+	struct HintStats {
+		size_t extensionsExplored = 0;
+		std::chrono::nanoseconds time{};
+	};
+
+	[[nodiscard]] auto calculateObservationHints(const Observation &obs,
+						     HintStats &stats) const -> std::vector<Hint>;
 
 	friend void serialize(llvm::raw_ostream &os, const Specification &spec);
 	friend auto deserialize(std::istream &is) -> Specification;
+	friend class MappedSpecification;
+	friend class ObservationStore;
 
 	// split into two maps <obs, lins> + <obs, hints> ?
 	storage_t data_;
 	unsigned maxExtSize_ = UINT_MAX;
 
+	/** Whether symmetric observations are implicit (see ObservationStore) */
+	bool compact_ = false;
+
 #ifdef ENABLE_GENMC_DEBUG
 	mutable unsigned int extensionsExploredInTotal = 0U;
 	bool debug = false;
 #endif
 };
 
+/**
+ * A concurrent store for the observations collected while exploring the
+ * specification program. Drivers add their observations directly, and the
+ * store is turned into a Specification once the exploration is over.
+ *
+ * Observations are partitioned into shards by hash, each guarded by its own
+ * lock. Under symmetry reduction, only the canonical form of each set of
+ * symmetric observations is stored (see CanonicalLabeller), and the
+ * specification built from the store is compact: the rest are generated
+ * on the fly when the specification is checked (or by expandTo()).
+ */
+class ObservationStore {
+
+public:
+	explicit ObservationStore(bool symmReduction) : symmReduction(symmReduction) {}
+
+	/** Adds the observation of G (along with its linearization) */
+	void add(ExecutionGraph &g, const ConsistencyChecker *consChecker);
+
+	/** Moves all observations of OTHER into this store */
+	void merge(ObservationStore &&other);
+
+	/** Moves all observations into SPEC, which is compact under symmetry reduction */
+	void moveTo(Specification &spec);
+
+private:
+	/** Observations are keyed by their outcome and their hb */
+	struct ObservationHasher {
+		auto operator()(const Observation &obs) const -> size_t;
+	};
+	struct ObservationEq {
+		auto operator()(const Observation &a, const Observation &b) const -> bool
+		{
+			return a == b && a.hasSameHb(b);
+		}
+	};
+
+	struct Shard {
+		std::mutex mutex;
+		std::unordered_map<Observation, VSet<Linearization>, ObservationHasher,
+				   ObservationEq>
+			data;
+	};
+
+	static constexpr unsigned numShards = 64;
+
+	/** Adds OBS (or its canonical representative) with linearization LIN */
+	void add(Observation &&obs, const Linearization &lin);
+
+	/** Adds LINS to the linearizations of OBS */
+	void insert(Observation &&obs, VSet<Linearization> &&lins);
+
+	bool symmReduction;
+	std::array<Shard, numShards> shards;
+};
+
 void serialize(llvm::raw_ostream &os, const Specification &spec);
 auto deserialize(std::istream &is) -> Specification;
 
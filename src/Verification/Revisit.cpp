@@ -19,6 +19,7 @@
  */
 
 #include "Revisit.hpp"
+#include "Support/BinaryIO.hpp"
 
 llvm::raw_ostream &operator<<(llvm::raw_ostream &s, const Revisit::Kind k)
 {
@@ -78,3 +79,70 @@ llvm::raw_ostream &operator<<(llvm::raw_ostream &s, const Revisit &item)
 	}
 	return s;
 }
+
+void serialize(BinaryWriter &w, const Revisit &item)
+{
+	w.write(item.getKind());
+	w.write(item.getPos());
+	switch (item.getKind()) {
+	case Revisit::RV_FRevRead: {
+		auto &fi = static_cast<const ReadForwardRevisit &>(item);
+		w.write(fi.getRev());
+		w.write(fi.isMaximal());
+		break;
+	}
+	case Revisit::RV_FRevMO:
+		w.write(static_cast<const WriteForwardRevisit &>(item).getPred());
+		break;
+	case Revisit::RV_FRevOpt:
+	case Revisit::RV_FRevRerun:
+		break;
+	case Revisit::RV_BRev:
+	case Revisit::RV_BRevHelper: {
+		auto &bi = static_cast<const BackwardRevisit &>(item);
+		w.write(bi.getRev());
+		serialize(w, *bi.getViewNoRel());
+		if (auto *hi = llvm::dyn_cast<BackwardRevisitHELPER>(&item))
+			w.write(hi->getMid());
+		break;
+	}
+	default:
+		BUG();
+	}
+}
+
+void deserialize(BinaryReader &r, std::unique_ptr<Revisit> &item)
+{
+	auto kind = r.read<Revisit::Kind>();
+	auto pos = r.read<Event>();
+	switch (kind) {
+	case Revisit::RV_FRevRead: {
+		auto rev = r.read<Event>();
+		item = std::make_unique<ReadForwardRevisit>(pos, rev, r.read<bool>());
+		return;
+	}
+	case Revisit::RV_FRevMO:
+		item = std::make_unique<WriteForwardRevisit>(pos, r.read<Event>());
+		return;
+	case Revisit::RV_FRevOpt:
+		item = std::make_unique<OptionalForwardRevisit>(pos);
+		return;
+	case Revisit::RV_FRevRerun:
+		item = std::make_unique<RerunForwardRevisit>();
+		return;
+	case Revisit::RV_BRev:
+	case Revisit::RV_BRevHelper: {
+		auto rev = r.read<Event>();
+		std::unique_ptr<VectorClock> view;
+		deserialize(r, view);
+		if (kind == Revisit::RV_BRev)
+			item = std::make_unique<BackwardRevisit>(pos, rev, std::move(view));
+		else
+			item = std::make_unique<BackwardRevisitHELPER>(pos, rev, std::move(view),
+								       r.read<Event>());
+		return;
+	}
+	default:
+		ERROR("Unknown revisit kind in binary input!\n");
+	}
+}
@@ -70,6 +70,13 @@ private:
 
 llvm::raw_ostream &operator<<(llvm::raw_ostream &rhs, const Revisit::Kind k);
 
+class BinaryWriter;
+class BinaryReader;
+
+/** Binary (de)serialization of revisit items */
+void serialize(BinaryWriter &w, const Revisit &item);
+void deserialize(BinaryReader &r, std::unique_ptr<Revisit> &item);
+
 /** Multiple hierarchy for read revisits */
 class ReadRevisit {
 
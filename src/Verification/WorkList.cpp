@@ -19,6 +19,7 @@
  */
 
 #include "WorkList.hpp"
+#include "Support/BinaryIO.hpp"
 
 auto operator<<(llvm::raw_ostream &s, const WorkList &wset) -> llvm::raw_ostream &
 {
@@ -28,3 +29,18 @@ auto operator<<(llvm::raw_ostream &s, const WorkList &wset) -> llvm::raw_ostream
 	s << "]";
 	return s;
 }
+
+void serialize(BinaryWriter &w, const WorkList &wlist)
+{
+	w.writeSize(wlist.wlist_.size());
+	for (const auto &item : wlist.wlist_)
+		serialize(w, *item);
+}
+
+void deserialize(BinaryReader &r, WorkList &wlist)
+{
+	wlist.wlist_.clear();
+	wlist.wlist_.resize(r.readSize(sizeof(Revisit::Kind) + sizeof(Event)));
+	for (auto &item : wlist.wlist_)
+		deserialize(r, item);
+}
@@ -54,6 +54,9 @@ public:
 
 	friend auto operator<<(llvm::raw_ostream &s, const WorkList &wlist) -> llvm::raw_ostream &;
 
+	friend void serialize(BinaryWriter &w, const WorkList &wlist);
+	friend void deserialize(BinaryReader &r, WorkList &wlist);
+
 private:
 	/* Each stamp was associated with a bucket of TODOs before.
 	 * This is now unnecessary, as even a simple stack suffices */
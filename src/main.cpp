@@ -18,19 +18,27 @@
  * Author: Michalis Kokologiannakis <michalis@mpi-sws.org>
  */
 
+#include "ADT/View.hpp"
 #include "Config/Config.hpp"
 #include "Static/LLVMModule.hpp"
+#include "Static/ModuleCache.hpp"
 #include "Support/Error.hpp"
+#include "Support/ProcessPool.hpp"
 #include "Verification/GenMCDriver.hpp"
+#include "Verification/Relinche/MappedSpecification.hpp"
 #include "config.h"
 
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/LineIterator.h>
+#include <llvm/Support/MemoryBuffer.h>
 
 #include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <string>
 #include <unistd.h>
+#include <vector>
 
 namespace fs = llvm::sys::fs;
 
@@ -59,44 +67,61 @@ static auto getOutFilename(const std::shared_ptr<const Config> & /*conf*/) -> st
 	return {filenameTemplate};
 }
 
-static auto buildCompilationArgs(const std::shared_ptr<const Config> &conf) -> std::string
+static auto buildCompilationArgs(const std::shared_ptr<const Config> &conf)
+	-> std::vector<std::string>
 {
-	std::string args;
-
-	args += " -fno-discard-value-names";
-	args += " -Xclang";
-	args += " -disable-O0-optnone";
-	args += " -g"; /* Compile with -g to get debugging mdata */
-	for (const auto &f : conf->cflags)
-		args += " " + f;
-	args += " -I" SRC_INCLUDE_DIR;
-	args += " -I" INCLUDE_DIR;
-	auto inodeFlag = " -D__CONFIG_GENMC_INODE_DATA_SIZE=" + std::to_string(conf->maxFileSize);
-	args += " " + inodeFlag;
-	args += " -S -emit-llvm";
-	args += " -o " + getOutFilename(conf);
-	args += " " + conf->inputFile;
+	std::vector<std::string> args;
+
+	args.emplace_back("-fno-discard-value-names");
+	args.emplace_back("-Xclang");
+	args.emplace_back("-disable-O0-optnone");
+	args.emplace_back("-g"); /* Compile with -g to get debugging mdata */
+	args.insert(args.end(), conf->cflags.begin(), conf->cflags.end());
+	args.emplace_back("-I" SRC_INCLUDE_DIR);
+	args.emplace_back("-I" INCLUDE_DIR);
+	args.emplace_back("-D__CONFIG_GENMC_INODE_DATA_SIZE=" + std::to_string(conf->maxFileSize));
+	args.emplace_back("-S");
+	args.emplace_back("-emit-llvm");
 
 	return args;
 }
 
+static auto buildCompilationCommand(const std::vector<std::string> &args) -> std::string
+{
+	std::string command = CLANGPATH;
+	for (const auto &arg : args)
+		command += " " + arg;
+	return command;
+}
+
 static auto compileInput(const std::shared_ptr<const Config> &conf,
 			 const std::unique_ptr<llvm::LLVMContext> &ctx,
-			 std::unique_ptr<llvm::Module> &module) -> bool
+			 std::unique_ptr<llvm::Module> &module, const ModuleCache *cache) -> bool
 {
-	const auto *path = CLANGPATH;
-	auto command = path + buildCompilationArgs(conf);
-	if (std::system(command.c_str()) != 0)
+	auto args = buildCompilationArgs(conf);
+	if (cache && !cache->getDepFile().empty())
+		args.insert(args.end(), {"-MD", "-MF", cache->getDepFile()});
+
+#ifdef HAVE_LIBCLANG_CPP
+	/* Skip the process and the textual IR altogether */
+	if (conf->compileInProcess) {
+		args.push_back(conf->inputFile);
+		module = LLVMModule::compileLLVMModule(args, ctx);
+		return module != nullptr;
+	}
+#endif
+
+	args.insert(args.end(), {"-o", getOutFilename(conf), conf->inputFile});
+	if (std::system(buildCompilationCommand(args).c_str()) != 0)
 		return false;
 
 	module = LLVMModule::parseLLVMModule(getOutFilename(conf), ctx);
 	return true;
 }
 
-static void transformInput(const std::shared_ptr<Config> &conf, llvm::Module &module,
-			   ModuleInfo &modInfo)
+static void finalizeInput(const std::shared_ptr<Config> &conf, llvm::Module &module,
+			  const ModuleInfo &modInfo)
 {
-	LLVMModule::transformLLVMModule(module, modInfo, conf);
 	if (!conf->transformFile.empty())
 		LLVMModule::printLLVMModule(module, conf->transformFile);
 
@@ -137,10 +162,13 @@ static void printVerificationResults(const std::shared_ptr<const Config> &conf,
 				     const GenMCDriver::Result &res)
 {
 	PRINT(VerbosityLevel::Error) << res.message;
-	PRINT(VerbosityLevel::Error)
-		<< (res.status == VerificationError::VE_OK
-			    ? "*** Verification complete.\nNo errors were detected.\n"
-			    : "*** Verification unsuccessful.\n");
+	if (res.interrupted)
+		PRINT(VerbosityLevel::Error) << "*** Verification interrupted.\n";
+	else
+		PRINT(VerbosityLevel::Error)
+			<< (res.status == VerificationError::VE_OK
+				    ? "*** Verification complete.\nNo errors were detected.\n"
+				    : "*** Verification unsuccessful.\n");
 
 	PRINT(VerbosityLevel::Error) << "Number of complete executions explored: " << res.explored;
 	GENMC_DEBUG(PRINT(VerbosityLevel::Error)
@@ -156,6 +184,10 @@ static void printVerificationResults(const std::shared_ptr<const Config> &conf,
 		PRINT(VerbosityLevel::Error)
 			<< "\nNumber of blocked executions seen: " << res.exploredBlocked;
 	}
+	if (conf->pruneDuplicates) {
+		PRINT(VerbosityLevel::Error)
+			<< "\nNumber of revisits pruned as duplicates: " << res.pruned;
+	}
 	GENMC_DEBUG(
 		if (conf->countMootExecs) {
 			PRINT(VerbosityLevel::Error) << " (+ " << res.exploredMoot << " mooted)";
@@ -179,11 +211,29 @@ static void printVerificationResults(const std::shared_ptr<const Config> &conf,
 	}
 }
 
+static auto createSpecification(const std::shared_ptr<const Config> &conf) -> Specification
+{
+	return Specification(conf->maxExtSize
+#ifdef ENABLE_GENMC_DEBUG
+			     ,
+			     conf->relincheDebug
+#endif
+	);
+}
+
 static void calculateHintsAndSaveSpec(const std::shared_ptr<const Config> &conf,
 				      const GenMCDriver::Result &res)
 {
-	auto spec = std::move(*res.specification);
-	spec.calculateHints();
+	auto spec = createSpecification(conf);
+	res.observations->moveTo(spec);
+
+	/* Symmetric observations are only restored on request (e.g., by tests) */
+	if (conf->expandLinSpec) {
+		auto expanded = createSpecification(conf);
+		spec.expandTo(expanded);
+		spec = std::move(expanded);
+	}
+	spec.calculateHints(conf->threads);
 
 	PRINT(VerbosityLevel::Error) << "\n*** Specification analysis complete.\n";
 	PRINT(VerbosityLevel::Error)
@@ -195,34 +245,102 @@ static void calculateHintsAndSaveSpec(const std::shared_ptr<const Config> &conf,
 	llvm::raw_fd_ostream specFile(*conf->collectLinSpec, err, fs::CD_CreateAlways, fs::FA_Write,
 				      fs::OF_None);
 	handleFSError(err, "during save specification file");
-	serialize(specFile, spec);
+	if (conf->binaryLinSpec)
+		MappedSpecification::write(specFile, spec);
+	else
+		serialize(specFile, spec);
 }
 
-auto main(int argc, char **argv) -> int
+#ifdef ENABLE_GENMC_DEBUG
+static auto openViewTrace(const std::shared_ptr<const Config> &conf)
+	-> std::unique_ptr<llvm::raw_fd_ostream>
 {
-	auto begin = std::chrono::high_resolution_clock::now();
-	auto conf = std::make_shared<Config>();
+	if (!conf->viewTraceFile)
+		return nullptr;
 
-	parseConfig(argc, argv, *conf);
+	std::error_code err;
+	auto trace = std::make_unique<llvm::raw_fd_ostream>(
+		*conf->viewTraceFile, err, fs::CD_CreateAlways, fs::FA_Write, fs::OF_None);
+	handleFSError(err, "during opening view-update trace");
+	return trace;
+}
+#endif
+
+static void convertSpec(const std::shared_ptr<const Config> &conf)
+{
+	auto isBinary = MappedSpecification::isBinary(conf->inputFile);
+	auto spec = MappedSpecification::open(conf->inputFile);
+
+	std::error_code err;
+	llvm::raw_fd_ostream specFile(*conf->convertLinSpec, err, fs::CD_CreateAlways,
+				      fs::FA_Write, fs::OF_None);
+	handleFSError(err, "during save specification file");
+	if (isBinary)
+		serialize(specFile, spec->toSpecification());
+	else
+		MappedSpecification::write(specFile, spec->toSpecification());
 
 	PRINT(VerbosityLevel::Error)
-		<< PACKAGE_NAME " v" PACKAGE_VERSION << " (LLVM " LLVM_VERSION ")\n"
-		<< "Copyright (C) 2024 MPI-SWS. All rights reserved.\n\n";
+		<< "*** Specification conversion complete.\n"
+		<< "Number of observations: " << spec->getNumObservations() << "\n";
+}
 
+static auto readBatch(const std::string &file) -> std::vector<std::string>
+{
+	auto bufOrErr = llvm::MemoryBuffer::getFile(file);
+	if (!bufOrErr)
+		handleFSError(bufOrErr.getError(), "Could not read batch " + file + "\n");
+
+	std::vector<std::string> inputs;
+	for (llvm::line_iterator it(**bufOrErr); !it.is_at_eof(); ++it) {
+		auto input = it->trim();
+		ERROR_ON(!fs::is_regular_file(input),
+			 "Batch input " + input.str() + " is not a regular file!\n");
+		inputs.push_back(input.str());
+	}
+	return inputs;
+}
+
+static auto verifyInput(const std::shared_ptr<Config> &conf,
+			const std::chrono::high_resolution_clock::time_point &begin) -> int
+{
 	auto ctx = std::make_unique<llvm::LLVMContext>(); // *dtor after module's*
 	std::unique_ptr<llvm::Module> module;
-	if (conf->inputFromBitcodeFile) {
-		module = LLVMModule::parseLLVMModule(conf->inputFile, ctx);
-	} else if (!compileInput(conf, ctx, module)) {
-		return ECOMPILE;
+	std::unique_ptr<ModuleInfo> modInfo;
+
+	/* Compile and transform the input, unless a previous run already did so */
+	auto cache = conf->moduleCacheDir.has_value()
+			     ? std::make_unique<ModuleCache>(
+				     conf, buildCompilationCommand(buildCompilationArgs(conf)))
+			     : nullptr;
+	if (cache && cache->lookup(ctx, module, modInfo)) {
+		LOG(VerbosityLevel::Tip) << "Reusing the compiled and transformed input from "
+					 << *conf->moduleCacheDir << ".\n";
+		PRINT(VerbosityLevel::Error) << "*** Compilation complete.\n";
+	} else {
+		if (conf->inputFromBitcodeFile) {
+			module = LLVMModule::parseLLVMModule(conf->inputFile, ctx);
+		} else if (!compileInput(conf, ctx, module, cache.get())) {
+			return ECOMPILE;
+		}
+		PRINT(VerbosityLevel::Error) << "*** Compilation complete.\n";
+
+		/* Perform the necessary transformations */
+		modInfo = std::make_unique<ModuleInfo>(*module);
+		LLVMModule::transformLLVMModule(*module, *modInfo, conf);
+		if (cache)
+			cache->store(*module, *modInfo);
 	}
-	PRINT(VerbosityLevel::Error) << "*** Compilation complete.\n";
-
-	/* Perform the necessary transformations */
-	auto modInfo = std::make_unique<ModuleInfo>(*module);
-	transformInput(conf, *module, *modInfo);
+	finalizeInput(conf, *module, *modInfo);
 	PRINT(VerbosityLevel::Error) << "*** Transformation complete.\n";
 
+	/* In worker mode, the coordinator takes care of everything else */
+	if (conf->connectAddr) {
+		RemoteWorker::serve(conf, std::move(module), std::move(modInfo),
+				    RemoteWorker::connect(*conf->connectAddr));
+		return 0;
+	}
+
 	/* Estimate the state space */
 	if (conf->estimate) {
 		LOG(VerbosityLevel::Tip) << "Estimating state-space size. For better performance, "
@@ -233,8 +351,13 @@ auto main(int argc, char **argv) -> int
 			return EVERIFY;
 	}
 
-	/* Go ahead and try to verify */
+	/* Go ahead and try to verify (recording view updates, if asked to) */
+#ifdef ENABLE_GENMC_DEBUG
+	auto viewTrace = openViewTrace(conf);
+	View::recordUpdates(viewTrace.get());
+#endif
 	auto res = GenMCDriver::verify(conf, std::move(module), std::move(modInfo));
+	GENMC_DEBUG(View::recordUpdates(nullptr););
 	printVerificationResults(conf, res);
 
 	/* Serialize spec if in analysis mode */
@@ -248,3 +371,40 @@ auto main(int argc, char **argv) -> int
 	/* TODO: Check globalContext.destroy() and llvm::shutdown() */
 	return res.status == VerificationError::VE_OK ? 0 : EVERIFY;
 }
+
+auto main(int argc, char **argv) -> int
+{
+	auto begin = std::chrono::high_resolution_clock::now();
+	auto conf = std::make_shared<Config>();
+
+	parseConfig(argc, argv, *conf);
+
+	PRINT(VerbosityLevel::Error)
+		<< PACKAGE_NAME " v" PACKAGE_VERSION << " (LLVM " LLVM_VERSION ")\n"
+		<< "Copyright (C) 2024 MPI-SWS. All rights reserved.\n\n";
+
+	/* The input is a specification to be converted */
+	if (conf->convertLinSpec) {
+		convertSpec(conf);
+		return 0;
+	}
+
+	if (!conf->batch)
+		return verifyInput(conf, begin);
+
+	/* Verify all inputs in this process (with -compile-in-process, no process is
+	 * spawned at all). Each input gets its own configuration, as finalizeInput()
+	 * may adjust it */
+	auto status = 0;
+	for (const auto &input : readBatch(conf->inputFile)) {
+		auto inputConf = std::make_shared<Config>(*conf);
+		inputConf->inputFile = input;
+		PRINT(VerbosityLevel::Error) << "*** Input: " << input << "\n";
+		auto inputStatus =
+			verifyInput(inputConf, std::chrono::high_resolution_clock::now());
+		PRINT(VerbosityLevel::Error) << "\n";
+		if (status == 0)
+			status = inputStatus;
+	}
+	return status;
+}
@@ -0,0 +1,199 @@
+/*
+ * GenMC -- Generic Model Checking.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you can access it online at
+ * http://www.gnu.org/licenses/gpl-3.0.html.
+ */
+
+/*
+ * Replays the view updates recorded with -record-view-updates (debug
+ * builds only), once through View::update() and once through each of a
+ * few hand-written element-wise max kernels, and prints the time per
+ * update of each.
+ * All kernels have to agree with View::update().
+ *
+ *   view-bench <trace> [<repetitions>]
+ */
+
+#include "ADT/View.hpp"
+#include "Support/BinaryIO.hpp"
+#include "Support/Error.hpp"
+
+#include <llvm/Support/Format.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
+/* Computes a[i] = max(a[i], b[i]) for i < n */
+using Kernel = void (*)(int *a, const int *b, unsigned n);
+
+#ifdef __clang__
+#define NO_VECTORIZE
+#else
+#define NO_VECTORIZE __attribute__((optimize("no-tree-vectorize")))
+#endif
+
+NO_VECTORIZE static void maxScalar(int *a, const int *b, unsigned n)
+{
+#ifdef __clang__
+#pragma clang loop vectorize(disable) interleave(disable)
+#endif
+	for (auto i = 0U; i < n; i++)
+		a[i] = std::max(a[i], b[i]);
+}
+
+#ifdef __x86_64__
+/* SSE2 (the x86-64 baseline) has no 32-bit max, so select with a comparison */
+static void maxSSE2(int *a, const int *b, unsigned n)
+{
+	auto i = 0U;
+	for (; i + 4 <= n; i += 4) {
+		auto x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+		auto y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+		auto gt = _mm_cmpgt_epi32(y, x);
+		auto m = _mm_or_si128(_mm_and_si128(gt, y), _mm_andnot_si128(gt, x));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(a + i), m);
+	}
+	maxScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("sse4.1"))) static void maxSSE41(int *a, const int *b, unsigned n)
+{
+	auto i = 0U;
+	for (; i + 4 <= n; i += 4) {
+		auto x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+		auto y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(a + i), _mm_max_epi32(x, y));
+	}
+	maxScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) static void maxAVX2(int *a, const int *b, unsigned n)
+{
+	auto i = 0U;
+	for (; i + 8 <= n; i += 8) {
+		auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+		auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i *>(a + i), _mm256_max_epi32(x, y));
+	}
+	for (; i + 4 <= n; i += 4) {
+		auto x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+		auto y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(a + i), _mm_max_epi32(x, y));
+	}
+	maxScalar(a + i, b + i, n - i);
+}
+#endif
+
+/* Same as View::update(), but with the element-wise max done by K */
+static void updateWith(View &a, const View &b, Kernel k)
+{
+	const auto *bb = b.begin();
+	auto n = b.size();
+	while (n > a.size() && bb[n - 1] <= 0)
+		--n;
+	if (n > a.size())
+		a.setMax(Event(n - 1, 0));
+	k(a.begin(), bb, n);
+}
+
+struct Trace {
+	std::vector<View> lhs;
+	std::vector<View> rhs;
+};
+
+static auto readTrace(const std::string &file) -> Trace
+{
+	auto bufOrErr = llvm::MemoryBuffer::getFile(file);
+	if (!bufOrErr)
+		handleFSError(bufOrErr.getError(), "Could not read trace " + file + "\n");
+
+	const auto &buf = *bufOrErr;
+	BinaryReader r(buf->getBufferStart(), buf->getBufferEnd());
+	Trace trace;
+	while (!r.atEnd()) {
+		deserialize(r, trace.lhs.emplace_back());
+		deserialize(r, trace.rhs.emplace_back());
+	}
+	ERROR_ON(trace.lhs.empty(), "Trace " + file + " contains no updates!\n");
+	return trace;
+}
+
+/* Returns the best time per update (in ns) of UPDATE over the trace */
+template <typename F>
+static auto measure(const Trace &trace, const std::vector<View> &expected, unsigned reps,
+		    F &&update) -> double
+{
+	using Clock = std::chrono::steady_clock;
+
+	auto best = Clock::duration::max();
+	for (auto rep = 0U; rep < reps; rep++) {
+		auto views = trace.lhs;
+		auto start = Clock::now();
+		for (auto i = 0U; i < views.size(); i++)
+			update(views[i], trace.rhs[i]);
+		best = std::min(best, Clock::now() - start);
+
+		for (auto i = 0U; i < views.size(); i++)
+			ERROR_ON(!std::equal(views[i].begin(), views[i].end(), expected[i].begin(),
+					     expected[i].end()),
+				 "Kernel disagrees with View::update()!\n");
+	}
+	return std::chrono::duration<double, std::nano>(best).count() / trace.lhs.size();
+}
+
+auto main(int argc, char **argv) -> int
+{
+	ERROR_ON(argc < 2 || argc > 3, std::string("Usage: ") + argv[0] +
+					       " <trace> [<repetitions>]\n");
+	auto trace = readTrace(argv[1]);
+	auto reps = argc > 2 ? std::max(1, std::atoi(argv[2])) : 10;
+
+	auto expected = trace.lhs;
+	auto totalSize = 0UL;
+	for (auto i = 0U; i < expected.size(); i++) {
+		expected[i].update(trace.rhs[i]);
+		totalSize += expected[i].size();
+	}
+	llvm::outs() << "Updates: " << trace.lhs.size() << " (mean size: "
+		     << llvm::format("%.1f", double(totalSize) / expected.size()) << ")\n";
+
+	auto base = measure(trace, expected, reps, [](View &a, const View &b) { a.update(b); });
+	auto print = [&](const char *name, double ns) {
+		llvm::outs() << llvm::format("%-14s %8.2f ns/update %7.2fx\n", name, ns, base / ns);
+	};
+	print("View::update", base);
+
+	auto run = [&](const char *name, Kernel k) {
+		print(name, measure(trace, expected, reps,
+				    [k](View &a, const View &b) { updateWith(a, b, k); }));
+	};
+	run("scalar", maxScalar);
+#ifdef __x86_64__
+	run("sse2", maxSSE2);
+	if (__builtin_cpu_supports("sse4.1"))
+		run("sse4.1", maxSSE41);
+	if (__builtin_cpu_supports("avx2"))
+		run("avx2", maxAVX2);
+#endif
+	return 0;
+}
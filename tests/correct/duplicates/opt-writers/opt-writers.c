@@ -0,0 +1,37 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <genmc.h>
+
+#ifndef N
+# define N 4
+#endif
+
+/*
+ * Each thread writes x and then reads it back within an optional block.
+ * Under arbitrary scheduling the blocks are expanded in varying orders,
+ * so the same prefix can be revisited more than once.
+ */
+
+atomic_int x;
+
+void *thread_n(void *arg)
+{
+	intptr_t index = ((intptr_t) arg);
+
+	atomic_store_explicit(&x, index, memory_order_relaxed);
+	__VERIFIER_optional(atomic_load_explicit(&x, memory_order_relaxed););
+	return NULL;
+}
+
+int main()
+{
+	pthread_t t[N];
+
+	for (intptr_t i = 0; i < N; i++)
+		if (pthread_create(&t[i], NULL, thread_n, (void *) (i + 1)))
+			abort();
+
+	return 0;
+}